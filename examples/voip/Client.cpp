@@ -30,6 +30,10 @@ public:
     m_host(host),
     m_port(port)
     {
+        // Send small chunks, to keep the latency low; 20 ms is the usual
+        // packet duration of voice over IP, and sf::sleep is precise enough
+        // for it, whereas precise processing would spin at every deadline
+        setProcessingInterval(sf::milliseconds(20));
     }
 
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_CAPTURESTATISTICS_HPP
+#define SFML_CAPTURESTATISTICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/Export.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Timing statistics gathered by a sound recorder
+///
+////////////////////////////////////////////////////////////
+struct SFML_AUDIO_API CaptureStatistics
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Sets all the statistics to zero.
+    ///
+    ////////////////////////////////////////////////////////////
+    CaptureStatistics();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64 chunkCount; ///< Number of chunks processed since the statistics were reset
+    Uint64 overruns;   ///< Number of chunks preceded by a loss of samples since the statistics were reset
+    Time   meanDelay;  ///< Mean wake-up delay of the recent chunks
+    Time   p99Delay;   ///< 99th percentile of the wake-up delay of the recent chunks
+    Time   maxDelay;   ///< Highest wake-up delay of the recent chunks
+};
+
+} // namespace sf
+
+
+#endif // SFML_CAPTURESTATISTICS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::CaptureStatistics
+/// \ingroup audio
+///
+/// sf::CaptureStatistics describes how regularly a
+/// sf::SoundRecorder hands the captured audio over to
+/// onProcessSamples. The delay of a chunk is the time between
+/// the deadline at which the recording thread was scheduled to
+/// read it and the moment it actually did: it measures how late
+/// the thread wakes up, which is what precise processing
+/// improves. The total latency of a sample is at most the
+/// processing interval plus this delay.
+///
+/// The delays (mean, 99th percentile and maximum) are computed
+/// over the most recent chunks, so that they reflect the
+/// current behavior of the capture. The counters accumulate
+/// until sf::SoundRecorder::resetCaptureStatistics is called.
+///
+/// An overrun is counted when more audio was captured since the
+/// previous read than the capture buffer of the device can hold
+/// (one second), in which case samples were lost.
+///
+/// Usage example:
+/// \code
+/// sf::CaptureStatistics stats = recorder.getCaptureStatistics();
+/// std::cout << "mean: " << stats.meanDelay.asMicroseconds() << " us, "
+///           << "p99: " << stats.p99Delay.asMicroseconds() << " us, "
+///           << "overruns: " << stats.overruns << std::endl;
+/// \endcode
+///
+/// \see sf::SoundRecorder::getCaptureStatistics
+///
+////////////////////////////////////////////////////////////
@@ -63,8 +63,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open a sound file from the disk for reading
     ///
-    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC.
-    /// The supported sample sizes for FLAC and WAV are 8, 16, 24 and 32 bit.
+    /// The supported audio formats are: WAV (PCM and 32-bit float), OGG/Vorbis, FLAC.
+    /// The supported sample sizes for FLAC and PCM WAV are 8, 16, 24 and 32 bit.
     ///
     /// \param filename Path of the sound file to load
     ///
@@ -76,8 +76,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open a sound file in memory for reading
     ///
-    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC.
-    /// The supported sample sizes for FLAC and WAV are 8, 16, 24 and 32 bit.
+    /// The supported audio formats are: WAV (PCM and 32-bit float), OGG/Vorbis, FLAC.
+    /// The supported sample sizes for FLAC and PCM WAV are 8, 16, 24 and 32 bit.
     ///
     /// \param data        Pointer to the file data in memory
     /// \param sizeInBytes Size of the data to load, in bytes
@@ -90,8 +90,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Open a sound file from a custom stream for reading
     ///
-    /// The supported audio formats are: WAV (PCM only), OGG/Vorbis, FLAC.
-    /// The supported sample sizes for FLAC and WAV are 8, 16, 24 and 32 bit.
+    /// The supported audio formats are: WAV (PCM and 32-bit float), OGG/Vorbis, FLAC.
+    /// The supported sample sizes for FLAC and PCM WAV are 8, 16, 24 and 32 bit.
     ///
     /// \param stream Source stream to read from
     ///
@@ -165,6 +165,14 @@ public:
     /// If the given offset exceeds to total number of samples,
     /// this function jumps to the end of the sound file.
     ///
+    /// In compressed files (OGG, FLAC), the reader keeps an index
+    /// of the positions of the encoded blocks, filled as the file
+    /// is decoded (and from the seek table of FLAC files). Seeking
+    /// to a part of the file that was already decoded jumps to the
+    /// closest indexed block with a single read of the stream, and
+    /// decodes forward from there; seeking beyond the indexed part
+    /// searches for the position in the stream instead.
+    ///
     /// \param sampleOffset Index of the sample to jump to, relative to the beginning
     ///
     ////////////////////////////////////////////////////////////
@@ -195,6 +203,21 @@ public:
     ////////////////////////////////////////////////////////////
     Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// The samples are normalized to the [-1, 1] range. Compressed
+    /// formats (OGG/Vorbis) and sample sizes greater than 16 bits
+    /// are decoded without being quantized to 16 bits first.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 read(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -258,6 +281,14 @@ private:
 /// while (count > 0);
 /// \endcode
 ///
+/// Samples can also be read as floating point numbers, which
+/// preserves the precision of compressed and high resolution
+/// files, and suits audio processing better:
+/// \code
+/// float samples[1024];
+/// sf::Uint64 count = file.read(samples, 1024);
+/// \endcode
+///
 /// \see sf::SoundFileReader, sf::OutputSoundFile
 ///
 ////////////////////////////////////////////////////////////
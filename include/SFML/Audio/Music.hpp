@@ -276,10 +276,12 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputSoundFile     m_file;     ///< The streamed music file
-    std::vector<Int16> m_samples;  ///< Temporary buffer of samples
-    Mutex              m_mutex;    ///< Mutex protecting the data
-    Span<Uint64>       m_loopSpan; ///< Loop Range Specifier
+    InputSoundFile     m_file;             ///< The streamed music file
+    std::vector<Int16> m_samples;          ///< Temporary buffer of samples
+    std::vector<float> m_floatSamples;     ///< Temporary buffer of floating point samples
+    bool               m_useFloatSamples;  ///< Whether the samples are streamed as floating point numbers
+    Mutex              m_mutex;            ///< Mutex protecting the data
+    Span<Uint64>       m_loopSpan;         ///< Loop Range Specifier
 };
 
 } // namespace sf
@@ -306,7 +308,7 @@ private:
 /// it, request its parameters (channels, sample rate), change
 /// the way it is played (pitch, volume, 3D position, ...), etc.
 ///
-/// As a sound stream, a music is played in its own thread in order
+/// As a sound stream, a music is played by background threads in order
 /// not to block the rest of the program. This means that you can
 /// leave the music alone after calling play(), it will manage itself
 /// very well.
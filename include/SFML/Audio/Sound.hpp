@@ -36,6 +36,11 @@
 
 namespace sf
 {
+namespace priv
+{
+    class VoiceManager;
+}
+
 class SoundBuffer;
 
 ////////////////////////////////////////////////////////////
@@ -191,6 +196,63 @@ public:
     ////////////////////////////////////////////////////////////
     Status getStatus() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the priority of the sound
+    ///
+    /// When more sounds are playing than there are voices, the
+    /// sounds with the highest priority get a voice first. Among
+    /// sounds of equal priority, the most audible ones (the
+    /// loudest and closest to the listener) get a voice first.
+    /// The default priority is 0.
+    ///
+    /// \param priority New priority of the sound
+    ///
+    /// \see getPriority, setVoiceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPriority(float priority);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the priority of the sound
+    ///
+    /// \return Priority of the sound
+    ///
+    /// \see setPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    float getPriority() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of sounds that can be heard at once
+    ///
+    /// Each sound that is heard uses a voice, i.e. an OpenAL
+    /// source, and OpenAL implementations only provide a limited
+    /// number of sources. The other sounds are played virtually:
+    /// their playing position keeps advancing, but they are not
+    /// heard until they are among the most audible ones again.
+    /// Sound streams (sf::Music, ...) have their own sources and
+    /// don't count in this limit.
+    ///
+    /// The default voice count is 128. The actual count can be
+    /// lower if the OpenAL implementation runs out of sources.
+    ///
+    /// \param count Maximum number of voices
+    ///
+    /// \see getVoiceCount, setPriority
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setVoiceCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of sounds that can be heard at once
+    ///
+    /// \return Maximum number of voices
+    ///
+    /// \see setVoiceCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getVoiceCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -214,10 +276,35 @@ public:
 
 private:
 
+    friend class priv::VoiceManager;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start playing the sound on a voice
+    ///
+    /// The voice starts at the current playing position.
+    ///
+    /// \param voice OpenAL source to use
+    ///
+    ////////////////////////////////////////////////////////////
+    void attachVoice(unsigned int voice);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Continue playing the sound virtually
+    ///
+    /// \return OpenAL source that was used by the sound
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int detachVoice();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const SoundBuffer* m_buffer; ///< Sound buffer bound to the source
+    const SoundBuffer* m_buffer;    ///< Sound buffer bound to the source
+    bool               m_loop;      ///< Loop flag (true to loop, false to play once)
+    Status             m_status;    ///< Status requested by the user
+    Time               m_offset;    ///< Playing position at m_startTime, for virtual playback
+    Time               m_startTime; ///< Time at which the sound was played, paused or virtualized (see Clock::now)
+    float              m_priority;  ///< Priority of the sound when assigning voices
 };
 
 } // namespace sf
@@ -249,6 +336,16 @@ private:
 /// as long as the sound uses it. Note that multiple sounds
 /// can use the same sound buffer at the same time.
 ///
+/// OpenAL implementations can only play a limited number
+/// of sounds at once. SFML shares its voices (OpenAL sources)
+/// between the sounds that are playing: when there are more
+/// sounds than voices, only the most audible ones, according
+/// to their priority, volume and distance from the listener,
+/// are actually heard. The others are played virtually, their
+/// playing position keeps advancing and they can be heard again
+/// as soon as they become audible enough. It is therefore safe
+/// to play thousands of sounds, see setVoiceCount and setPriority.
+///
 /// Usage example:
 /// \code
 /// sf::SoundBuffer buffer;
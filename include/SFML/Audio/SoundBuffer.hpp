@@ -39,9 +39,13 @@
 namespace sf
 {
 class Sound;
-class InputSoundFile;
 class InputStream;
 
+namespace priv
+{
+    struct SoundBufferTask;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Storage for audio samples defining a sound
 ///
@@ -134,6 +138,85 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the sound buffer from a file in the background
+    ///
+    /// The file is opened by this function, but it is decoded
+    /// by a loading thread. The buffer keeps its previous
+    /// contents until finishLoading is called.
+    ///
+    /// \param filename Path of the sound file to load
+    ///
+    /// \return True if the file was opened, false if it couldn't be
+    ///
+    /// \see isLoading, finishLoading, loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFileAsync(const std::string& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the sound buffer from a file in memory in the background
+    ///
+    /// The file is decoded by a loading thread, \a data must
+    /// therefore remain valid until finishLoading is called.
+    /// The buffer keeps its previous contents until then.
+    ///
+    /// \param data        Pointer to the file data in memory
+    /// \param sizeInBytes Size of the data to load, in bytes
+    ///
+    /// \return True if the loading was started, false if there is no data
+    ///
+    /// \see isLoading, finishLoading, loadFromMemory
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemoryAsync(const void* data, std::size_t sizeInBytes);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start loading the sound buffer from a custom stream in the background
+    ///
+    /// The stream is read by a loading thread, it must therefore
+    /// remain valid, and not be used by other threads, until
+    /// finishLoading is called. The buffer keeps its previous
+    /// contents until then.
+    ///
+    /// \param stream Source stream to read from
+    ///
+    /// \return True if the loading was started, false if the stream is empty or unreadable
+    ///
+    /// \see isLoading, finishLoading, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStreamAsync(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether an asynchronous loading is in progress
+    ///
+    /// When this function returns false, finishLoading
+    /// doesn't block.
+    ///
+    /// \return True if the sound file is still being decoded
+    ///
+    /// \see finishLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isLoading() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Complete the pending asynchronous loading
+    ///
+    /// This function waits until the sound file is decoded
+    /// (or decodes it right away if no loading thread has
+    /// started decoding it yet), and then fills the buffer with
+    /// the new samples. The sounds using the buffer are updated.
+    ///
+    /// \return True if the loading succeeded, or if there was no
+    ///         pending loading; false if it failed
+    ///
+    /// \see isLoading
+    ///
+    ////////////////////////////////////////////////////////////
+    bool finishLoading();
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the sound buffer to an audio file
     ///
@@ -223,19 +306,89 @@ public:
     ////////////////////////////////////////////////////////////
     SoundBuffer& operator =(const SoundBuffer& right);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of threads decoding the sound buffers loaded asynchronously
+    ///
+    /// The default is 2 threads.
+    ///
+    /// \param count Number of loading threads (at least 1)
+    ///
+    /// \see getLoadingThreadCount, loadFromFileAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setLoadingThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads decoding the sound buffers loaded asynchronously
+    ///
+    /// \return Number of loading threads
+    ///
+    /// \see setLoadingThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getLoadingThreadCount();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum amount of memory used by the cache of decoded samples
+    ///
+    /// Sound files are identified by their contents, so loading
+    /// the same file (or identical files) into several buffers
+    /// decodes it only once while its samples are cached.
+    /// The least recently used samples are evicted first.
+    ///
+    /// The cache is disabled by default (its capacity is 0).
+    /// Enabling it has a cost: every loaded file is read twice,
+    /// once to compute its hash and once to decode it, and the
+    /// cached samples are kept in memory in addition to the
+    /// copies owned by the buffers. It is worth it only when the
+    /// same sounds are loaded repeatedly. Setting the capacity
+    /// back to 0 disables the cache and releases its memory.
+    ///
+    /// \param capacity Capacity of the cache, in bytes
+    ///
+    /// \see getCacheCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCacheCapacity(Uint64 capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum amount of memory used by the cache of decoded samples
+    ///
+    /// \return Capacity of the cache, in bytes
+    ///
+    /// \see setCacheCapacity
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getCacheCapacity();
+
 private:
 
     friend class Sound;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Initialize the internal state after loading a new sound
+    /// \brief Decode a sound file and fill the buffer with its samples
     ///
-    /// \param file Sound file providing access to the new loaded sound
+    /// \param stream Stream containing the sound file
     ///
     /// \return True on successful initialization, false on failure
     ///
     ////////////////////////////////////////////////////////////
-    bool initialize(InputSoundFile& file);
+    bool initialize(InputStream& stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a sound file to be decoded by the loading threads
+    ///
+    /// \param stream     Stream containing the sound file
+    /// \param ownsStream Whether the stream must be deleted with the loading
+    ///
+    ////////////////////////////////////////////////////////////
+    void startLoading(InputStream* stream, bool ownsStream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cancel the pending asynchronous loading, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void cancelLoading();
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the internal buffer with the cached audio samples
@@ -272,10 +425,11 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int       m_buffer;   ///< OpenAL buffer identifier
-    std::vector<Int16> m_samples;  ///< Samples buffer
-    Time               m_duration; ///< Sound duration
-    mutable SoundList  m_sounds;   ///< List of sounds that are using this buffer
+    unsigned int           m_buffer;   ///< OpenAL buffer identifier
+    std::vector<Int16>     m_samples;  ///< Samples buffer
+    Time                   m_duration; ///< Sound duration
+    mutable SoundList      m_sounds;   ///< List of sounds that are using this buffer
+    priv::SoundBufferTask* m_task;     ///< Pending asynchronous loading, if any
 };
 
 } // namespace sf
@@ -320,6 +474,38 @@ private:
 /// used by a sf::Sound (i.e. never write a function that
 /// uses a local sf::SoundBuffer instance for loading a sound).
 ///
+/// Decoding large or compressed sound files takes time. To
+/// keep the application responsive, sound buffers can be loaded
+/// asynchronously: the loadFrom*Async functions return right
+/// away, the sound files are decoded by a pool of loading
+/// threads, and the samples are transferred to the buffers when
+/// finishLoading is called. Besides, the decoded samples can
+/// be cached (see setCacheCapacity), so that loading the same
+/// sound again doesn't decode it twice.
+///
+/// Loading another file, or destroying the buffer, cancels a
+/// pending asynchronous loading. If a loading thread is already
+/// decoding the file, this waits until the thread notices the
+/// cancellation, which happens after a few thousand samples.
+/// \code
+/// sf::SoundBuffer buffer;
+/// if (!buffer.loadFromFileAsync("music.ogg"))
+/// {
+///     // error...
+/// }
+///
+/// // ... later, at every frame, check whether it is decoded
+/// if (!buffer.isLoading())
+/// {
+///     if (!buffer.finishLoading())
+///     {
+///         // error...
+///     }
+///
+///     // the buffer is ready to be played
+/// }
+/// \endcode
+///
 /// Usage example:
 /// \code
 /// // Declare a new sound buffer
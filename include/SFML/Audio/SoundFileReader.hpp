@@ -101,6 +101,23 @@ public:
     ///
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount) = 0;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// The samples are normalized to the [-1, 1] range.
+    /// The default implementation reads 16-bit samples and
+    /// converts them; readers decoding to floating point or to
+    /// more than 16 bits should override it, to avoid losing
+    /// precision.
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
 };
 
 } // namespace sf
@@ -121,6 +138,11 @@ public:
 /// as well as providing a static check function; the latter is used by
 /// SFML to find a suitable writer for a given input file.
 ///
+/// Readers that decode to floating point samples can also override
+/// the read function taking a float array, which is used by
+/// sf::InputSoundFile to read samples without quantizing them to
+/// 16 bits.
+///
 /// To register a new reader, use the sf::SoundFileFactory::registerReader
 /// template function.
 ///
@@ -30,6 +30,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Export.hpp>
 #include <SFML/Audio/AlResource.hpp>
+#include <SFML/Audio/CaptureStatistics.hpp>
+#include <SFML/System/Mutex.hpp>
 #include <SFML/System/Thread.hpp>
 #include <SFML/System/Time.hpp>
 #include <vector>
@@ -172,6 +174,27 @@ public:
     ////////////////////////////////////////////////////////////
     unsigned int getChannelCount() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics of the capture
+    ///
+    /// The statistics are kept when the capture is stopped
+    /// and restarted, until resetCaptureStatistics is called.
+    ///
+    /// \return Statistics of the recently processed chunks
+    ///
+    /// \see resetCaptureStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    CaptureStatistics getCaptureStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the statistics of the capture
+    ///
+    /// \see getCaptureStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetCaptureStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if the system supports audio capture
     ///
@@ -203,16 +226,44 @@ protected:
     /// want to use a small interval if you want to process the
     /// recorded data in real time, for example.
     ///
-    /// Note: this is only a hint, the actual period may vary.
-    /// So don't rely on this parameter to implement precise timing.
+    /// The interval is also the latency of the capture: a sample
+    /// waits at most one interval in the capture buffer before
+    /// it is passed to onProcessSamples. The calls are scheduled
+    /// at regular deadlines, so that the time spent processing
+    /// the samples doesn't delay the next calls, but by default
+    /// each wait relies on sf::sleep, whose precision depends on
+    /// the OS (see setPreciseProcessingEnabled for intervals of
+    /// a few milliseconds).
     ///
     /// The default processing interval is 100 ms.
     ///
     /// \param interval Processing interval
     ///
+    /// \see setPreciseProcessingEnabled
+    ///
     ////////////////////////////////////////////////////////////
     void setProcessingInterval(Time interval);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable precise (low-latency) processing
+    ///
+    /// When precise processing is enabled, the recording thread
+    /// sleeps until shortly before each deadline, then actively
+    /// waits (spins) until the exact deadline (see sf::spinUntil).
+    /// Combined with a short processing interval (5 ms for
+    /// example), this keeps the latency of the capture low and
+    /// regular, which matters for real time applications such as
+    /// voice chat, at the cost of some CPU time.
+    ///
+    /// Precise processing is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    /// \see setProcessingInterval, getCaptureStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPreciseProcessingEnabled(bool enabled);
+
     ////////////////////////////////////////////////////////////
     /// \brief Start capturing audio data
     ///
@@ -271,8 +322,19 @@ private:
     /// capture loop. It retrieves the captured samples and
     /// forwards them to the derived class.
     ///
+    /// \param delay Time elapsed since the deadline of the chunk
+    ///
     ////////////////////////////////////////////////////////////
-    void processCapturedSamples();
+    void processCapturedSamples(Time delay);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the statistics with a new chunk
+    ///
+    /// \param delay   Time elapsed since the deadline of the chunk
+    /// \param overrun True if samples were lost before the chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void recordChunk(Time delay, bool overrun);
 
     ////////////////////////////////////////////////////////////
     /// \brief Clean up the recorder's internal resources
@@ -285,13 +347,25 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread             m_thread;             ///< Thread running the background recording task
-    std::vector<Int16> m_samples;            ///< Buffer to store captured samples
-    unsigned int       m_sampleRate;         ///< Sample rate
-    Time               m_processingInterval; ///< Time period between calls to onProcessSamples
-    bool               m_isCapturing;        ///< Capturing state
-    std::string        m_deviceName;         ///< Name of the audio capture device
-    unsigned int       m_channelCount;       ///< Number of recording channels
+    enum
+    {
+        HistorySize = 512 ///< Number of recent chunks used to compute the statistics
+    };
+
+    Thread             m_thread;                 ///< Thread running the background recording task
+    std::vector<Int16> m_samples;                ///< Buffer to store captured samples, as large as the capture buffer of the device
+    unsigned int       m_sampleRate;             ///< Sample rate
+    Time               m_processingInterval;     ///< Time period between calls to onProcessSamples
+    bool               m_preciseProcessing;      ///< Spin before the processing deadlines?
+    bool               m_isCapturing;            ///< Capturing state
+    std::string        m_deviceName;             ///< Name of the audio capture device
+    unsigned int       m_channelCount;           ///< Number of recording channels
+    mutable Mutex      m_statisticsMutex;        ///< Mutex protecting the statistics
+    Time               m_lastRead;               ///< Time of the previous read of the capture buffer
+    std::size_t        m_pendingFrames;          ///< Number of frames left in the capture buffer by the previous read
+    Int64              m_delays[HistorySize];    ///< Wake-up delays of the recent chunks, in microseconds
+    Uint64             m_chunkCount;             ///< Number of chunks since the statistics were reset
+    Uint64             m_overruns;               ///< Number of overruns since the statistics were reset
 };
 
 } // namespace sf
@@ -324,7 +398,10 @@ private:
 /// calls, with the setProcessingInterval protected function. The default
 /// interval is chosen so that recording thread doesn't consume too much
 /// CPU, but it can be changed to a smaller value if you need to process
-/// the recorded data in real time, for example.
+/// the recorded data in real time, for example. For the lowest
+/// latency (voice chat, live effects, ...), use an interval of a
+/// few milliseconds together with setPreciseProcessingEnabled, and
+/// monitor the result with getCaptureStatistics.
 ///
 /// The audio capture feature may not be supported or activated
 /// on every platform, thus it is recommended to check its
@@ -300,13 +300,47 @@ protected:
     ///
     /// This constructor is meant to be called by derived classes only.
     ///
+    /// Derived classes that don't need an OpenAL source for
+    /// their whole lifetime can construct the sound source
+    /// without one. They are then responsible for assigning
+    /// an OpenAL source to m_source when they need it (and
+    /// calling applyAttributes), and for releasing it. Since
+    /// their source may then be changed by another thread, the
+    /// attribute setters of such sources are synchronized with
+    /// the voice manager; sources created with their own OpenAL
+    /// source don't pay for this lock.
+    ///
+    /// \param createSource True to create an OpenAL source, false to leave m_source to 0
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundSource(bool createSource = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Apply the attributes of the sound source to m_source
+    ///
+    /// This function is meant to be called by derived classes
+    /// after they assigned a new OpenAL source to m_source.
+    ///
+    ////////////////////////////////////////////////////////////
+    void applyAttributes();
+
     ////////////////////////////////////////////////////////////
-    SoundSource();
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_source; ///< OpenAL source identifier (0 if none)
+
+private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_source; ///< OpenAL source identifier
+    float    m_pitch;              ///< Pitch of the sound
+    float    m_volume;             ///< Volume of the sound, in the range [0, 100]
+    Vector3f m_position;           ///< 3D position of the sound in the audio scene
+    bool     m_relativeToListener; ///< Is the position relative to the listener?
+    float    m_minDistance;        ///< Distance under which the sound is heard at its maximum volume
+    float    m_attenuation;        ///< Attenuation factor of the sound
+    bool     m_managed;            ///< Is m_source assigned by the voice manager rather than owned?
 };
 
 } // namespace sf
@@ -34,10 +34,16 @@
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <cstdlib>
+#include <vector>
 
 
 namespace sf
 {
+namespace priv
+{
+    class SoundStreamScheduler;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Abstract base class for streamed audio sources
 ///
@@ -52,8 +58,9 @@ public:
     ////////////////////////////////////////////////////////////
     struct Chunk
     {
-        const Int16* samples;     ///< Pointer to the audio samples
-        std::size_t  sampleCount; ///< Number of samples pointed by Samples
+        const Int16* samples;      ///< Pointer to the audio samples
+        std::size_t  sampleCount;  ///< Number of samples pointed by Samples
+        const float* floatSamples; ///< Pointer to the audio samples as floating point numbers in [-1, 1], used instead of samples if not NULL
     };
 
     ////////////////////////////////////////////////////////////
@@ -68,8 +75,9 @@ public:
     /// This function starts the stream if it was stopped, resumes
     /// it if it was paused, and restarts it from the beginning if
     /// it was already playing.
-    /// This function uses its own thread so that it doesn't block
-    /// the rest of the program while the stream is played.
+    /// The stream is played by background threads shared by all
+    /// the streams, so that it doesn't block the rest of the
+    /// program.
     ///
     /// \see pause, stop
     ///
@@ -178,6 +186,98 @@ public:
     ////////////////////////////////////////////////////////////
     bool getLoop() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of audio buffers queued by the stream
+    ///
+    /// While the stream is playing, one buffer is played while
+    /// the others wait in the queue; whenever a buffer has been
+    /// played, it is refilled with new samples and queued again.
+    /// More buffers make the stream more robust to a slow source,
+    /// at the cost of more memory and of a longer delay before
+    /// the changes in the source (seeking aside) can be heard.
+    ///
+    /// The count is clamped to a minimum of 2. The new value
+    /// is used the next time the stream starts playing.
+    /// The default buffer count is 3.
+    ///
+    /// \param count Number of buffers
+    ///
+    /// \see getBufferCount, setBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of audio buffers queued by the stream
+    ///
+    /// \return Number of buffers
+    ///
+    /// \see setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the duration of audio held by each buffer
+    ///
+    /// Derived classes are free to provide chunks of any size
+    /// in onGetData, this duration is the size that they should
+    /// aim for; sf::Music for example decodes chunks of exactly
+    /// this duration. Together with the buffer count, it defines
+    /// how much audio is queued ahead of the playing position.
+    ///
+    /// The default buffer duration is 1 second.
+    ///
+    /// \param duration Duration of a buffer
+    ///
+    /// \see getBufferDuration, setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferDuration(Time duration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the duration of audio held by each buffer
+    ///
+    /// \return Duration of a buffer
+    ///
+    /// \see setBufferDuration
+    ///
+    ////////////////////////////////////////////////////////////
+    Time getBufferDuration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads that play the streams
+    ///
+    /// All the streams are played by a small pool of background
+    /// threads. Whenever a stream has played one of its buffers,
+    /// one of these threads refills it; when several streams
+    /// need new data at the same time, the ones that are closest
+    /// to running out of queued audio are refilled first.
+    /// More threads allow more streams to decode in parallel,
+    /// which helps when onGetData is expensive (compressed
+    /// audio) or may block.
+    ///
+    /// The count is clamped to a minimum of 1. This function
+    /// must not be called from onGetData, onSeek or onLoop.
+    /// The default thread count is 2.
+    ///
+    /// \param count Number of streaming threads
+    ///
+    /// \see getStreamingThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setStreamingThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads that play the streams
+    ///
+    /// \return Number of streaming threads
+    ///
+    /// \see setStreamingThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getStreamingThreadCount();
+
 protected:
 
     enum
@@ -213,13 +313,18 @@ protected:
     /// \brief Request a new chunk of audio samples from the stream source
     ///
     /// This function must be overridden by derived classes to provide
-    /// the audio samples to play. It is called continuously by the
-    /// streaming loop, in a separate thread.
+    /// the audio samples to play. It is called by the streaming
+    /// loop, in a separate thread, whenever a buffer needs to be
+    /// refilled. As the streaming threads are shared by all the
+    /// streams, this function should return quickly.
     /// The source can choose to stop the streaming loop at any time, by
     /// returning false to the caller.
     /// If you return true (i.e. continue streaming) it is important that
     /// the returned array of samples is not empty; this would stop the stream
     /// due to an internal limitation.
+    /// The samples can be provided either as 16-bit integers (samples)
+    /// or as floating point numbers (floatSamples), but a stream must
+    /// provide the same type of samples in all its chunks.
     ///
     /// \param data Chunk of data to fill
     ///
@@ -253,14 +358,25 @@ protected:
 
 private:
 
+    friend class priv::SoundStreamScheduler;
+
     ////////////////////////////////////////////////////////////
-    /// \brief Function called as the entry point of the thread
+    /// \brief Function called by the streaming threads to update the stream
     ///
-    /// This function starts the streaming loop, and returns
-    /// only when the sound is stopped.
+    /// This function starts the stream on its first call, then
+    /// refills the buffers that have been played. It computes
+    /// when the next buffer will have been played, so that the
+    /// streaming threads can sleep until then, and how much
+    /// audio is left in the queue, so that they can refill the
+    /// streams closest to running out of audio first.
+    ///
+    /// \param delay     Time to wait before the next update
+    /// \param remaining Duration of the audio left in the queue
+    ///
+    /// \return True if the stream is still playing, false if it has ended
     ///
     ////////////////////////////////////////////////////////////
-    void streamData();
+    bool streamData(Time& delay, Time& remaining);
 
     ////////////////////////////////////////////////////////////
     /// \brief Fill a new buffer with audio samples, and append
@@ -270,7 +386,7 @@ private:
     /// consumed; it fills it again and inserts it back into the
     /// playing queue.
     ///
-    /// \param bufferNum Number of the buffer to fill (in [0, BufferCount])
+    /// \param bufferNum Number of the buffer to fill (in [0, buffer count))
     /// \param immediateLoop Treat empty buffers as spent, and act on loops immediately
     ///
     /// \return True if the stream source has requested to stop, false otherwise
@@ -297,26 +413,39 @@ private:
     ////////////////////////////////////////////////////////////
     void clearQueue();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop the playback and delete the audio buffers
+    ///
+    /// This function is called when the streaming ends.
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseBuffers();
+
     enum
     {
-        BufferCount = 3,    ///< Number of audio buffers used by the streaming loop
         BufferRetries = 2   ///< Number of retries (excluding initial try) for onGetData()
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Thread        m_thread;                   ///< Thread running the background tasks
-    mutable Mutex m_threadMutex;              ///< Thread mutex
-    Status        m_threadStartState;         ///< State the thread starts in (Playing, Paused, Stopped)
-    bool          m_isStreaming;              ///< Streaming state (true = playing, false = stopped)
-    unsigned int  m_buffers[BufferCount];     ///< Sound buffers used to store temporary audio data
-    unsigned int  m_channelCount;             ///< Number of channels (1 = mono, 2 = stereo, ...)
-    unsigned int  m_sampleRate;               ///< Frequency (samples / second)
-    Uint32        m_format;                   ///< Format of the internal sound buffers
-    bool          m_loop;                     ///< Loop flag (true to loop, false to play once)
-    Uint64        m_samplesProcessed;         ///< Number of buffers processed since beginning of the stream
-    Int64         m_bufferSeeks[BufferCount]; ///< If buffer is an "end buffer", holds next seek position, else NoLoop. For play offset calculation.
+    mutable Mutex             m_threadMutex;      ///< Mutex protecting the streaming state
+    Mutex                     m_updateMutex;      ///< Mutex held while a streaming thread updates the stream
+    Status                    m_threadStartState; ///< State the stream starts in (Playing, Paused, Stopped)
+    bool                      m_isStreaming;      ///< Streaming state (true = playing, false = stopped)
+    bool                      m_requestStop;      ///< Whether the stream source has requested to stop
+    std::vector<unsigned int> m_buffers;          ///< Sound buffers used to store temporary audio data (empty when not streaming)
+    unsigned int              m_bufferCount;      ///< Number of buffers to use when the stream starts
+    Time                      m_bufferDuration;   ///< Duration of audio the derived class should provide per buffer
+    unsigned int              m_queueHead;        ///< Index of the buffer that is played first in the queue
+    unsigned int              m_channelCount;     ///< Number of channels (1 = mono, 2 = stereo, ...)
+    unsigned int              m_sampleRate;       ///< Frequency (samples / second)
+    Uint32                    m_format;           ///< Format of the internal sound buffers
+    Uint32                    m_floatFormat;      ///< Format of the internal sound buffers for floating point samples (0 if not supported)
+    std::vector<Int16>        m_convertedSamples; ///< Floating point samples converted to 16 bits, when floating point formats are not supported
+    bool                      m_loop;             ///< Loop flag (true to loop, false to play once)
+    Uint64                    m_samplesProcessed; ///< Number of buffers processed since beginning of the stream
+    std::vector<Int64>        m_bufferSeeks;      ///< If buffer is an "end buffer", holds next seek position, else NoLoop. For play offset calculation.
 };
 
 } // namespace sf
@@ -350,13 +479,33 @@ private:
 /// \li onGetData fills a new chunk of audio data to be played
 /// \li onSeek changes the current playing position in the source
 ///
-/// It is important to note that each SoundStream is played in its
-/// own separate thread, so that the streaming loop doesn't block the
+/// It is important to note that the streams are played in
+/// separate threads, so that the streaming loop doesn't block the
 /// rest of the program. In particular, the OnGetData and OnSeek
 /// virtual functions may sometimes be called from this separate thread.
 /// It is important to keep this in mind, because you may have to take
 /// care of synchronization issues if you share data between threads.
 ///
+/// These threads are shared by all the streams: rather than
+/// polling them, they sleep until the next time a stream has
+/// played one of its buffers, and then refill this buffer.
+/// Many streams can therefore play at the same time at little
+/// cost; when several of them need new data at once, the ones
+/// closest to running out of audio are served first. The size
+/// of the thread pool can be changed with setStreamingThreadCount. The number and
+/// duration of the buffers can be adjusted per stream with
+/// setBufferCount and setBufferDuration: short buffers reduce
+/// the memory usage and the latency of the stream, more buffers
+/// make it more robust to a slow stream source.
+///
+/// Streams that produce floating point samples (decoders, synthesizers,
+/// effects, ...) can pass them as they are, in the floatSamples
+/// member of the chunk. They are played without being converted
+/// if the audio driver supports floating point buffers (the
+/// AL_EXT_float32 OpenAL extension), and converted to 16-bit
+/// integers otherwise. sf::Music uses floating point samples
+/// when they are supported.
+///
 /// Usage example:
 /// \code
 /// class CustomStream : public sf::SoundStream
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Shape.hpp>
+#include <vector>
 
 
 namespace sf
@@ -111,8 +112,9 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    float       m_radius;     ///< Radius of the circle
-    std::size_t m_pointCount; ///< Number of points composing the circle
+    float                                m_radius;     ///< Radius of the circle
+    std::size_t                          m_pointCount; ///< Number of points composing the circle
+    mutable const std::vector<Vector2f>* m_unitCircle; ///< Shared table of the points of a unit circle with m_pointCount points
 };
 
 } // namespace sf
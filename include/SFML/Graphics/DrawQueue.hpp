@@ -0,0 +1,415 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_DRAWQUEUE_HPP
+#define SFML_DRAWQUEUE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Retained list of draws, sorted and merged
+///        into as few draw calls as possible
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API DrawQueue : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Order in which the draws are sent to the render target
+    ///
+    ////////////////////////////////////////////////////////////
+    enum SortMode
+    {
+        SortByStates, ///< Sort by layer, then by render states within a layer, to merge as many draws as possible
+        KeepOrder     ///< Sort by layer only, draws of a layer keep the order in which they were added
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty queue.
+    ///
+    /// \param mode Order in which the draws are sent
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit DrawQueue(SortMode mode = SortByStates);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~DrawQueue();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable object to the queue
+    ///
+    /// The primitives that the drawable produces are recorded
+    /// right away: the drawable can be modified or destroyed
+    /// afterwards without affecting the queue. Textures,
+    /// shaders and vertex buffers used by the drawable, on
+    /// the other hand, must stay alive as long as the queue
+    /// uses them.
+    ///
+    /// \param drawable Object to add
+    /// \param layer    Layer of the object, lower layers are drawn first
+    /// \param states   Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Drawable& drawable, int layer = 0, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add primitives defined by an array of vertices to the queue
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param layer       Layer of the primitives, lower layers are drawn first
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+             int layer = 0, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the contents of another queue to the queue
+    ///
+    /// The draws of \a queue are added after the ones of this
+    /// queue, with their layers. This is typically used to
+    /// gather queues recorded by several threads before
+    /// drawing them. Appending a queue to itself does nothing.
+    ///
+    /// \param queue Queue to append
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const DrawQueue& queue);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the order in which the draws are sent
+    ///
+    /// \param mode New sort mode
+    ///
+    /// \see getSortMode
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSortMode(SortMode mode);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the order in which the draws are sent
+    ///
+    /// \return Current sort mode
+    ///
+    /// \see setSortMode
+    ///
+    ////////////////////////////////////////////////////////////
+    SortMode getSortMode() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the view that drawables are recorded with
+    ///
+    /// Drawables that cull their contents, such as sf::TileMap
+    /// and sf::SpatialIndex, only record what is visible in
+    /// the view of the target they are drawn to. When they are
+    /// added to a queue, that target is the queue itself:
+    /// set the view of the render target that the queue will
+    /// be drawn to before adding them, otherwise what lies
+    /// outside of the default view (0, 0, 1000, 1000) is lost.
+    /// Drawables that don't cull ignore the view.
+    ///
+    /// \param view New view
+    ///
+    /// \see getView
+    ///
+    ////////////////////////////////////////////////////////////
+    void setView(const View& view);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the view that drawables are recorded with
+    ///
+    /// \return View used for recording
+    ///
+    /// \see setView
+    ///
+    ////////////////////////////////////////////////////////////
+    const View& getView() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove everything from the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the queue is empty
+    ///
+    /// \return True if nothing was added since the last clear
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isEmpty() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of draw calls the queue issues
+    ///
+    /// Sorts and merges the contents of the queue if they
+    /// changed since the last time.
+    ///
+    /// \return Number of draw calls issued when drawing the queue
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getBatchCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the queue to a render target
+    ///
+    /// The transform of \a states is combined with the ones
+    /// of the queued draws; its other members are ignored.
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record primitives
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record indexed primitives
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices, of type \a indexType
+    /// \param indexCount  Number of indices in the array
+    /// \param indexType   Type of the indices
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a vertex buffer, optionally indexed
+    ///
+    /// \param vertexBuffer Vertex buffer to draw
+    /// \param indexBuffer  Index buffer to draw, NULL to draw the vertices in order
+    /// \param first        Position of the first vertex or index to render
+    /// \param count        Number of vertices or indices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void record(const VertexBuffer& vertexBuffer, const IndexBuffer* indexBuffer, std::size_t first, std::size_t count, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sort and merge the recorded draws into batches
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render target that records what is drawn to it
+    ///
+    ////////////////////////////////////////////////////////////
+    class Recorder;
+    friend class Recorder;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Order in which the recorded draws are sent
+    ///
+    ////////////////////////////////////////////////////////////
+    struct CommandOrder;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recorded draw
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Command
+    {
+        int                 layer;        ///< Layer of the draw
+        RenderStates        states;       ///< Render states of the draw, the transform is only used by vertex buffers
+        PrimitiveType       type;         ///< Type of primitives, only lists are recorded
+        std::size_t         first;        ///< Index of the first vertex, in the queue or in the buffers
+        std::size_t         count;        ///< Number of vertices, or of indices if indexBuffer is set
+        const VertexBuffer* vertexBuffer; ///< Vertex buffer to draw, NULL if the vertices are stored in the queue
+        const IndexBuffer*  indexBuffer;  ///< Index buffer to draw along with the vertex buffer, NULL if not indexed
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Merged draws, sent to the render target at once
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Batch
+    {
+        const Command* command; ///< First command of the batch, gives the render states
+        std::size_t    first;   ///< Index of the first vertex in the batch vertices
+        std::size_t    count;   ///< Number of vertices
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Recorder*                   m_recorder;      ///< Render target receiving the drawables
+    SortMode                    m_sortMode;      ///< Order in which the draws are sent
+    int                         m_layer;         ///< Layer of the drawable being recorded
+    std::vector<Vertex>         m_vertices;      ///< Recorded vertices, pre-transformed
+    std::vector<Command>        m_commands;      ///< Recorded draws, in submission order
+    mutable std::vector<Batch>  m_batches;       ///< Sorted and merged draws
+    mutable std::vector<Vertex> m_batchVertices; ///< Vertices of the batches
+    mutable bool                m_needUpdate;    ///< Do the batches need to be rebuilt?
+};
+
+} // namespace sf
+
+
+#endif // SFML_DRAWQUEUE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::DrawQueue
+/// \ingroup graphics
+///
+/// Every draw call sent to a render target has a cost, and
+/// so does every change of texture, shader or blend mode
+/// between two draws. Scenes made of many small objects
+/// (sprites, texts, shapes) are often limited by this cost
+/// rather than by the amount of pixels to fill, unless they
+/// are drawn in a carefully chosen order.
+///
+/// sf::DrawQueue records the primitives of the drawables
+/// added to it, along with a layer. When it is drawn, it
+/// sorts them by layer, shader, texture and blend mode, then
+/// merges consecutive primitives that share the same states
+/// into a single draw call. Since the vertices are transformed
+/// when they are recorded, objects with different transforms
+/// can be merged as well.
+///
+/// Drawables that cull their contents against the view of
+/// the target see the view of the queue instead, which must
+/// thus match the one that the queue is drawn with (see
+/// sf::DrawQueue::setView).
+///
+/// Drawing order is only guaranteed between layers: within a
+/// layer, draws may be reordered to group them by states. Put
+/// objects that overlap in different layers if the order
+/// in which they appear matters, or use the sf::DrawQueue::KeepOrder
+/// sort mode: draws are then only merged with the ones that
+/// directly follow them with the same states.
+///
+/// The queue is retained: it keeps its contents until it is
+/// cleared, and sorting and merging only happens again after
+/// it was modified. Static parts of a scene can thus be
+/// recorded once and drawn every frame for the price of a few
+/// draw calls.
+///
+/// Line strips, triangle strips, triangle fans and quads are
+/// converted to lines and triangles, which means that
+/// sf::Quads can be used even on OpenGL ES through a queue.
+/// Indexed vertex arrays are resolved and merged as well.
+/// Vertex buffers can't be merged, they are only sorted.
+///
+/// Adding to a queue doesn't issue any draw call, only the
+/// final draw to the render target does. Queues can therefore
+/// be filled by several threads at once, each one with its own
+/// queue, so that the traversal of a scene and the transformation
+/// of its vertices scale across cores; the thread that owns
+/// the render target then draws the queues, or appends them
+/// into a single one first. This is limited to the drawables
+/// whose draw function doesn't touch shared state:
+/// \li Raw vertices, sf::VertexArray, sf::Sprite and vertex
+///     buffers (recorded by reference) can be added from any
+///     thread, as long as they are not modified meanwhile.
+/// \li sf::Shape and sf::Text rebuild their vertices when
+///     they are drawn after a change, and sf::SpatialIndex
+///     stores the result of its search: each instance must
+///     only be added by one thread at a time.
+/// \li sf::Text loads the glyphs it needs into the texture
+///     of its font, which needs an OpenGL context and must
+///     not happen from several threads: only add texts whose
+///     glyphs were already loaded, or add them from the
+///     thread that owns the render target.
+/// \li sf::TileMap uploads its modified chunks to vertex
+///     buffers when it is drawn, which needs an OpenGL
+///     context as well: add it from the thread that owns
+///     the render target.
+///
+/// Usage example:
+/// \code
+/// sf::DrawQueue queue;
+/// queue.setView(window.getView());
+///
+/// // Backgrounds first, then characters, then the user interface
+/// for (std::size_t i = 0; i < tiles.size(); ++i)
+///     queue.add(tiles[i], 0);
+/// for (std::size_t i = 0; i < characters.size(); ++i)
+///     queue.add(characters[i], 1);
+/// queue.add(scoreText, 2);
+///
+/// window.draw(queue);
+/// queue.clear();
+/// \endcode
+///
+/// Recording from several threads:
+/// \code
+/// // In each worker thread, with its own queue
+/// void recordChunk(Chunk& chunk)
+/// {
+///     for (std::size_t i = 0; i < chunk.objects.size(); ++i)
+///         chunk.queue.add(chunk.objects[i]);
+/// }
+///
+/// // In the render thread, once the workers are done
+/// sf::DrawQueue frame(sf::DrawQueue::KeepOrder);
+/// for (std::size_t i = 0; i < chunks.size(); ++i)
+///     frame.append(chunks[i].queue);
+/// window.draw(frame);
+/// \endcode
+///
+/// \see sf::Drawable, sf::RenderStates
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GPUFENCE_HPP
+#define SFML_GPUFENCE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Synchronization point between the CPU, the GPU
+///        and the OpenGL contexts
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API GpuFence : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// The fence is not inserted, it is considered signaled.
+    ///
+    ////////////////////////////////////////////////////////////
+    GpuFence();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~GpuFence();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert the fence in the command stream of the active context
+    ///
+    /// The fence becomes signaled once all the OpenGL commands
+    /// issued so far in the active context are complete. If it
+    /// was already inserted and not signaled yet, the previous
+    /// insertion is replaced.
+    ///
+    /// The commands are flushed, so that the other contexts
+    /// can wait for the fence.
+    ///
+    ////////////////////////////////////////////////////////////
+    void insert();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the fence is signaled
+    ///
+    /// This function doesn't block. If the driver fails to
+    /// query the fence, it is considered signaled and released,
+    /// rather than reported as pending forever.
+    ///
+    /// \return True if the commands preceding the fence are complete
+    ///         or if the fence was not inserted, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSignaled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Block the calling thread until the fence is signaled
+    ///
+    /// If no timeout is given (or Time::Zero), the function
+    /// waits for as long as necessary.
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the fence is signaled, false if the timeout expired
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout = Time::Zero) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the active context wait for the fence
+    ///
+    /// The OpenGL commands issued after this call in the
+    /// active context are executed once the fence is signaled.
+    /// Contrary to wait(), the calling thread is not blocked:
+    /// the wait happens on the GPU.
+    ///
+    /// This is what makes resources modified in another
+    /// context safe to use in the active context. It does
+    /// nothing if the fence was inserted in the active context,
+    /// since the commands of a context are executed in order.
+    ///
+    ////////////////////////////////////////////////////////////
+    void synchronize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports fences
+    ///
+    /// When fences are not supported, insert() only flushes
+    /// the OpenGL commands, wait() waits for all the commands
+    /// of the active context to complete, and the fence is
+    /// otherwise always considered signaled.
+    ///
+    /// \return True if fences are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the OpenGL sync object, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void release() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable void*  m_sync;      ///< OpenGL sync object, NULL if none is pending
+    mutable Uint64 m_contextId; ///< Identifier of the context the fence was inserted in
+};
+
+} // namespace sf
+
+
+#endif // SFML_GPUFENCE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::GpuFence
+/// \ingroup graphics
+///
+/// OpenGL commands are executed asynchronously by the GPU,
+/// and each context has its own command stream. sf::GpuFence
+/// marks a point in the command stream of a context, and
+/// allows to:
+/// \li know whether the GPU has gone past that point without
+///     blocking (isSignaled), for example to tell whether a
+///     buffer of a multi-buffered stream is free to be updated
+/// \li block the CPU until the GPU has gone past it (wait)
+/// \li make another context wait for it on the GPU side
+///     (synchronize), so that resources updated in a thread
+///     can be used in another thread's context
+///
+/// SFML already does the latter internally for sf::Texture,
+/// sf::RenderTexture and sf::VertexBuffer: when they are
+/// updated in a context and used in another one, the using
+/// context waits for the update to complete.
+///
+/// Fences rely on OpenGL 3.2 or the GL_ARB_sync extension,
+/// see isAvailable for the behavior when they are not supported.
+///
+/// Usage example (triple-buffered streaming):
+/// \code
+/// sf::VertexBuffer buffers[3];
+/// sf::GpuFence fences[3];
+///
+/// // ... create the buffers ...
+///
+/// unsigned int current = 0;
+/// while (window.isOpen())
+/// {
+///     // Make sure the GPU is done drawing the buffer we are about to overwrite
+///     fences[current].wait();
+///
+///     buffers[current].update(vertices);
+///     window.draw(buffers[current]);
+///
+///     // The buffer is free once the commands issued so far are complete
+///     fences[current].insert();
+///     current = (current + 1) % 3;
+///
+///     window.display();
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
@@ -260,6 +260,8 @@ public:
 
 private:
 
+    friend class RenderImage;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -0,0 +1,353 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_INDEXBUFFER_HPP
+#define SFML_INDEXBUFFER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Index buffer storage, selecting the vertices
+///        of a vertex buffer to draw
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API IndexBuffer : private GlResource
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Size of the indices stored in the buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    enum IndexType
+    {
+        Index16, ///< 16-bit indices (sf::Uint16), up to 65536 vertices
+        Index32  ///< 32-bit indices (sf::Uint32)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty index buffer of 16-bit indices.
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific index type
+    ///
+    /// Creates an empty index buffer and sets its index type to \p type.
+    ///
+    /// \param type Type of the indices
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit IndexBuffer(IndexType type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an IndexBuffer with a specific index type and usage specifier
+    ///
+    /// Creates an empty index buffer and sets its index type
+    /// to \p type and usage to \p usage.
+    ///
+    /// \param type  Type of the indices
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer(IndexType type, VertexBuffer::Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// \param copy instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer(const IndexBuffer& copy);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~IndexBuffer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the index buffer
+    ///
+    /// Creates the index buffer and allocates enough graphics
+    /// memory to hold \p indexCount indices. Any previously
+    /// allocated memory is freed in the process.
+    ///
+    /// Creating a buffer of 32-bit indices fails on OpenGL ES
+    /// platforms that don't support them.
+    ///
+    /// \param indexCount Number of indices worth of memory to allocate
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(std::size_t indexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the index count
+    ///
+    /// \return Number of indices in the index buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a buffer of 16-bit indices
+    ///
+    /// \p offset is specified as the number of indices to skip
+    /// from the beginning of the buffer. The rules for resizing
+    /// are the same as for sf::VertexBuffer::update.
+    ///
+    /// This function fails if the buffer doesn't store 16-bit
+    /// indices, if \a indices is null or if the buffer was not
+    /// previously created.
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint16* indices, std::size_t indexCount, unsigned int offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of a buffer of 32-bit indices
+    ///
+    /// \p offset is specified as the number of indices to skip
+    /// from the beginning of the buffer. The rules for resizing
+    /// are the same as for sf::VertexBuffer::update.
+    ///
+    /// This function fails if the buffer doesn't store 32-bit
+    /// indices, if \a indices is null or if the buffer was not
+    /// previously created.
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const Uint32* indices, std::size_t indexCount, unsigned int offset = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy the contents of another buffer into this buffer
+    ///
+    /// Both buffers must store the same type of indices.
+    ///
+    /// \param indexBuffer Index buffer whose contents to copy into this index buffer
+    ///
+    /// \return True if the copy was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update(const IndexBuffer& indexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexBuffer& operator =(const IndexBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Swap the contents of this index buffer with those of another
+    ///
+    /// \param right Instance to swap with
+    ///
+    ////////////////////////////////////////////////////////////
+    void swap(IndexBuffer& right);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the underlying OpenGL handle of the index buffer.
+    ///
+    /// You shouldn't need to use this function, unless you have
+    /// very specific stuff to implement that SFML doesn't support,
+    /// or implement a temporary workaround until a bug is fixed.
+    ///
+    /// \return OpenGL handle of the index buffer or 0 if not yet created
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getNativeHandle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the type of the indices stored in the buffer
+    ///
+    /// \return Index type
+    ///
+    ////////////////////////////////////////////////////////////
+    IndexType getIndexType() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the usage specifier of this index buffer
+    ///
+    /// After changing the usage specifier, the index buffer has
+    /// to be updated with new data for the usage specifier to
+    /// take effect.
+    ///
+    /// The default usage is sf::VertexBuffer::Stream.
+    ///
+    /// \param usage Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUsage(VertexBuffer::Usage usage);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the usage specifier of this index buffer
+    ///
+    /// \return Usage specifier
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexBuffer::Usage getUsage() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind an index buffer for rendering
+    ///
+    /// This function is not part of the graphics API, it mustn't be
+    /// used when drawing SFML entities. It must be used only if you
+    /// mix sf::IndexBuffer with OpenGL code.
+    ///
+    /// \param indexBuffer Pointer to the index buffer to bind, can be null to use no index buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void bind(const IndexBuffer* indexBuffer);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports index buffers
+    ///
+    /// Index buffers are available whenever vertex buffers are.
+    ///
+    /// \return True if index buffers are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether or not the system supports 32-bit indices
+    ///
+    /// 32-bit indices are always supported on desktop OpenGL,
+    /// they are optional on OpenGL ES. This applies to index
+    /// buffers as well as to indexed client-side vertex arrays.
+    ///
+    /// \return True if 32-bit indices are supported, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isIndex32Available();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload indices to the buffer
+    ///
+    /// \param indices    Array of indices to copy to the buffer
+    /// \param indexCount Number of indices to copy
+    /// \param offset     Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool upload(const void* indices, std::size_t indexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of one index, in bytes
+    ///
+    /// \return Size of an index
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndexSize() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int        m_buffer; ///< Internal buffer identifier
+    std::size_t         m_size;   ///< Size in indices of the currently allocated buffer
+    IndexType           m_type;   ///< Type of the indices
+    VertexBuffer::Usage m_usage;  ///< How this index buffer is to be used
+};
+
+} // namespace sf
+
+
+#endif // SFML_INDEXBUFFER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::IndexBuffer
+/// \ingroup graphics
+///
+/// sf::IndexBuffer is a simple wrapper around a dynamic
+/// buffer of vertex indices, stored in graphics memory.
+///
+/// It is used together with a sf::VertexBuffer: instead of
+/// drawing the vertices of the vertex buffer in order, the
+/// render target draws the vertices whose indices are listed
+/// in the index buffer. Vertices shared by several primitives
+/// thus only have to be stored once; a quad made of two
+/// triangles needs 4 vertices and 6 indices instead of 6
+/// vertices, and doesn't require the sf::Quads primitive type
+/// which is unavailable on OpenGL ES and in core profile
+/// contexts.
+///
+/// Indices are either 16-bit (the default) or 32-bit wide.
+/// 16-bit indices use half the memory but can only address
+/// the first 65536 vertices of a vertex buffer.
+///
+/// Since it doesn't hold vertices, sf::IndexBuffer is not
+/// drawable on its own.
+///
+/// Example:
+/// \code
+/// sf::Vertex vertices[4];
+/// ...
+/// sf::VertexBuffer quad(sf::Triangles, sf::VertexBuffer::Static);
+/// quad.create(4);
+/// quad.update(vertices);
+///
+/// const sf::Uint16 indices[] = {0, 1, 2, 0, 2, 3};
+/// sf::IndexBuffer quadIndices(sf::IndexBuffer::Index16, sf::VertexBuffer::Static);
+/// quadIndices.create(6);
+/// quadIndices.update(indices, 6);
+/// ...
+/// window.draw(quad, quadIndices);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
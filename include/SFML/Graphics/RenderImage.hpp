@@ -0,0 +1,441 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERIMAGE_HPP
+#define SFML_RENDERIMAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/Config.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Target for off-screen 2D rendering into an image,
+///        rasterized on the CPU
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderImage : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs an empty, invalid render-image. You must
+    /// call create to have a valid render-image.
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual ~RenderImage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-image
+    ///
+    /// Before calling this function, the render-image is in
+    /// an invalid state, thus it is mandatory to call it before
+    /// doing anything with the render-image.
+    /// The contents of the image are initialized to transparent
+    /// black.
+    ///
+    /// \param width  Width of the render-image
+    /// \param height Height of the render-image
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of threads used for rasterization
+    ///
+    /// The image is split into tiles which are rasterized in
+    /// parallel by this number of threads, including the one
+    /// that calls display(). The result doesn't depend on it.
+    /// The default is 4.
+    ///
+    /// \param count Number of threads, 1 to rasterize on the calling thread only
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of threads used for rasterization
+    ///
+    /// \return Number of threads
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the render-image for rendering
+    ///
+    /// A render-image doesn't render with OpenGL, there is
+    /// nothing to activate: this function always succeeds.
+    /// Note that drawing with a texture still reads its pixels
+    /// back from the graphics card (see the class description).
+    ///
+    /// \param active True to activate, false to deactivate
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setActive(bool active = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the contents of the target image
+    ///
+    /// Primitives are only collected when they are drawn; this
+    /// function rasterizes everything that has been drawn since
+    /// the last call into the target image. Like for windows,
+    /// calling this function is mandatory at the end of
+    /// rendering.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the rendering region of the image
+    ///
+    /// The returned value is the size that you passed to
+    /// the create function.
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to the target image
+    ///
+    /// After drawing to the render-image and calling display,
+    /// you can retrieve the updated image using this function,
+    /// and save it or upload it to a texture (for example).
+    ///
+    /// \return Const reference to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage() const;
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect primitives to rasterize
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const Vertex* vertices, std::size_t vertexCount,
+                         PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reject a vertex buffer
+    ///
+    /// The contents of vertex buffers live on the graphics
+    /// card, they can't be rasterized on the CPU.
+    ///
+    /// \param vertexBuffer Vertex buffer to draw
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                         std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect indexed primitives to rasterize
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices, of type \a indexType
+    /// \param indexCount  Number of indices in the array
+    /// \param indexType   Type of the indices
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                         IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reject an indexed vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer to draw
+    /// \param indexBuffer  Index buffer to draw
+    /// \param firstIndex   Position of the first index to use
+    /// \param indexCount   Number of indices to use
+    /// \param states       Render states to use for drawing
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer,
+                         std::size_t firstIndex, std::size_t indexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the image and discard the collected primitives
+    ///
+    /// \param color Fill color
+    ///
+    /// \return Always true
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool captureClear(const Color& color);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Texture state shared by the triangles of a draw
+    ///
+    ////////////////////////////////////////////////////////////
+    struct DrawState
+    {
+        BlendMode    blendMode; ///< Blending mode of the draw
+        const Image* texture;   ///< Pixels of the texture, NULL if not textured
+        bool         smooth;    ///< Is the texture filtered bilinearly?
+        bool         repeated;  ///< Is the texture repeated?
+        IntRect      scissor;   ///< Area of the image covered by the viewport
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Triangle ready to be rasterized
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Triangle
+    {
+        Vertex      vertices[3]; ///< Vertices, positioned in pixels
+        std::size_t state;       ///< Index of the draw state
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy of a texture's pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureImage
+    {
+        Uint64 cacheId; ///< Cache identifier of the texture when it was copied
+        Image  image;   ///< Pixels of the texture
+        bool   used;    ///< Was the texture used since the last display?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Begin a draw with the given render states
+    ///
+    /// \param states Render states of the draw
+    ///
+    /// \return Transform from the vertex coordinates to pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform beginDraw(const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect the primitives of a vertex array
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPrimitives(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect a point, as a square of one pixel
+    ///
+    /// \param point Vertex of the point, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPoint(const Vertex& point);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect a line, as a rectangle one pixel thick
+    ///
+    /// \param a First vertex of the line, in pixels
+    /// \param b Second vertex of the line, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void addLine(const Vertex& a, const Vertex& b);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Collect a triangle and add it to the tiles it overlaps
+    ///
+    /// \param a First vertex, in pixels
+    /// \param b Second vertex, in pixels
+    /// \param c Third vertex, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void addTriangle(const Vertex& a, const Vertex& b, const Vertex& c);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pixels of a texture
+    ///
+    /// Textures are copied once and copied again
+    /// only after they were modified. What was drawn with
+    /// the previous pixels is rasterized before, without
+    /// forgetting the unused textures like display() does.
+    ///
+    /// \param texture Texture to get the pixels of
+    ///
+    /// \return Pixels of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image* getTextureImage(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the collected primitives into the target image
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterize();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize tiles until there is none left
+    ///
+    /// This function is run by all the rasterization threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterizeTiles();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a triangle into a rectangle of the image
+    ///
+    /// \param triangle Triangle to rasterize
+    /// \param area     Area of the image to fill
+    ///
+    ////////////////////////////////////////////////////////////
+    void rasterize(const Triangle& triangle, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Image                                   m_image;       ///< Target image
+    unsigned int                            m_threadCount; ///< Number of rasterization threads
+    std::vector<DrawState>                  m_states;      ///< States of the collected draws
+    std::vector<Triangle>                   m_triangles;   ///< Collected triangles
+    std::vector<std::vector<Uint32> >       m_tiles;       ///< Indices of the triangles overlapping each tile
+    Vector2u                                m_tileCount;   ///< Number of tiles in each direction
+    std::size_t                             m_nextTile;    ///< Next tile to rasterize, shared by the threads
+    Mutex                                   m_tileMutex;   ///< Mutex protecting m_nextTile
+    std::map<const Texture*, TextureImage>  m_textures;    ///< Copies of the textures in use
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERIMAGE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderImage
+/// \ingroup graphics
+///
+/// sf::RenderImage is the little brother of sf::RenderTexture.
+/// It implements the same 2D rendering features, but without
+/// OpenGL: primitives are rasterized on the CPU, straight into
+/// an sf::Image. It is meant for environments that have no
+/// graphics card, such as servers generating thumbnails or
+/// batch jobs; the same drawables can be rendered to it
+/// without any change.
+///
+/// Supported features are triangles (points, lines and quads
+/// are converted to triangles), vertex colors, textures
+/// (smooth or not, repeated or not), views and viewports,
+/// and all the blend modes. Shaders and vertex buffers are
+/// not supported: shaders are ignored, and vertex buffers
+/// are not drawn since their contents live on the graphics
+/// card.
+///
+/// Drawing only collects the primitives; they are rasterized
+/// in display(), by several threads working on separate
+/// tiles of the image. The result is the same whatever the
+/// number of threads.
+///
+/// Textures are still sf::Texture instances, whose pixels
+/// are copied (with Texture::copyToImage) the first time
+/// they are used, and again only after they change. This
+/// copy is an OpenGL readback: loading textures and drawing
+/// textured primitives thus still require an OpenGL context,
+/// which can be a headless one on machines without a display
+/// (see sf::Context). Untextured drawing doesn't use OpenGL
+/// at all.
+///
+/// Usage example:
+///
+/// \code
+/// // Create a new render-image
+/// sf::RenderImage image;
+/// if (!image.create(256, 256))
+///     return -1;
+///
+/// // Draw a thumbnail of the scene
+/// sf::View view(sceneBounds);
+/// image.setView(view);
+/// image.clear(sf::Color::White);
+/// image.draw(sprite);
+/// image.draw(text);
+///
+/// // We're done drawing to the image
+/// image.display();
+///
+/// // Save the result
+/// image.getImage().saveToFile("thumbnail.png");
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderTexture, sf::Image
+///
+////////////////////////////////////////////////////////////
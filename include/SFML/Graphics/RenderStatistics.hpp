@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERSTATISTICS_HPP
+#define SFML_RENDERSTATISTICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Time.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Rendering statistics gathered by a render target over a frame
+///
+////////////////////////////////////////////////////////////
+struct SFML_GRAPHICS_API RenderStatistics
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief CPU-side counters of the work submitted to OpenGL
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Counters
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Sets all the counters to zero.
+        ///
+        ////////////////////////////////////////////////////////////
+        Counters();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int drawCalls;           ///< Number of draw calls issued
+        std::size_t  vertices;            ///< Number of vertices drawn
+        unsigned int stateChanges;        ///< Number of view, transform and blend mode changes
+        unsigned int textureBinds;        ///< Number of texture binds
+        unsigned int shaderBinds;         ///< Number of shader binds
+        unsigned int skippedStateChanges; ///< Number of OpenGL calls avoided because the state was already set
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics of a named profiling scope
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Scope
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Scope();
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        std::string  name;     ///< Name given to the scope when it was opened
+        unsigned int depth;    ///< Nesting level of the scope, 0 for top-level scopes
+        Counters     counters; ///< Work submitted between the beginning and the end of the scope
+        Time         gpuTime;  ///< Time spent by the GPU executing the scope
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates empty statistics.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderStatistics();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64             frame;            ///< Index of the frame these statistics belong to
+    Counters           counters;         ///< Work submitted during the whole frame
+    Time               gpuTime;          ///< Time spent by the GPU executing the frame
+    bool               gpuTimeAvailable; ///< Whether GPU times could be measured for this frame
+    std::vector<Scope> scopes;           ///< Profiling scopes, in the order they were opened
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERSTATISTICS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderStatistics
+/// \ingroup graphics
+///
+/// sf::RenderStatistics is what sf::RenderTarget::getStatistics
+/// returns once profiling has been enabled on a render target
+/// with sf::RenderTarget::setProfilingEnabled.
+///
+/// The counters are gathered on the CPU side and tell how much
+/// work was submitted to the driver: draw calls, vertices, and
+/// the number of times the view, transform, blend mode, texture
+/// or shader had to be changed.
+///
+/// GPU times are measured with OpenGL timer queries when they
+/// are supported (see gpuTimeAvailable). Since waiting for the
+/// GPU to finish a frame would stall the pipeline, results are
+/// only read back once they are ready, which means that the
+/// published statistics usually describe a frame which is one
+/// or two frames old (see frame).
+///
+/// Scopes, opened and closed with
+/// sf::RenderTarget::beginProfilingScope and
+/// sf::RenderTarget::endProfilingScope, allow to attribute
+/// a part of the frame's cost to a subsystem of your application.
+///
+/// Usage example:
+/// \code
+/// window.setProfilingEnabled(true);
+///
+/// while (window.isOpen())
+/// {
+///     ...
+///     window.clear();
+///
+///     window.beginProfilingScope("world");
+///     drawWorld(window);
+///     window.endProfilingScope();
+///
+///     window.beginProfilingScope("ui");
+///     drawUi(window);
+///     window.endProfilingScope();
+///
+///     window.display();
+///
+///     const sf::RenderStatistics& stats = window.getStatistics();
+///     log(stats.counters.drawCalls, stats.gpuTime.asMicroseconds());
+/// }
+/// \endcode
+///
+/// \see sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
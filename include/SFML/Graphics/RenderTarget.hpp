@@ -34,14 +34,23 @@
 #include <SFML/Graphics/View.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderStatistics.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <string>
 
 
 namespace sf
 {
+namespace priv
+{
+    class RenderTargetCore;
+    class RenderTargetProfiler;
+}
+
 class Drawable;
 class VertexBuffer;
 
@@ -268,6 +277,64 @@ public:
     ////////////////////////////////////////////////////////////
     void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices of the vertices to draw
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by an array of vertices
+    ///
+    /// 32-bit indices may be unsupported on OpenGL ES, see
+    /// sf::IndexBuffer::isIndex32Available.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices of the vertices to draw
+    /// \param indexCount  Number of indices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer
+    ///
+    /// The vertices of \a vertexBuffer are drawn in the order
+    /// given by \a indexBuffer, using the primitive type of
+    /// the vertex buffer.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives defined by a vertex buffer
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param indexBuffer  Index buffer
+    /// \param firstIndex   Position of the first index to use in the index buffer
+    /// \param indexCount   Number of indices to use
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex,
+              std::size_t indexCount, const RenderStates& states = RenderStates::Default);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
     ///
@@ -366,6 +433,79 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the gathering of rendering statistics
+    ///
+    /// When profiling is enabled, the render target counts the
+    /// work it submits to OpenGL (draw calls, vertices, state
+    /// changes, texture and shader binds) and measures the time
+    /// the GPU spends executing it, if timer queries are supported.
+    /// Statistics are gathered per frame, a frame ending every
+    /// time display() is called.
+    ///
+    /// Profiling is disabled by default. It has a small cost,
+    /// so you should only enable it when you need the statistics.
+    ///
+    /// \param enabled True to enable profiling, false to disable it
+    ///
+    /// \see isProfilingEnabled, getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProfilingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the gathering of rendering statistics is enabled
+    ///
+    /// \return True if profiling is enabled, false otherwise
+    ///
+    /// \see setProfilingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isProfilingEnabled() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a named profiling scope
+    ///
+    /// Everything drawn until the matching call to
+    /// endProfilingScope is accounted to this scope, in addition
+    /// to the frame. Scopes can be nested, and must be closed
+    /// before the end of the frame.
+    ///
+    /// This function does nothing if profiling is disabled.
+    ///
+    /// \param name Name of the scope, used to identify it in the statistics
+    ///
+    /// \see endProfilingScope, getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginProfilingScope(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the most recently opened profiling scope
+    ///
+    /// This function does nothing if profiling is disabled.
+    ///
+    /// \see beginProfilingScope
+    ///
+    ////////////////////////////////////////////////////////////
+    void endProfilingScope();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the last profiled frame
+    ///
+    /// GPU results are read back without stalling, so the
+    /// returned statistics usually belong to a frame which
+    /// ended one or two frames ago.
+    ///
+    /// If profiling is disabled, empty statistics are returned.
+    ///
+    /// \return Statistics of the most recent frame whose results are ready
+    ///
+    /// \see setProfilingEnabled
+    ///
+    ////////////////////////////////////////////////////////////
+    const RenderStatistics& getStatistics() const;
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -383,6 +523,96 @@ protected:
     ////////////////////////////////////////////////////////////
     void initialize();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the current profiling frame
+    ///
+    /// The derived classes must call this function every time
+    /// they display the contents of the target. It does nothing
+    /// if profiling is disabled.
+    ///
+    ////////////////////////////////////////////////////////////
+    void endProfilingFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture primitives instead of drawing them
+    ///
+    /// Render targets that don't render immediately (such as
+    /// the recorder of sf::DrawQueue) override this function
+    /// to store the primitives they receive. The default
+    /// implementation captures nothing.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return True if the primitives were captured and must not be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const Vertex* vertices, std::size_t vertexCount,
+                         PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture a vertex buffer instead of drawing it
+    ///
+    /// \param vertexBuffer Vertex buffer to draw
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    /// \return True if the vertex buffer was captured and must not be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                         std::size_t vertexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture indexed primitives instead of drawing them
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices, of type \a indexType
+    /// \param indexCount  Number of indices in the array
+    /// \param indexType   Type of the indices
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \return True if the primitives were captured and must not be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                         IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture an indexed vertex buffer instead of drawing it
+    ///
+    /// \param vertexBuffer Vertex buffer to draw
+    /// \param indexBuffer  Index buffer to draw
+    /// \param firstIndex   Position of the first index to use
+    /// \param indexCount   Number of indices to use
+    /// \param states       Render states to use for drawing
+    ///
+    /// \return True if the vertex buffer was captured and must not be drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer,
+                         std::size_t firstIndex, std::size_t indexCount, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture a clear instead of performing it
+    ///
+    /// Render targets that don't render with OpenGL (such as
+    /// sf::RenderImage) override this function to clear their
+    /// contents themselves. The default implementation
+    /// captures nothing.
+    ///
+    /// \param color Fill color
+    ///
+    /// \return True if the clear was captured and must not be performed
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool captureClear(const Color& color);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -429,8 +659,10 @@ private:
     /// \param useVertexCache Are we going to use the vertex cache?
     /// \param states         Render states to use for drawing
     ///
+    /// \return False if the active context can't be drawn into
+    ///
     ////////////////////////////////////////////////////////////
-    void setupDraw(bool useVertexCache, const RenderStates& states);
+    bool setupDraw(bool useVertexCache, const RenderStates& states);
 
     ////////////////////////////////////////////////////////////
     /// \brief Draw the primitives
@@ -442,6 +674,34 @@ private:
     ////////////////////////////////////////////////////////////
     void drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices,
+    ///        optionally indexed
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param indices     Pointer to the indices, NULL to draw the vertices in order
+    /// \param indexCount  Number of indices in the array
+    /// \param indexType   Type of the indices
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawVertices(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                      IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw indexed primitives
+    ///
+    /// \param type       Type of primitives to draw
+    /// \param indices    Pointer to the indices, or offset in the bound index buffer
+    /// \param indexCount Number of indices to use when drawing
+    /// \param indexType  Type of the indices
+    /// \param baseVertex Index of the vertex that the indices are relative to
+    ///
+    ////////////////////////////////////////////////////////////
+    void drawIndexedPrimitives(PrimitiveType type, const void* indices, std::size_t indexCount, IndexBuffer::IndexType indexType, std::size_t baseVertex);
+
     ////////////////////////////////////////////////////////////
     /// \brief Clean up environment after drawing
     ///
@@ -458,23 +718,34 @@ private:
     {
         enum {VertexCacheSize = 4};
 
-        bool      enable;         ///< Is the cache enabled?
-        bool      glStatesSet;    ///< Are our internal GL states set yet?
-        bool      viewChanged;    ///< Has the current view changed since last draw?
-        BlendMode lastBlendMode;  ///< Cached blending mode
-        Uint64    lastTextureId;  ///< Cached texture
-        bool      texCoordsArrayEnabled; ///< Is GL_TEXTURE_COORD_ARRAY client state enabled?
-        bool      useVertexCache; ///< Did we previously use the vertex cache?
-        Vertex    vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
+        bool        enable;                ///< Is the cache enabled?
+        bool        glStatesSet;           ///< Are our internal GL states set yet?
+        bool        drawingSkipped;        ///< Is the context unusable (core profile without the programmable pipeline)?
+        bool        viewChanged;           ///< Has the current view changed since last draw?
+        IntRect     lastViewport;          ///< Cached viewport
+        Transform   lastProjection;        ///< Cached projection matrix
+        Transform   lastTransform;         ///< Cached model-view matrix
+        BlendMode   lastBlendMode;         ///< Cached blending mode
+        Uint64      lastTextureId;         ///< Cached texture bound to texture unit 0
+        float       lastTextureMatrix[16]; ///< Cached texture matrix of texture unit 0
+        Uint64      lastShaderId;          ///< Cached shader
+        const void* lastArrayData;         ///< Cached client memory the vertex array pointers point to
+        Uint64      lastVertexBufferId;    ///< Cached vertex buffer the vertex array pointers point to
+        bool        texCoordsPointerSet;   ///< Does the texture coordinates pointer match the other array pointers?
+        bool        texCoordsArrayEnabled; ///< Is GL_TEXTURE_COORD_ARRAY client state enabled?
+        bool        useVertexCache;        ///< Did we previously use the vertex cache?
+        Vertex      vertexCache[VertexCacheSize]; ///< Pre-transformed vertices cache
     };
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
-    Uint64      m_id;          ///< Unique number that identifies the RenderTarget
+    View                        m_defaultView; ///< Default view
+    View                        m_view;        ///< Current view
+    StatesCache                 m_cache;       ///< Render states cache
+    Uint64                      m_id;          ///< Unique number that identifies the RenderTarget
+    priv::RenderTargetProfiler* m_profiler;    ///< Statistics gatherer, NULL when profiling is disabled
+    priv::RenderTargetCore*     m_core;        ///< Programmable pipeline, NULL unless the context uses the core profile
 };
 
 } // namespace sf
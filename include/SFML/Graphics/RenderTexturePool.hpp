@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERTEXTUREPOOL_HPP
+#define SFML_RENDERTEXTUREPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Window/ContextSettings.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <list>
+#include <map>
+
+
+namespace sf
+{
+class RenderTexture;
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of reusable render-textures
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RenderTexturePool : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs an empty pool.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Destroys all the render-textures owned by the pool,
+    /// including those which have not been released yet.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTexturePool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a render-texture from the pool
+    ///
+    /// The requested size is first rounded up to the next
+    /// multiple of the pool granularity. If an unused
+    /// render-texture with the resulting size and compatible
+    /// settings is available, it is handed out again, otherwise
+    /// a new one is created.
+    ///
+    /// The view of a recycled render-texture is reset to its
+    /// default view, and smoothing and repeating are disabled,
+    /// so that it behaves like a freshly created one. Its contents
+    /// are left untouched though, you should clear it before
+    /// drawing anything to it.
+    ///
+    /// The returned render-texture remains owned by the pool,
+    /// don't delete it: call release when you no longer need it.
+    ///
+    /// \param width    Minimum width of the render-texture
+    /// \param height   Minimum height of the render-texture
+    /// \param settings Additional settings for the underlying OpenGL texture and context
+    ///
+    /// \return Pointer to the render-texture, or NULL if it couldn't be created
+    ///
+    /// \see release, setGranularity
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* acquire(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give a render-texture back to the pool
+    ///
+    /// The render-texture must have been obtained with acquire
+    /// on this pool. Once released, it may be handed out again
+    /// by a later call to acquire and must not be used anymore.
+    ///
+    /// If the number of unused render-textures exceeds the
+    /// limit set with setMaximumUnusedCount, the least recently
+    /// released ones are destroyed.
+    ///
+    /// \param renderTexture Render-texture to release
+    ///
+    /// \see acquire
+    ///
+    ////////////////////////////////////////////////////////////
+    void release(RenderTexture* renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the size granularity of the pool
+    ///
+    /// Requested sizes are rounded up to the next multiple of
+    /// the granularity, so that requests of slightly different
+    /// sizes fall in the same bucket and can share render-textures.
+    /// The drawback is that the render-textures may then be
+    /// bigger than requested, in which case you should only use
+    /// the relevant part of them (with a texture rect for example).
+    ///
+    /// The default granularity is 1, which means that
+    /// render-textures are only reused for the exact same size.
+    /// Changing the granularity doesn't affect render-textures
+    /// already in the pool.
+    ///
+    /// \param granularity New granularity, in pixels (0 is treated as 1)
+    ///
+    /// \see getGranularity
+    ///
+    ////////////////////////////////////////////////////////////
+    void setGranularity(unsigned int granularity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size granularity of the pool
+    ///
+    /// \return Current granularity, in pixels
+    ///
+    /// \see setGranularity
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getGranularity() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of unused render-textures kept alive
+    ///
+    /// The default limit is 16.
+    ///
+    /// \param count Maximum number of unused render-textures
+    ///
+    /// \see getMaximumUnusedCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setMaximumUnusedCount(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of unused render-textures kept alive
+    ///
+    /// \return Maximum number of unused render-textures
+    ///
+    /// \see setMaximumUnusedCount
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getMaximumUnusedCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render-textures currently handed out
+    ///
+    /// \return Number of acquired render-textures not released yet
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUsedCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of render-textures waiting to be reused
+    ///
+    /// \return Number of unused render-textures
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getUnusedCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy all the unused render-textures
+    ///
+    /// Render-textures which are currently in use are not affected.
+    ///
+    ////////////////////////////////////////////////////////////
+    void purge();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifies the bucket a render-texture belongs to
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Bucket
+    {
+        Bucket(unsigned int bucketWidth, unsigned int bucketHeight, const ContextSettings& settings);
+
+        bool operator ==(const Bucket& right) const;
+
+        unsigned int width;             ///< Width of the render-texture
+        unsigned int height;            ///< Height of the render-texture
+        unsigned int depthBits;         ///< Bits of the depth buffer
+        unsigned int stencilBits;       ///< Bits of the stencil buffer
+        unsigned int antialiasingLevel; ///< Level of antialiasing
+        bool         sRgbCapable;       ///< Whether the render-texture is sRGB capable
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unused render-texture waiting to be recycled
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Entry(const Bucket& entryBucket, RenderTexture* entryTexture);
+
+        Bucket         bucket;        ///< Bucket of the render-texture
+        RenderTexture* renderTexture; ///< The render-texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy unused render-textures until the limit is honored
+    ///
+    ////////////////////////////////////////////////////////////
+    void trim();
+
+    ////////////////////////////////////////////////////////////
+    // Types
+    ////////////////////////////////////////////////////////////
+    typedef std::list<Entry> UnusedList;
+    typedef std::map<RenderTexture*, Bucket> UsedMap;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    UnusedList   m_unused;         ///< Unused render-textures, most recently released first
+    UsedMap      m_used;           ///< Render-textures currently handed out, with their bucket
+    unsigned int m_granularity;    ///< Size granularity, in pixels
+    std::size_t  m_maxUnusedCount; ///< Maximum number of unused render-textures kept alive
+};
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTEXTUREPOOL_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RenderTexturePool
+/// \ingroup graphics
+///
+/// Creating a sf::RenderTexture is an expensive operation:
+/// it allocates a texture, a frame buffer object, possibly
+/// depth/stencil and multisample buffers, and sometimes even
+/// a dedicated OpenGL context. Doing this every frame for
+/// short-lived off-screen targets (tooltips, blurred
+/// backgrounds, ...) leads to visible frame time spikes.
+///
+/// sf::RenderTexturePool keeps render-textures around once
+/// they are no longer needed, sorted by size and settings,
+/// and hands them out again when a compatible render-texture
+/// is requested.
+///
+/// Usage example:
+/// \code
+/// sf::RenderTexturePool pool;
+/// pool.setGranularity(64);
+///
+/// // Get a render-texture at least 200x100 pixels big
+/// sf::RenderTexture* target = pool.acquire(200, 100);
+/// if (!target)
+///     return -1;
+///
+/// target->clear(sf::Color::Transparent);
+/// target->draw(...);
+/// target->display();
+///
+/// // Only use the part that was requested
+/// sf::Sprite sprite(target->getTexture(), sf::IntRect(0, 0, 200, 100));
+/// window.draw(sprite);
+///
+/// // Give it back to the pool so that it can be reused
+/// pool.release(target);
+/// \endcode
+///
+/// \see sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
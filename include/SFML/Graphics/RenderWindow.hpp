@@ -130,6 +130,21 @@ public:
     ////////////////////////////////////////////////////////////
     bool setActive(bool active = true);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Display on screen what has been rendered to the window so far
+    ///
+    /// This function is typically called after all OpenGL rendering
+    /// has been done for the current frame, in order to show
+    /// it on screen. It also ends the current profiling frame,
+    /// see sf::RenderTarget::setProfilingEnabled.
+    ///
+    /// \warning Like sf::Window::display, this function is not
+    /// virtual: call it on the sf::RenderWindow itself, not through
+    /// a reference to sf::Window, so that the frame is ended.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the current contents of the window to an image
     ///
@@ -693,6 +693,8 @@ public:
 
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -749,6 +751,7 @@ private:
     int          m_currentTexture; ///< Location of the current texture in the shader
     TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
     UniformTable m_uniforms;       ///< Parameters location cache
+    Uint64       m_cacheId;        ///< Unique number that identifies the shader to the render target's cache
 };
 
 } // namespace sf
@@ -870,6 +873,16 @@ private:
 /// sf::Shader::bind(NULL);
 /// \endcode
 ///
+/// Render targets whose context uses the core profile (see
+/// sf::ContextSettings::Core) don't provide the built-in inputs
+/// of the compatibility profile (gl_Vertex, gl_ModelViewMatrix, ...).
+/// Shaders used there receive the vertex components through the
+/// attributes \p sf_position (vec2), \p sf_color (vec4) and
+/// \p sf_texCoords (vec2), and the matrices through the optional
+/// uniforms \p sf_projectionMatrix, \p sf_modelViewMatrix and
+/// \p sf_textureMatrix (mat4). The \p sf_textureEnabled (bool)
+/// uniform tells whether a texture is bound.
+///
 /// \see sf::Glsl
 ///
 ////////////////////////////////////////////////////////////
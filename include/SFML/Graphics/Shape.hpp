@@ -262,6 +262,11 @@ protected:
     /// the shape's points change (i.e. the result of either
     /// getPointCount or getPoint is different).
     ///
+    /// The geometry is not recomputed right away, but the next
+    /// time it is needed (when the shape is drawn or its bounds
+    /// are requested), so calling this function several times
+    /// in a row is cheap.
+    ///
     ////////////////////////////////////////////////////////////
     void update();
 
@@ -276,44 +281,65 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the shape's geometry is updated
+    ///
+    /// All the attributes related to rendering are cached, such
+    /// that the geometry is only updated when necessary, and
+    /// only the parts that changed are recomputed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the whole geometry of the shape
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateGeometry() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateFillColors();
+    void updateFillColors() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the fill vertices' texture coordinates
     ///
     ////////////////////////////////////////////////////////////
-    void updateTexCoords();
+    void updateTexCoords() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' position
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutline();
+    void updateOutline() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Update the outline vertices' color
     ///
     ////////////////////////////////////////////////////////////
-    void updateOutlineColors();
+    void updateOutlineColors() const;
 
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    const Texture* m_texture;          ///< Texture of the shape
-    IntRect        m_textureRect;      ///< Rectangle defining the area of the source texture to display
-    Color          m_fillColor;        ///< Fill color
-    Color          m_outlineColor;     ///< Outline color
-    float          m_outlineThickness; ///< Thickness of the shape's outline
-    VertexArray    m_vertices;         ///< Vertex array containing the fill geometry
-    VertexArray    m_outlineVertices;  ///< Vertex array containing the outline geometry
-    FloatRect      m_insideBounds;     ///< Bounding rectangle of the inside (fill)
-    FloatRect      m_bounds;           ///< Bounding rectangle of the whole shape (outline + fill)
+    const Texture*      m_texture;                 ///< Texture of the shape
+    IntRect             m_textureRect;             ///< Rectangle defining the area of the source texture to display
+    Color               m_fillColor;               ///< Fill color
+    Color               m_outlineColor;            ///< Outline color
+    float               m_outlineThickness;        ///< Thickness of the shape's outline
+    mutable VertexArray m_vertices;                ///< Vertex array containing the fill geometry
+    mutable VertexArray m_outlineVertices;         ///< Vertex array containing the outline geometry
+    mutable FloatRect   m_insideBounds;            ///< Bounding rectangle of the inside (fill)
+    mutable FloatRect   m_bounds;                  ///< Bounding rectangle of the whole shape (outline + fill)
+    mutable bool        m_geometryNeedUpdate;      ///< Do the points need to be fetched again?
+    mutable bool        m_outlineNeedUpdate;       ///< Does the outline geometry need to be recomputed?
+    mutable bool        m_fillColorsNeedUpdate;    ///< Do the fill colors need to be updated?
+    mutable bool        m_texCoordsNeedUpdate;     ///< Do the texture coordinates need to be updated?
+    mutable bool        m_outlineColorsNeedUpdate; ///< Do the outline colors need to be updated?
 };
 
 } // namespace sf
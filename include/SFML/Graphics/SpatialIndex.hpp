@@ -0,0 +1,314 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SPATIALINDEX_HPP
+#define SFML_SPATIALINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Uniform grid of drawables, drawing only
+///        those that are visible
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SpatialIndex : public Drawable, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the index
+    ///
+    /// \a area is split into cells of \a cellSize. Objects
+    /// outside of \a area can be added as well, but they are
+    /// stored in the cells on its border, so they are found
+    /// less efficiently.
+    ///
+    /// \param area     Area covered by the grid, in world coordinates
+    /// \param cellSize Size of a cell of the grid, in world units
+    ///
+    ////////////////////////////////////////////////////////////
+    SpatialIndex(const FloatRect& area, const Vector2f& cellSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object that has global bounds to the index
+    ///
+    /// \a object must inherit sf::Drawable and have a
+    /// getGlobalBounds() function, like sf::Sprite, sf::Shape,
+    /// sf::Text or sf::TileMap. The bounds are read now and
+    /// every time update(unsigned int) is called. The object
+    /// must exist as long as the index uses it.
+    ///
+    /// \param object Object to add
+    ///
+    /// \return Identifier of the object in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    unsigned int add(const T& object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a drawable with explicit bounds to the index
+    ///
+    /// The drawable must exist as long as the index uses it.
+    ///
+    /// \param drawable Drawable to add
+    /// \param bounds   Global bounds of the drawable
+    ///
+    /// \return Identifier of the drawable in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int add(const Drawable& drawable, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read again the bounds of an object
+    ///
+    /// Call this function after moving, rotating, scaling or
+    /// otherwise changing the global bounds of an object added
+    /// with add(const T&). It does nothing for drawables added
+    /// with explicit bounds.
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the bounds of an object
+    ///
+    /// \param id     Identifier of the object
+    /// \param bounds New global bounds of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(unsigned int id, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove an object from the index
+    ///
+    /// The identifier may be reused by objects added later.
+    ///
+    /// \param id Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    void remove(unsigned int id);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the objects from the index
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the objects that intersect an area
+    ///
+    /// The objects are appended to \a result in the order in
+    /// which they were added to the index.
+    ///
+    /// \param area   Area to search, in world coordinates
+    /// \param result Array receiving the objects found
+    ///
+    /// \return Number of objects found
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t query(const FloatRect& area, std::vector<const Drawable*>& result) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of objects in the index
+    ///
+    /// \return Number of objects
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getObjectCount() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function returning the global bounds of an object
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef FloatRect (*BoundsGetter)(const void*);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounds of an object of a given type
+    ///
+    /// \param object Pointer to the object
+    ///
+    /// \return Global bounds of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    static FloatRect getObjectBounds(const void* object);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the objects visible through the view of a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object to the index
+    ///
+    /// \param drawable Drawable to add
+    /// \param object   Object to pass to \a getter, NULL if the bounds are explicit
+    /// \param getter   Function returning the bounds of \a object
+    /// \param bounds   Global bounds of the object
+    ///
+    /// \return Identifier of the object
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int insert(const Drawable& drawable, const void* object, BoundsGetter getter, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the range of cells that an area overlaps
+    ///
+    /// \param area Area, in world coordinates
+    ///
+    /// \return Range of cells, clamped to the grid
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getCells(const FloatRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an object to, or remove it from, a range of cells
+    ///
+    /// \param id     Identifier of the object
+    /// \param cells  Range of cells
+    /// \param insert True to add the object, false to remove it
+    ///
+    ////////////////////////////////////////////////////////////
+    void link(unsigned int id, const IntRect& cells, bool insert);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the identifiers of the objects that intersect an area
+    ///
+    /// The identifiers are stored in m_found, in the order in
+    /// which the objects were added.
+    ///
+    /// \param area Area to search, in world coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    void find(const FloatRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Object stored in the index
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Object
+    {
+        const Drawable* drawable; ///< Drawable to draw, NULL if the slot is free
+        const void*     source;   ///< Object passed to getter
+        BoundsGetter    getter;   ///< Function returning the bounds of the object, NULL if explicit
+        FloatRect       bounds;   ///< Global bounds of the object
+        IntRect         cells;    ///< Range of cells the object is linked to
+        Uint64          order;    ///< Rank of the object in the order of addition
+        mutable Uint64  stamp;    ///< Last search that found the object
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compare objects by order of addition
+    ///
+    ////////////////////////////////////////////////////////////
+    struct AdditionOrder;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    FloatRect                               m_area;      ///< Area covered by the grid
+    Vector2f                                m_cellSize;  ///< Size of a cell
+    Vector2i                                m_gridSize;  ///< Number of cells in each direction
+    std::vector<std::vector<unsigned int> > m_cells;     ///< Identifiers of the objects overlapping each cell, row by row
+    std::vector<Object>                     m_objects;   ///< Objects, indexed by identifier
+    std::vector<unsigned int>               m_freeIds;   ///< Identifiers of the free slots of m_objects
+    std::size_t                             m_count;     ///< Number of objects in the index
+    Uint64                                  m_nextOrder; ///< Rank of the next object added
+    mutable Uint64                          m_stamp;     ///< Identifier of the last search
+    mutable std::vector<unsigned int>       m_found;     ///< Result of the last search
+};
+
+#include <SFML/Graphics/SpatialIndex.inl>
+
+} // namespace sf
+
+
+#endif // SFML_SPATIALINDEX_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SpatialIndex
+/// \ingroup graphics
+///
+/// Render targets draw everything they are given, even the
+/// objects that end up outside the view. In large worlds,
+/// where only a small part is visible at once, submitting
+/// every object each frame makes the cost of drawing grow
+/// with the size of the world rather than with what is on
+/// screen.
+///
+/// sf::SpatialIndex keeps track of where the objects are:
+/// the world is divided into a uniform grid of cells, and
+/// each object is linked to the cells its global bounds
+/// overlap. When the index is drawn, only the cells that
+/// intersect the view of the target are looked at, and only
+/// the objects whose bounds intersect the view are drawn, in
+/// the order in which they were added to the index.
+///
+/// The index doesn't watch the objects: when an object moves,
+/// its bounds must be refreshed with update(). Choose a cell
+/// size close to the size of the typical object; much smaller
+/// cells link each object to many cells, much bigger ones make
+/// each cell hold many objects.
+///
+/// Usage example:
+/// \code
+/// sf::SpatialIndex index(sf::FloatRect(0, 0, 100000, 100000), sf::Vector2f(256, 256));
+///
+/// std::vector<unsigned int> ids;
+/// for (std::size_t i = 0; i < trees.size(); ++i)
+///     ids.push_back(index.add(trees[i]));
+///
+/// // When a tree moves
+/// trees[i].move(10, 0);
+/// index.update(ids[i]);
+///
+/// window.draw(index);
+/// \endcode
+///
+/// \see sf::Drawable, sf::View
+///
+////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 
 namespace sf
 {
+class GpuFence;
 class InputStream;
 class RenderTarget;
 class RenderTexture;
@@ -588,6 +589,7 @@ private:
     friend class Text;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class RenderImage;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -613,19 +615,53 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the texture matrix to use when binding the texture
+    ///
+    /// The matrix converts pixel coordinates to normalized ones
+    /// if needed, and flips the Y axis if the pixels are flipped.
+    ///
+    /// \param coordinateType Type of texture coordinates to use
+    /// \param matrix         Array of 16 floats receiving the matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void computeMatrix(CoordinateType coordinateType, float* matrix) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make an update of the texture visible to the other contexts
+    ///
+    /// Must be called in the updating context, after the update.
+    /// A fence is inserted unless the texture is only drawn in
+    /// the updating context; the contexts drawing the texture
+    /// then wait for it (see waitForUpdate).
+    ///
+    ////////////////////////////////////////////////////////////
+    void signalUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare the texture to be drawn in the active context
+    ///
+    /// The active context waits for the last update made in
+    /// another context, if it is not complete yet.
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitForUpdate() const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          ///< Public texture size
-    Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       ///< Internal texture identifier
-    bool         m_isSmooth;      ///< Status of the smooth filter
-    bool         m_sRgb;          ///< Should the texture source be converted from sRGB?
-    bool         m_isRepeated;    ///< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
-    bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
-    bool         m_hasMipmap;     ///< Has the mipmap been generated?
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Vector2u       m_size;          ///< Public texture size
+    Vector2u       m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
+    unsigned int   m_texture;       ///< Internal texture identifier
+    bool           m_isSmooth;      ///< Status of the smooth filter
+    bool           m_sRgb;          ///< Should the texture source be converted from sRGB?
+    bool           m_isRepeated;    ///< Is the texture in repeat mode?
+    mutable bool   m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
+    bool           m_fboAttachment; ///< Is this texture owned by a framebuffer object?
+    bool           m_hasMipmap;     ///< Has the mipmap been generated?
+    Uint64         m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    GpuFence*      m_fence;         ///< Fence signaled when the last update made in another context is complete
+    mutable Uint64 m_contextId;     ///< Identifier of the context drawing the texture (0 if none, all bits set if several)
 };
 
 } // namespace sf
@@ -0,0 +1,312 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/IndexBuffer.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+class View;
+
+////////////////////////////////////////////////////////////
+/// \brief Large grid of tiles taken from a tileset texture,
+///        stored in graphics memory and drawn by chunks
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tile value of cells that are not drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    static const Uint32 EmptyTile;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty tile map with no tileset texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the tile map
+    ///
+    /// All the tiles are set to sf::TileMap::EmptyTile. The map
+    /// is split into square chunks of \a chunkSize x \a chunkSize
+    /// tiles: chunks are culled and updated as a whole, and each
+    /// one is a single draw call. The chunk size is limited to
+    /// 128 tiles, so that 16-bit indices can address the vertices
+    /// of a chunk.
+    ///
+    /// \param size      Size of the map, in tiles
+    /// \param tileSize  Size of a tile, in pixels
+    /// \param chunkSize Size of the side of a chunk, in tiles
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(const Vector2u& size, const Vector2u& tileSize, unsigned int chunkSize = 64);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the tileset texture of the map
+    ///
+    /// The texture is cut into cells of the size of a tile,
+    /// numbered from left to right and top to bottom starting
+    /// at 0. The \a texture argument refers to a texture that
+    /// must exist as long as the tile map uses it.
+    ///
+    /// \param texture New tileset texture
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the tileset texture of the map
+    ///
+    /// \return Pointer to the tileset texture, NULL if none is set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile of the map
+    ///
+    /// Only the chunk containing the tile is rebuilt, the next
+    /// time it is drawn. This function does nothing if the
+    /// coordinates are out of the map.
+    ///
+    /// \param x    Column of the tile
+    /// \param y    Row of the tile
+    /// \param tile Index of the tileset cell to display, or sf::TileMap::EmptyTile
+    ///
+    /// \see getTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int x, unsigned int y, Uint32 tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles of the map at once
+    ///
+    /// \param tiles Array of getSize().x * getSize().y tile indices, row by row
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(const Uint32* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile of the map
+    ///
+    /// \param x Column of the tile
+    /// \param y Row of the tile
+    ///
+    /// \return Index of the tileset cell displayed by the tile,
+    ///         sf::TileMap::EmptyTile if empty or out of the map
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getTile(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the map
+    ///
+    /// \return Size of the map, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in local coordinates, which means
+    /// that it ignores the transformations (translation, rotation,
+    /// scale, ...) that are applied to the entity.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// The returned rectangle is in global coordinates, which means
+    /// that it takes into account the transformations (translation,
+    /// rotation, scale, ...) that are applied to the entity.
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks of the map to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the range of chunks visible through a view
+    ///
+    /// \param view      View to cull against
+    /// \param transform Transform from the map to the world
+    ///
+    /// \return Rectangle of visible chunks, in chunk coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    IntRect getVisibleChunks(const View& view, const Transform& transform) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the geometry of a chunk
+    ///
+    /// \param x Column of the chunk
+    /// \param y Row of the chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChunk(unsigned int x, unsigned int y) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark all the chunks as needing to be rebuilt
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateChunks() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a square area of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        Chunk();
+
+        VertexBuffer        vertexBuffer; ///< Vertices of the non-empty tiles, in graphics memory
+        std::vector<Vertex> vertices;     ///< Vertices of the non-empty tiles, used when vertex buffers are unavailable
+        std::size_t         tileCount;    ///< Number of non-empty tiles
+        bool                needUpdate;   ///< Do the vertices need to be rebuilt?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                   m_size;             ///< Size of the map, in tiles
+    Vector2u                   m_tileSize;         ///< Size of a tile, in pixels
+    unsigned int               m_chunkSize;        ///< Size of the side of a chunk, in tiles
+    Vector2u                   m_chunkCount;       ///< Number of chunks in each direction
+    const Texture*             m_texture;          ///< Tileset texture
+    mutable unsigned int       m_tilesPerRow;      ///< Number of tiles in a row of the tileset, when the chunks were built
+    std::vector<Uint32>        m_tiles;            ///< Tile indices, row by row
+    mutable std::vector<Chunk> m_chunks;           ///< Chunks of the map, row by row
+    IndexBuffer                m_indexBuffer;      ///< Indices shared by all the chunks, two triangles per tile
+    std::vector<Uint16>        m_indices;          ///< Indices shared by all the chunks, used when vertex buffers are unavailable
+    bool                       m_useVertexBuffers; ///< Are the chunks stored in graphics memory?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap draws a grid of tiles, all the same size,
+/// whose images are taken from a single tileset texture.
+/// It is designed for maps far larger than the screen:
+///
+/// \li the map is split into square chunks, whose vertices
+///     are stored in graphics memory (sf::VertexBuffer with
+///     the sf::VertexBuffer::Static usage) and shared indices
+///     (sf::IndexBuffer), so drawing a chunk doesn't transfer
+///     any vertex data
+/// \li only the chunks that intersect the view of the render
+///     target are drawn
+/// \li changing a tile only rebuilds the chunk that contains it,
+///     the next time that chunk is visible
+///
+/// The size of the chunks is a trade-off: bigger chunks mean
+/// less draw calls, smaller chunks mean less tiles drawn
+/// outside the view and cheaper updates.
+///
+/// Like other entities, sf::TileMap can be transformed. Culling
+/// takes the transformations of the map and of the view into
+/// account.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// tileset.loadFromFile("tileset.png");
+///
+/// sf::TileMap map;
+/// map.create(sf::Vector2u(4096, 4096), sf::Vector2u(32, 32));
+/// map.setTexture(tileset);
+/// map.setTiles(level.data());
+///
+/// // Later, when the player digs a hole
+/// map.setTile(x, y, holeTile);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::IndexBuffer, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 
 namespace sf
 {
+class GpuFence;
 class RenderTarget;
 class Vertex;
 
@@ -320,6 +321,8 @@ public:
 
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the vertex buffer to a render target
     ///
@@ -329,15 +332,38 @@ private:
     ////////////////////////////////////////////////////////////
     virtual void draw(RenderTarget& target, RenderStates states) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Make an update of the buffer visible to the other contexts
+    ///
+    /// Must be called in the updating context, after the update.
+    /// A fence is inserted unless the buffer is only drawn in
+    /// the updating context; the contexts drawing the buffer
+    /// then wait for it (see waitForUpdate).
+    ///
+    ////////////////////////////////////////////////////////////
+    void signalUpdate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Prepare the buffer to be drawn in the active context
+    ///
+    /// The active context waits for the last update made in
+    /// another context, if it is not complete yet.
+    ///
+    ////////////////////////////////////////////////////////////
+    void waitForUpdate() const;
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int  m_buffer;        ///< Internal buffer identifier
-    std::size_t   m_size;          ///< Size in Vertexes of the currently allocated buffer
-    PrimitiveType m_primitiveType; ///< Type of primitives to draw
-    Usage         m_usage;         ///< How this vertex buffer is to be used
+    unsigned int   m_buffer;        ///< Internal buffer identifier
+    std::size_t    m_size;          ///< Size in Vertexes of the currently allocated buffer
+    PrimitiveType  m_primitiveType; ///< Type of primitives to draw
+    Usage          m_usage;         ///< How this vertex buffer is to be used
+    Uint64         m_cacheId;       ///< Unique number that identifies the vertex buffer to the render target's cache
+    GpuFence*      m_fence;         ///< Fence signaled when the last update made in another context is complete
+    mutable Uint64 m_contextId;     ///< Identifier of the context drawing the buffer (0 if none, all bits set if several)
 };
 
 } // namespace sf
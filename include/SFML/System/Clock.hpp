@@ -73,6 +73,54 @@ public:
     ////////////////////////////////////////////////////////////
     Time restart();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the current time on the monotonic timeline
+    ///
+    /// The origin of the timeline is unspecified (it usually
+    /// is the boot time of the system), only the differences
+    /// between two values are meaningful. This is the timeline
+    /// of the deadlines of sf::sleepUntil and sf::spinUntil.
+    ///
+    /// \return Current time
+    ///
+    ////////////////////////////////////////////////////////////
+    static Time now();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read the raw high-resolution tick counter
+    ///
+    /// This function is meant for measurements that are too
+    /// frequent or too short for getElapsedTime(), like
+    /// instrumenting inner loops: it returns an uninterpreted
+    /// counter, as cheaply as possible. On x86 processors with
+    /// an invariant time-stamp counter, it reads the counter
+    /// directly, without a system call; otherwise it falls back
+    /// to the system clock, in microseconds.
+    ///
+    /// Divide a difference of ticks by getTickFrequency() to
+    /// convert it to seconds.
+    ///
+    /// \return Current value of the tick counter
+    ///
+    /// \see getTickFrequency
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTicks();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the frequency of the raw tick counter
+    ///
+    /// When the time-stamp counter is used, its frequency is
+    /// calibrated against the system clock during the first
+    /// call, which then takes about ten milliseconds.
+    ///
+    /// \return Number of ticks per second
+    ///
+    /// \see getTicks
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getTickFrequency();
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -112,6 +160,19 @@ private:
 /// converted to a number of seconds, milliseconds or even
 /// microseconds.
 ///
+/// The static functions give access to the underlying timers:
+/// now() returns the current time on the monotonic timeline
+/// used for the deadlines of sf::sleepUntil and sf::spinUntil,
+/// and getTicks() reads the cheapest high-resolution counter
+/// available, for fine-grained measurements:
+/// \code
+/// sf::Uint64 start = sf::Clock::getTicks();
+/// ...
+/// sf::Uint64 ticks = sf::Clock::getTicks() - start;
+///
+/// double seconds = static_cast<double>(ticks) / sf::Clock::getTickFrequency();
+/// \endcode
+///
 /// \see sf::Time
 ///
 ////////////////////////////////////////////////////////////
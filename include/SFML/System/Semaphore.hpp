@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SEMAPHORE_HPP
+#define SFML_SEMAPHORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+    class SemaphoreImpl;
+}
+
+////////////////////////////////////////////////////////////
+/// \brief Counter that threads can wait on until another
+///        thread signals it
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API Semaphore : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// \param count Initial value of the counter
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Semaphore(unsigned int count = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~Semaphore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Increment the counter
+    ///
+    /// If threads are blocked in wait(), one of them is
+    /// woken up and decrements the counter again.
+    ///
+    /// \see wait
+    ///
+    ////////////////////////////////////////////////////////////
+    void post();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the counter is positive, then decrement it
+    ///
+    /// \see post
+    ///
+    ////////////////////////////////////////////////////////////
+    void wait();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the counter is positive, then decrement it,
+    ///        or until a timeout expires
+    ///
+    /// A zero or negative timeout only checks the counter,
+    /// without blocking.
+    ///
+    /// \param timeout Maximum time to wait
+    ///
+    /// \return True if the counter was decremented, false if the timeout expired
+    ///
+    /// \see post
+    ///
+    ////////////////////////////////////////////////////////////
+    bool wait(Time timeout);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    priv::SemaphoreImpl* m_semaphoreImpl; ///< OS-specific implementation
+};
+
+} // namespace sf
+
+
+#endif // SFML_SEMAPHORE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::Semaphore
+/// \ingroup system
+///
+/// A semaphore is a synchronization object holding a counter.
+/// post() increments it, and wait() blocks the calling thread
+/// until the counter is positive, then decrements it.
+///
+/// It is typically used to hand work over to other threads:
+/// the producer posts the semaphore once per task it adds to
+/// a queue (protected by a sf::Mutex), and the consumers wait
+/// on it before taking a task from the queue. Contrary to a
+/// loop that checks the queue and sleeps, the consumers wake up
+/// as soon as there is something to do, and don't consume any
+/// CPU time otherwise.
+///
+/// The timed version of wait() makes it possible to wait for
+/// either a signal or a deadline, whichever comes first.
+///
+/// sf::Semaphore is a general-purpose primitive, like sf::Mutex:
+/// SFML uses it internally (the worker threads of the audio
+/// module wait on semaphores), but it is part of the public
+/// API and can be used freely by applications. Timeouts are
+/// measured on a monotonic clock where the system supports it,
+/// so changing the system time doesn't shorten or extend them.
+///
+/// Usage example:
+/// \code
+/// std::queue<Task> tasks;
+/// sf::Mutex mutex;
+/// sf::Semaphore semaphore;
+///
+/// void producer()
+/// {
+///     {
+///         sf::Lock lock(mutex);
+///         tasks.push(Task(...));
+///     }
+///     semaphore.post();
+/// }
+///
+/// void consumer()
+/// {
+///     for (;;)
+///     {
+///         semaphore.wait();
+///
+///         sf::Lock lock(mutex);
+///         Task task = tasks.front();
+///         tasks.pop();
+///         ...
+///     }
+/// }
+/// \endcode
+///
+/// \see sf::Mutex, sf::Lock, sf::Thread
+///
+////////////////////////////////////////////////////////////
@@ -46,6 +46,50 @@ namespace sf
 ////////////////////////////////////////////////////////////
 void SFML_SYSTEM_API sleep(Time duration);
 
+////////////////////////////////////////////////////////////
+/// \ingroup system
+/// \brief Make the current thread sleep until a given time
+///
+/// The deadline is an absolute time on the timeline of
+/// sf::Clock::now. Contrary to calling sf::sleep with the
+/// remaining time, the wait is not lengthened if the thread
+/// is preempted before it starts sleeping, which makes this
+/// function suited to periodic tasks: scheduling each
+/// iteration at a fixed deadline prevents the errors from
+/// accumulating.
+///
+/// The function returns immediately if the deadline has
+/// already passed. Like sf::sleep, it may return a little
+/// after the deadline, depending on the OS scheduler
+/// (see sf::spinUntil for a more precise wait).
+///
+/// \param deadline Time to wake up at, as returned by sf::Clock::now
+///
+////////////////////////////////////////////////////////////
+void SFML_SYSTEM_API sleepUntil(Time deadline);
+
+////////////////////////////////////////////////////////////
+/// \ingroup system
+/// \brief Block the current thread until a given time, precisely
+///
+/// The thread sleeps until shortly before the deadline, then
+/// actively waits (spins) until the deadline is reached. The
+/// spinning margin is calibrated from how late the OS wakes
+/// sleeping threads up: it grows as soon as a wake-up is late
+/// and slowly shrinks otherwise, so that the CPU time spent
+/// spinning stays as small as the system allows (typically a
+/// fraction of a millisecond).
+///
+/// This function returns much closer to the deadline than
+/// sf::sleepUntil, at the cost of some CPU time. It should be
+/// reserved to waits whose precision matters, like frame or
+/// audio buffer deadlines.
+///
+/// \param deadline Time to return at, as returned by sf::Clock::now
+///
+////////////////////////////////////////////////////////////
+void SFML_SYSTEM_API spinUntil(Time deadline);
+
 } // namespace sf
 
 
@@ -132,6 +132,25 @@ public:
     ////////////////////////////////////////////////////////////
     static Uint64 getActiveContextId();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create contexts in advance for the threads loading resources
+    ///
+    /// Threads that create or update OpenGL resources (textures,
+    /// shaders, ...) without an active context borrow one from
+    /// a pool for the duration of the operation. The pool grows
+    /// on demand; this function fills it in advance, so that
+    /// worker threads never have to create a context.
+    ///
+    /// The pool only exists while at least one OpenGL resource
+    /// (a window, a texture, ...) is alive, this function does
+    /// nothing otherwise.
+    ///
+    /// \param count Number of contexts to keep ready, typically
+    ///              the number of loading threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static void reserveTransientContexts(unsigned int count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
@@ -178,6 +197,25 @@ private:
 /// will take care of deactivating and freeing all the attached
 /// resources.
 ///
+/// On Linux and BSD, contexts can also be created without
+/// any display server, for example on render servers or in
+/// continuous integration: they then use EGL (preferably on
+/// Mesa's surfaceless platform) instead of GLX, and render
+/// off-screen. This headless backend is selected when the
+/// DISPLAY environment variable is not set, or when the
+/// SFML_HEADLESS environment variable is set to anything
+/// but 0 (setting it to 0 forces GLX). It is enough to use
+/// sf::RenderTexture, sf::Texture and sf::Shader, but not
+/// to open windows.
+///
+/// Threads that load resources without a context of their
+/// own (for example to stream assets in the background) don't
+/// need a sf::Context: SFML lends them a context from a pool
+/// while they create or update a resource, and waits for the
+/// graphics driver to complete the operation before returning,
+/// so that the resource can be used right away by the other
+/// threads. See reserveTransientContexts.
+///
 /// Usage example:
 /// \code
 /// void threadFunction(void*)
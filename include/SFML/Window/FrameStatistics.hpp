@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FRAMESTATISTICS_HPP
+#define SFML_FRAMESTATISTICS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Export.hpp>
+#include <SFML/System/Time.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Frame timing statistics gathered by a window
+///
+////////////////////////////////////////////////////////////
+struct SFML_WINDOW_API FrameStatistics
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Sets all the statistics to zero.
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameStatistics();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Uint64 frameCount;      ///< Number of frames displayed since the statistics were reset
+    Uint64 missedDeadlines; ///< Number of frames that ended after their deadline since the statistics were reset
+    Time   meanFrameTime;   ///< Mean duration of the recent frames
+    Time   p99FrameTime;    ///< 99th percentile of the duration of the recent frames
+    Time   maxFrameTime;    ///< Longest duration of the recent frames
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMESTATISTICS_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameStatistics
+/// \ingroup window
+///
+/// sf::FrameStatistics describes how regularly the frames of
+/// a sf::Window are displayed. The duration of a frame is
+/// the time elapsed between two calls to sf::Window::display,
+/// including the time spent waiting to honor the framerate
+/// limit.
+///
+/// The durations (mean, 99th percentile and maximum) are
+/// computed over the most recent frames (a few seconds worth
+/// of frames at usual framerates), so that they reflect the
+/// current behavior of the application. The counters
+/// accumulate until sf::Window::resetFrameStatistics is called.
+///
+/// A deadline is missed when display() is called after the
+/// time at which the frame should have been shown according
+/// to the framerate limit; deadlines are only counted when
+/// a limit is set.
+///
+/// Usage example:
+/// \code
+/// window.setFramerateLimit(144);
+/// window.setPreciseFramePacingEnabled(true);
+///
+/// ...
+///
+/// sf::FrameStatistics stats = window.getFrameStatistics();
+/// std::cout << "mean: " << stats.meanFrameTime.asMicroseconds() << " us, "
+///           << "p99: " << stats.p99FrameTime.asMicroseconds() << " us, "
+///           << "missed: " << stats.missedDeadlines << std::endl;
+/// \endcode
+///
+/// \see sf::Window::getFrameStatistics
+///
+////////////////////////////////////////////////////////////
@@ -31,6 +31,7 @@
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/Window/Cursor.hpp>
 #include <SFML/Window/Export.hpp>
+#include <SFML/Window/FrameStatistics.hpp>
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/Window/VideoMode.hpp>
 #include <SFML/Window/WindowHandle.hpp>
@@ -45,6 +46,7 @@ namespace sf
 {
 namespace priv
 {
+    class FramePacer;
     class GlContext;
     class WindowImpl;
 }
@@ -401,17 +403,59 @@ public:
     /// If a limit is set, the window will use a small delay after
     /// each call to display() to ensure that the current frame
     /// lasted long enough to match the framerate limit.
-    /// SFML will try to match the given limit as much as it can,
-    /// but since it internally uses sf::sleep, whose precision
-    /// depends on the underlying OS, the results may be a little
-    /// unprecise as well (for example, you can get 65 FPS when
-    /// requesting 60).
+    /// The frames are scheduled at regular deadlines, so that
+    /// the average framerate matches the limit even though each
+    /// delay may be a little too long: by default the delay
+    /// relies on sf::sleep, whose precision depends on the
+    /// underlying OS (see setPreciseFramePacingEnabled to make
+    /// each frame's duration accurate as well).
     ///
     /// \param limit Framerate limit, in frames per seconds (use 0 to disable limit)
     ///
+    /// \see setPreciseFramePacingEnabled, getFrameStatistics
+    ///
     ////////////////////////////////////////////////////////////
     void setFramerateLimit(unsigned int limit);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable precise frame pacing
+    ///
+    /// When precise pacing is enabled, display() sleeps until
+    /// shortly before the end of the frame, then actively waits
+    /// (spins) until the exact deadline set by the framerate
+    /// limit. This removes the judder caused by the imprecision
+    /// of sf::sleep, at the cost of some CPU time (the spinning
+    /// duration adapts to the precision of the OS scheduler,
+    /// usually a fraction of a millisecond, see sf::spinUntil).
+    ///
+    /// This setting has no effect if no framerate limit is set.
+    /// Precise pacing is disabled by default.
+    ///
+    /// \param enabled True to enable, false to disable
+    ///
+    /// \see setFramerateLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPreciseFramePacingEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the timing statistics of the displayed frames
+    ///
+    /// \return Statistics of the recent frames
+    ///
+    /// \see resetFrameStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameStatistics getFrameStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the frame counters of the statistics
+    ///
+    /// \see getFrameStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetFrameStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the joystick threshold
     ///
@@ -542,11 +586,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    priv::WindowImpl* m_impl;           ///< Platform-specific implementation of the window
-    priv::GlContext*  m_context;        ///< Platform-specific implementation of the OpenGL context
-    Clock             m_clock;          ///< Clock for measuring the elapsed time between frames
-    Time              m_frameTimeLimit; ///< Current framerate limit
-    Vector2u          m_size;           ///< Current size of the window
+    priv::WindowImpl* m_impl;       ///< Platform-specific implementation of the window
+    priv::GlContext*  m_context;    ///< Platform-specific implementation of the OpenGL context
+    priv::FramePacer* m_framePacer; ///< Framerate limiter, measures the duration of the frames
+    Vector2u          m_size;       ///< Current size of the window
 };
 
 } // namespace sf
@@ -26,9 +26,11 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/VoiceManager.hpp>
 #include <SFML/Audio/ALCheck.hpp>
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
 #include <memory>
 
 
@@ -150,6 +152,41 @@ int AudioDevice::getFormatFromChannelCount(unsigned int channelCount)
 }
 
 
+////////////////////////////////////////////////////////////
+int AudioDevice::getFloatFormatFromChannelCount(unsigned int channelCount)
+{
+    // Create a temporary audio device in case none exists yet.
+    // This device will not be used in this function and merely
+    // makes sure there is a valid OpenAL device for format
+    // queries if none has been created yet.
+    std::auto_ptr<AudioDevice> device;
+    if (!audioDevice)
+        device.reset(new AudioDevice);
+
+    if (!alIsExtensionPresent("AL_EXT_float32"))
+        return 0;
+
+    // Find the good format according to the number of channels
+    int format = 0;
+    switch (channelCount)
+    {
+        case 1:  format = alGetEnumValue("AL_FORMAT_MONO_FLOAT32");   break;
+        case 2:  format = alGetEnumValue("AL_FORMAT_STEREO_FLOAT32"); break;
+        case 4:  format = alGetEnumValue("AL_FORMAT_QUAD32");         break;
+        case 6:  format = alGetEnumValue("AL_FORMAT_51CHN32");        break;
+        case 7:  format = alGetEnumValue("AL_FORMAT_61CHN32");        break;
+        case 8:  format = alGetEnumValue("AL_FORMAT_71CHN32");        break;
+        default: format = 0;                                          break;
+    }
+
+    // Fixes a bug on OS X
+    if (format == -1)
+        format = 0;
+
+    return format;
+}
+
+
 ////////////////////////////////////////////////////////////
 void AudioDevice::setGlobalVolume(float volume)
 {
@@ -170,6 +207,9 @@ float AudioDevice::getGlobalVolume()
 ////////////////////////////////////////////////////////////
 void AudioDevice::setPosition(const Vector3f& position)
 {
+    // The voice manager reads the position from its own thread
+    Lock lock(VoiceManager::getMutex());
+
     if (audioContext)
         alCheck(alListener3f(AL_POSITION, position.x, position.y, position.z));
 
@@ -180,6 +220,8 @@ void AudioDevice::setPosition(const Vector3f& position)
 ////////////////////////////////////////////////////////////
 Vector3f AudioDevice::getPosition()
 {
+    Lock lock(VoiceManager::getMutex());
+
     return listenerPosition;
 }
 
@@ -83,6 +83,20 @@ public:
     ////////////////////////////////////////////////////////////
     static int getFormatFromChannelCount(unsigned int channelCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the OpenAL format of floating point samples that matches the given number of channels
+    ///
+    /// Floating point formats require the AL_EXT_float32
+    /// extension (and AL_EXT_MCFORMATS for more than
+    /// two channels).
+    ///
+    /// \param channelCount Number of channels
+    ///
+    /// \return Corresponding format, or 0 if it is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    static int getFloatFormatFromChannelCount(unsigned int channelCount);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the global volume of all the sounds and musics
     ///
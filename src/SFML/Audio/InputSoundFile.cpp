@@ -253,6 +253,17 @@ Uint64 InputSoundFile::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 InputSoundFile::read(float* samples, Uint64 maxCount)
+{
+    Uint64 readSamples = 0;
+    if (m_reader && samples && maxCount)
+        readSamples = m_reader->read(samples, maxCount);
+    m_sampleOffset += readSamples;
+    return readSamples;
+}
+
+
 ////////////////////////////////////////////////////////////
 void InputSoundFile::close()
 {
@@ -27,8 +27,10 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <fstream>
 
 
@@ -36,8 +38,9 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Music::Music() :
-m_file      (),
-m_loopSpan  (0, 0)
+m_file           (),
+m_useFloatSamples(false),
+m_loopSpan       (0, 0)
 {
 
 }
@@ -180,7 +183,11 @@ bool Music::onGetData(SoundStream::Chunk& data)
 {
     Lock lock(m_mutex);
 
-    std::size_t toFill = m_samples.size();
+    // Resize the internal buffer so that it can contain one buffer duration of audio samples
+    Uint64 frameCount = static_cast<Uint64>(getBufferDuration().asMicroseconds()) * m_file.getSampleRate() / 1000000;
+    std::size_t bufferSize = static_cast<std::size_t>(std::max(frameCount, static_cast<Uint64>(1))) * m_file.getChannelCount();
+
+    std::size_t toFill = bufferSize;
     Uint64 currentOffset = m_file.getSampleOffset();
     Uint64 loopEnd = m_loopSpan.offset + m_loopSpan.length;
 
@@ -191,8 +198,23 @@ bool Music::onGetData(SoundStream::Chunk& data)
         toFill = static_cast<std::size_t>(loopEnd - currentOffset);
 
     // Fill the chunk parameters
-    data.samples = &m_samples[0];
-    data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], toFill));
+    if (m_useFloatSamples)
+    {
+        if (m_floatSamples.size() != bufferSize)
+            m_floatSamples.resize(bufferSize);
+
+        data.floatSamples = &m_floatSamples[0];
+        data.sampleCount = static_cast<std::size_t>(m_file.read(&m_floatSamples[0], toFill));
+    }
+    else
+    {
+        if (m_samples.size() != bufferSize)
+            m_samples.resize(bufferSize);
+
+        data.samples = &m_samples[0];
+        data.sampleCount = static_cast<std::size_t>(m_file.read(&m_samples[0], toFill));
+    }
+
     currentOffset += data.sampleCount;
 
     // Check if we have stopped obtaining samples or reached either the EOF or the loop end point
@@ -238,8 +260,9 @@ void Music::initialize()
     m_loopSpan.offset = 0;
     m_loopSpan.length = m_file.getSampleCount();
 
-    // Resize the internal buffer so that it can contain 1 second of audio samples
-    m_samples.resize(m_file.getSampleRate() * m_file.getChannelCount());
+    // Stream floating point samples if they can be played without
+    // conversion, to avoid quantizing the decoded samples
+    m_useFloatSamples = (priv::AudioDevice::getFloatFormatFromChannelCount(m_file.getChannelCount()) != 0);
 
     // Initialize the stream
     SoundStream::initialize(m_file.getChannelCount(), m_file.getSampleRate());
@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SampleCache.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <map>
+
+
+namespace
+{
+    // Decoded samples of a sound file
+    struct Entry
+    {
+        std::vector<sf::Int16> samples;
+        unsigned int           channelCount;
+        unsigned int           sampleRate;
+        sf::Uint64             lastUse;
+    };
+
+    // Sound file being decoded by a thread, and waited for by others
+    struct Pending
+    {
+        sf::Semaphore ready;
+        unsigned int  waiters;
+    };
+
+    typedef std::map<sf::priv::SampleCache::Key, Entry> EntryMap;
+    typedef std::map<sf::priv::SampleCache::Key, Pending*> PendingMap;
+
+    // The cache and its mutex
+    sf::Mutex mutex;
+    EntryMap entries;
+    PendingMap pendings;
+
+    // Capacity of the cache and memory currently used, in bytes; the
+    // cache is disabled by default, since identifying a file requires
+    // reading it entirely and its samples are then kept twice
+    sf::Uint64 capacity = 0;
+    sf::Uint64 size = 0;
+
+    // Counter used to find the least recently used entries
+    sf::Uint64 useCounter = 0;
+
+    // Remove the least recently used entries until the cache fits in the given size
+    void shrink(sf::Uint64 maxSize)
+    {
+        while (size > maxSize)
+        {
+            EntryMap::iterator oldest = entries.begin();
+            for (EntryMap::iterator it = entries.begin(); it != entries.end(); ++it)
+            {
+                if (it->second.lastUse < oldest->second.lastUse)
+                    oldest = it;
+            }
+
+            size -= oldest->second.samples.size() * sizeof(sf::Int16);
+            entries.erase(oldest);
+        }
+    }
+
+    // Wake up the threads waiting for a sound file to be decoded
+    // (the mutex must be locked)
+    void release(const sf::priv::SampleCache::Key& key)
+    {
+        PendingMap::iterator it = pendings.find(key);
+        if (it == pendings.end())
+            return;
+
+        Pending* pending = it->second;
+        pendings.erase(it);
+
+        // The last waiter deletes the pending entry
+        if (pending->waiters == 0)
+        {
+            delete pending;
+        }
+        else
+        {
+            for (unsigned int i = 0; i < pending->waiters; ++i)
+                pending->ready.post();
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool SampleCache::Key::operator <(const Key& right) const
+{
+    if (hash != right.hash)
+        return hash < right.hash;
+
+    return size < right.size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SampleCache::computeKey(InputStream& stream, Key& key)
+{
+    Int64 position = stream.tell();
+    if ((position == -1) || (stream.seek(0) == -1))
+        return false;
+
+    // 64-bit FNV-1a hash of the contents of the stream
+    key.hash = 14695981039346656037ULL;
+    key.size = 0;
+
+    char buffer[4096];
+    Int64 count = 0;
+    while ((count = stream.read(buffer, sizeof(buffer))) > 0)
+    {
+        for (Int64 i = 0; i < count; ++i)
+        {
+            key.hash ^= static_cast<unsigned char>(buffer[i]);
+            key.hash *= 1099511628211ULL;
+        }
+
+        key.size += count;
+    }
+
+    return (count == 0) && (stream.seek(position) == position);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SampleCache::find(const Key& key, std::vector<Int16>& samples, unsigned int& channelCount, unsigned int& sampleRate)
+{
+    mutex.lock();
+
+    for (;;)
+    {
+        EntryMap::iterator it = entries.find(key);
+        if (it != entries.end())
+        {
+            it->second.lastUse = ++useCounter;
+
+            samples = it->second.samples;
+            channelCount = it->second.channelCount;
+            sampleRate = it->second.sampleRate;
+
+            mutex.unlock();
+            return true;
+        }
+
+        // Nobody is decoding this file: let the caller do it
+        PendingMap::iterator pendingIt = pendings.find(key);
+        if (pendingIt == pendings.end())
+        {
+            Pending* pending = new Pending;
+            pending->waiters = 0;
+            pendings.insert(std::make_pair(key, pending));
+
+            mutex.unlock();
+            return false;
+        }
+
+        // Another thread is decoding it: wait, then look again
+        Pending* pending = pendingIt->second;
+        pending->waiters++;
+
+        mutex.unlock();
+        pending->ready.wait();
+        mutex.lock();
+
+        if (--pending->waiters == 0)
+            delete pending;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SampleCache::insert(const Key& key, const std::vector<Int16>& samples, unsigned int channelCount, unsigned int sampleRate)
+{
+    Lock lock(mutex);
+
+    release(key);
+
+    Uint64 entrySize = samples.size() * sizeof(Int16);
+    if ((entrySize > capacity) || (entries.find(key) != entries.end()))
+        return;
+
+    // Make room for the new entry
+    shrink(capacity - entrySize);
+
+    Entry& entry = entries[key];
+    entry.samples = samples;
+    entry.channelCount = channelCount;
+    entry.sampleRate = sampleRate;
+    entry.lastUse = ++useCounter;
+
+    size += entrySize;
+}
+
+
+////////////////////////////////////////////////////////////
+void SampleCache::abandon(const Key& key)
+{
+    Lock lock(mutex);
+
+    release(key);
+}
+
+
+////////////////////////////////////////////////////////////
+void SampleCache::setCapacity(Uint64 newCapacity)
+{
+    Lock lock(mutex);
+
+    capacity = newCapacity;
+    shrink(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SampleCache::getCapacity()
+{
+    Lock lock(mutex);
+
+    return capacity;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SAMPLECACHE_HPP
+#define SFML_SAMPLECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Global cache of decoded audio samples, indexed by
+///        the contents of the sound files they come from
+///
+/// Loading the same sound file several times (or several
+/// files with identical contents) decodes it only once, as
+/// long as its samples are kept in the cache. The least
+/// recently used entries are evicted first when the cache
+/// exceeds its capacity.
+///
+////////////////////////////////////////////////////////////
+class SampleCache
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Key identifying the contents of a sound file
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Key
+    {
+        Uint64 hash; ///< Hash of the contents of the file
+        Uint64 size; ///< Size of the file, in bytes
+
+        bool operator <(const Key& right) const;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the key of the contents of a stream
+    ///
+    /// The whole stream is read, and its read position is
+    /// restored afterwards.
+    ///
+    /// \param stream Stream to read
+    /// \param key    Key to fill
+    ///
+    /// \return True on success, false if the stream couldn't be read
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool computeKey(InputStream& stream, Key& key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look for the samples decoded from a sound file
+    ///
+    /// If another thread is decoding the same contents, this
+    /// function waits until it is done. When the samples are
+    /// not found, the caller is expected to decode them, and
+    /// then to call either insert or abandon with the same key,
+    /// so that the other threads stop waiting for them.
+    ///
+    /// \param key          Key of the sound file
+    /// \param samples      Vector to fill with a copy of the samples
+    /// \param channelCount Variable to fill with the number of channels
+    /// \param sampleRate   Variable to fill with the sample rate
+    ///
+    /// \return True if the samples were found in the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool find(const Key& key, std::vector<Int16>& samples, unsigned int& channelCount, unsigned int& sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the samples decoded from a sound file to the cache
+    ///
+    /// Nothing happens if the samples alone exceed the capacity
+    /// of the cache.
+    ///
+    /// \param key          Key of the sound file
+    /// \param samples      Decoded samples
+    /// \param channelCount Number of channels
+    /// \param sampleRate   Sample rate
+    ///
+    ////////////////////////////////////////////////////////////
+    static void insert(const Key& key, const std::vector<Int16>& samples, unsigned int channelCount, unsigned int sampleRate);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Give up decoding a sound file that was not found
+    ///
+    /// \param key Key of the sound file
+    ///
+    ////////////////////////////////////////////////////////////
+    static void abandon(const Key& key);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum amount of memory used by the cache
+    ///
+    /// \param capacity Capacity of the cache, in bytes (0 disables it)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setCapacity(Uint64 capacity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum amount of memory used by the cache
+    ///
+    /// \return Capacity of the cache, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static Uint64 getCapacity();
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SAMPLECACHE_HPP
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SeekIndex.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Order entries by frame, for binary searches
+    bool compareFrame(sf::Uint64 frame, const sf::priv::SeekIndex::Entry& entry)
+    {
+        return frame < entry.frame;
+    }
+}
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SeekIndex::SeekIndex() :
+m_entries(),
+m_spacing(1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void SeekIndex::setSpacing(Uint64 spacing)
+{
+    m_spacing = std::max<Uint64>(spacing, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SeekIndex::insert(Uint64 frame, Uint64 position)
+{
+    // Find the first entry after the new one
+    std::vector<Entry>::iterator next = std::upper_bound(m_entries.begin(), m_entries.end(), frame, compareFrame);
+
+    // Keep the table sparse: ignore the entry if it's too close to its neighbours
+    if ((next != m_entries.begin()) && (frame - (next - 1)->frame < m_spacing))
+        return;
+    if ((next != m_entries.end()) && (next->frame - frame < m_spacing))
+        return;
+
+    Entry entry;
+    entry.frame = frame;
+    entry.position = position;
+    m_entries.insert(next, entry);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SeekIndex::find(Uint64 frame, Entry& entry) const
+{
+    std::vector<Entry>::const_iterator next = std::upper_bound(m_entries.begin(), m_entries.end(), frame, compareFrame);
+    if (next == m_entries.begin())
+        return false;
+
+    entry = *(next - 1);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SeekIndex::clear()
+{
+    m_entries.clear();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SEEKINDEX_HPP
+#define SFML_SEEKINDEX_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Table mapping sample frames of a sound file to
+///        positions in its input stream
+///
+/// Readers of compressed formats use it to jump close to
+/// a sample with a single seek of their input stream, and
+/// then decode forward until the exact sample, instead of
+/// searching for it with many small reads.
+///
+/// The entries are kept sorted, and at least spacing frames
+/// apart, so that the table stays small for long files.
+///
+////////////////////////////////////////////////////////////
+class SeekIndex
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Entry of the table
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        Uint64 frame;    ///< Index of the first frame decoded from the position
+        Uint64 position; ///< Position in the input stream, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    SeekIndex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minimum number of frames between two entries
+    ///
+    /// \param spacing Minimum distance between two entries, in frames
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSpacing(Uint64 spacing);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add an entry to the table
+    ///
+    /// The entry is ignored if it is closer than the spacing
+    /// to an existing entry.
+    ///
+    /// \param frame    Index of the first frame decoded from \a position
+    /// \param position Position in the input stream, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void insert(Uint64 frame, Uint64 position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the closest entry before a frame
+    ///
+    /// \param frame Index of the frame to reach
+    /// \param entry Entry to fill with the last entry whose frame is not after \a frame
+    ///
+    /// \return True if an entry was found
+    ///
+    ////////////////////////////////////////////////////////////
+    bool find(Uint64 frame, Entry& entry) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the entries
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Entry> m_entries; ///< Entries, sorted by frame
+    Uint64             m_spacing; ///< Minimum number of frames between two entries
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SEEKINDEX_HPP
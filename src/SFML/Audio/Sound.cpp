@@ -27,34 +27,59 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
+#include <SFML/Audio/VoiceManager.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Sound::Sound() :
-m_buffer(NULL)
+SoundSource(false), // the sound gets a voice only while it is heard
+m_buffer   (NULL),
+m_loop     (false),
+m_status   (Stopped),
+m_offset   (Time::Zero),
+m_startTime(Time::Zero),
+m_priority (0.f)
 {
+    priv::VoiceManager::acquire();
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Sound(const SoundBuffer& buffer) :
-m_buffer(NULL)
+SoundSource(false),
+m_buffer   (NULL),
+m_loop     (false),
+m_status   (Stopped),
+m_offset   (Time::Zero),
+m_startTime(Time::Zero),
+m_priority (0.f)
 {
+    priv::VoiceManager::acquire();
+
     setBuffer(buffer);
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Sound(const Sound& copy) :
-SoundSource(copy),
-m_buffer   (NULL)
+SoundSource(false),
+m_buffer   (NULL),
+m_loop     (copy.m_loop),
+m_status   (Stopped),
+m_offset   (Time::Zero),
+m_startTime(Time::Zero),
+m_priority (copy.m_priority)
 {
+    priv::VoiceManager::acquire();
+
+    SoundSource::operator=(copy);
     if (copy.m_buffer)
         setBuffer(*copy.m_buffer);
-    setLoop(copy.getLoop());
 }
 
 
@@ -64,33 +89,64 @@ Sound::~Sound()
     stop();
     if (m_buffer)
         m_buffer->detachSound(this);
+
+    priv::VoiceManager::release();
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::play()
 {
-    alCheck(alSourcePlay(m_source));
+    Lock lock(priv::VoiceManager::getMutex());
+
+    // Resume from the current position if paused, restart otherwise
+    Status status = getStatus();
+    m_offset = (status == Paused) ? getPlayingOffset() : Time::Zero;
+    m_startTime = Clock::now();
+    m_status = Playing;
+
+    if (m_source)
+        alCheck(alSourcePlay(m_source));
+
+    priv::VoiceManager::play(this);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::pause()
 {
-    alCheck(alSourcePause(m_source));
+    Lock lock(priv::VoiceManager::getMutex());
+
+    if (getStatus() == Playing)
+    {
+        m_offset = getPlayingOffset();
+        m_startTime = Clock::now();
+        m_status = Paused;
+
+        if (m_source)
+            alCheck(alSourcePause(m_source));
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::stop()
 {
-    alCheck(alSourceStop(m_source));
+    Lock lock(priv::VoiceManager::getMutex());
+
+    m_status = Stopped;
+    m_offset = Time::Zero;
+
+    // Stops the voice if the sound has one
+    priv::VoiceManager::stop(this);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::setBuffer(const SoundBuffer& buffer)
 {
+    Lock lock(priv::VoiceManager::getMutex());
+
     // First detach from the previous buffer
     if (m_buffer)
     {
@@ -101,21 +157,38 @@ void Sound::setBuffer(const SoundBuffer& buffer)
     // Assign and use the new buffer
     m_buffer = &buffer;
     m_buffer->attachSound(this);
-    alCheck(alSourcei(m_source, AL_BUFFER, m_buffer->m_buffer));
+    if (m_source)
+        alCheck(alSourcei(m_source, AL_BUFFER, m_buffer->m_buffer));
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::setLoop(bool loop)
 {
-    alCheck(alSourcei(m_source, AL_LOOPING, loop));
+    Lock lock(priv::VoiceManager::getMutex());
+
+    // The virtual playing position depends on the loop flag
+    if (!m_source && (m_status == Playing))
+    {
+        m_offset = getPlayingOffset();
+        m_startTime = Clock::now();
+    }
+
+    m_loop = loop;
+    if (m_source)
+        alCheck(alSourcei(m_source, AL_LOOPING, loop));
 }
 
 
 ////////////////////////////////////////////////////////////
 void Sound::setPlayingOffset(Time timeOffset)
 {
-    alCheck(alSourcef(m_source, AL_SEC_OFFSET, timeOffset.asSeconds()));
+    Lock lock(priv::VoiceManager::getMutex());
+
+    m_offset = timeOffset;
+    m_startTime = Clock::now();
+    if (m_source)
+        alCheck(alSourcef(m_source, AL_SEC_OFFSET, timeOffset.asSeconds()));
 }
 
 
@@ -129,27 +202,91 @@ const SoundBuffer* Sound::getBuffer() const
 ////////////////////////////////////////////////////////////
 bool Sound::getLoop() const
 {
-    ALint loop;
-    alCheck(alGetSourcei(m_source, AL_LOOPING, &loop));
-
-    return loop != 0;
+    return m_loop;
 }
 
 
 ////////////////////////////////////////////////////////////
 Time Sound::getPlayingOffset() const
 {
-    ALfloat secs = 0.f;
-    alCheck(alGetSourcef(m_source, AL_SEC_OFFSET, &secs));
+    Lock lock(priv::VoiceManager::getMutex());
 
-    return seconds(secs);
+    if (m_source)
+    {
+        ALfloat secs = 0.f;
+        alCheck(alGetSourcef(m_source, AL_SEC_OFFSET, &secs));
+
+        return seconds(secs);
+    }
+
+    // The sound is played virtually: compute its position
+    if ((m_status == Stopped) || !m_buffer)
+        return Time::Zero;
+
+    Time offset = m_offset;
+    if (m_status == Playing)
+        offset += (Clock::now() - m_startTime) * getPitch();
+
+    Time duration = m_buffer->getDuration();
+    if (offset < duration)
+        return offset;
+    else if (m_loop && (duration > Time::Zero))
+        return offset % duration;
+    else
+        return Time::Zero;
 }
 
 
 ////////////////////////////////////////////////////////////
 Sound::Status Sound::getStatus() const
 {
-    return SoundSource::getStatus();
+    Lock lock(priv::VoiceManager::getMutex());
+
+    if (m_source)
+        return SoundSource::getStatus();
+
+    // A sound played virtually stops at the end of its buffer
+    if ((m_status == Playing) && !m_loop)
+    {
+        if (!m_buffer)
+            return Stopped;
+
+        Time offset = m_offset + (Clock::now() - m_startTime) * getPitch();
+        if (offset >= m_buffer->getDuration())
+            return Stopped;
+    }
+
+    return m_status;
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::setPriority(float priority)
+{
+    Lock lock(priv::VoiceManager::getMutex());
+
+    m_priority = priority;
+}
+
+
+////////////////////////////////////////////////////////////
+float Sound::getPriority() const
+{
+    return m_priority;
+}
+
+
+////////////////////////////////////////////////////////////
+void Sound::setVoiceCount(unsigned int count)
+{
+    priv::VoiceManager::setVoiceCount(count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Sound::getVoiceCount()
+{
+    return priv::VoiceManager::getVoiceCount();
 }
 
 
@@ -175,6 +312,7 @@ Sound& Sound::operator =(const Sound& right)
     if (right.m_buffer)
         setBuffer(*right.m_buffer);
     setLoop(right.getLoop());
+    setPriority(right.getPriority());
 
     return *this;
 }
@@ -183,16 +321,60 @@ Sound& Sound::operator =(const Sound& right)
 ////////////////////////////////////////////////////////////
 void Sound::resetBuffer()
 {
+    Lock lock(priv::VoiceManager::getMutex());
+
     // First stop the sound in case it is playing
     stop();
 
     // Detach the buffer
     if (m_buffer)
     {
-        alCheck(alSourcei(m_source, AL_BUFFER, 0));
+        if (m_source)
+            alCheck(alSourcei(m_source, AL_BUFFER, 0));
         m_buffer->detachSound(this);
         m_buffer = NULL;
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Sound::attachVoice(unsigned int voice)
+{
+    // Compute the position before the sound stops being virtual
+    Time offset = getPlayingOffset();
+
+    m_source = voice;
+    applyAttributes();
+
+    alCheck(alSourcei(m_source, AL_BUFFER, m_buffer ? m_buffer->m_buffer : 0));
+    alCheck(alSourcei(m_source, AL_LOOPING, m_loop));
+    alCheck(alSourcef(m_source, AL_SEC_OFFSET, offset.asSeconds()));
+
+    if (m_status == Playing)
+        alCheck(alSourcePlay(m_source));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int Sound::detachVoice()
+{
+    // Continue from the current position
+    if (m_status != Stopped)
+    {
+        ALfloat secs = 0.f;
+        alCheck(alGetSourcef(m_source, AL_SEC_OFFSET, &secs));
+
+        m_offset = seconds(secs);
+        m_startTime = Clock::now();
+    }
+
+    alCheck(alSourceStop(m_source));
+    alCheck(alSourcei(m_source, AL_BUFFER, 0));
+
+    unsigned int voice = m_source;
+    m_source = 0;
+
+    return voice;
+}
+
 } // namespace sf
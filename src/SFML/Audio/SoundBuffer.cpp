@@ -26,11 +26,14 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundBuffer.hpp>
-#include <SFML/Audio/InputSoundFile.hpp>
 #include <SFML/Audio/OutputSoundFile.hpp>
 #include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/SoundBufferLoader.hpp>
+#include <SFML/Audio/SampleCache.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <memory>
 
@@ -40,8 +43,11 @@ namespace sf
 ////////////////////////////////////////////////////////////
 SoundBuffer::SoundBuffer() :
 m_buffer  (0),
-m_duration()
+m_duration(),
+m_task    (NULL)
 {
+    priv::SoundBufferLoader::acquire();
+
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
 }
@@ -52,8 +58,11 @@ SoundBuffer::SoundBuffer(const SoundBuffer& copy) :
 m_buffer  (0),
 m_samples (copy.m_samples),
 m_duration(copy.m_duration),
-m_sounds  () // don't copy the attached sounds
+m_sounds  (), // don't copy the attached sounds
+m_task    (NULL) // nor the pending loading
 {
+    priv::SoundBufferLoader::acquire();
+
     // Create the buffer
     alCheck(alGenBuffers(1, &m_buffer));
 
@@ -65,6 +74,8 @@ m_sounds  () // don't copy the attached sounds
 ////////////////////////////////////////////////////////////
 SoundBuffer::~SoundBuffer()
 {
+    cancelLoading();
+
     // To prevent the iterator from becoming invalid, move the entire buffer to another
     // container. Otherwise calling resetBuffer would result in detachSound being
     // called which removes the sound from the internal list.
@@ -78,45 +89,59 @@ SoundBuffer::~SoundBuffer()
     // Destroy the buffer
     if (m_buffer)
         alCheck(alDeleteBuffers(1, &m_buffer));
+
+    priv::SoundBufferLoader::release();
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromFile(const std::string& filename)
 {
-    InputSoundFile file;
-    if (file.openFromFile(filename))
-        return initialize(file);
-    else
+    cancelLoading();
+
+    FileInputStream file;
+    if (!file.open(filename))
+    {
+        err() << "Failed to open sound file \"" << filename << "\" (couldn't open stream)" << std::endl;
         return false;
+    }
+
+    if (!initialize(file))
+    {
+        err() << "Failed to load sound buffer from file \"" << filename << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromMemory(const void* data, std::size_t sizeInBytes)
 {
-    InputSoundFile file;
-    if (file.openFromMemory(data, sizeInBytes))
-        return initialize(file);
-    else
-        return false;
+    cancelLoading();
+
+    MemoryInputStream stream;
+    stream.open(data, sizeInBytes);
+
+    return initialize(stream);
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromStream(InputStream& stream)
 {
-    InputSoundFile file;
-    if (file.openFromStream(stream))
-        return initialize(file);
-    else
-        return false;
+    cancelLoading();
+
+    return initialize(stream);
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsigned int channelCount, unsigned int sampleRate)
 {
+    cancelLoading();
+
     if (samples && sampleCount && channelCount && sampleRate)
     {
         // Copy the new audio samples
@@ -140,6 +165,94 @@ bool SoundBuffer::loadFromSamples(const Int16* samples, Uint64 sampleCount, unsi
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromFileAsync(const std::string& filename)
+{
+    cancelLoading();
+
+    // Open the file right away, to report missing files immediately
+    FileInputStream* file = new FileInputStream;
+    if (!file->open(filename))
+    {
+        err() << "Failed to open sound file \"" << filename << "\" (couldn't open stream)" << std::endl;
+        delete file;
+        return false;
+    }
+
+    startLoading(file, true);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromMemoryAsync(const void* data, std::size_t sizeInBytes)
+{
+    cancelLoading();
+
+    if (!data || (sizeInBytes == 0))
+    {
+        err() << "Failed to open sound file from memory (no data)" << std::endl;
+        return false;
+    }
+
+    MemoryInputStream* stream = new MemoryInputStream;
+    stream->open(data, sizeInBytes);
+
+    startLoading(stream, true);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::loadFromStreamAsync(InputStream& stream)
+{
+    cancelLoading();
+
+    // Check the stream right away, like loadFromFileAsync checks the file
+    if (stream.getSize() <= 0)
+    {
+        err() << "Failed to open sound file from stream (empty or unreadable stream)" << std::endl;
+        return false;
+    }
+
+    startLoading(&stream, false);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::isLoading() const
+{
+    return m_task && !priv::SoundBufferLoader::isFinished(m_task);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::finishLoading()
+{
+    if (!m_task)
+        return true;
+
+    priv::SoundBufferLoader::wait(m_task);
+
+    bool success = (m_task->status == priv::SoundBufferTask::Succeeded);
+    if (success)
+    {
+        // Update the internal buffer with the new samples
+        m_samples.swap(m_task->samples);
+        success = update(m_task->channelCount, m_task->sampleRate);
+    }
+
+    delete m_task;
+    m_task = NULL;
+
+    return success;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundBuffer::saveToFile(const std::string& filename) const
 {
@@ -203,6 +316,8 @@ Time SoundBuffer::getDuration() const
 ////////////////////////////////////////////////////////////
 SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 {
+    cancelLoading();
+
     SoundBuffer temp(right);
 
     std::swap(m_samples,  temp.m_samples);
@@ -215,23 +330,65 @@ SoundBuffer& SoundBuffer::operator =(const SoundBuffer& right)
 
 
 ////////////////////////////////////////////////////////////
-bool SoundBuffer::initialize(InputSoundFile& file)
+void SoundBuffer::setLoadingThreadCount(unsigned int count)
 {
-    // Retrieve the sound parameters
-    Uint64       sampleCount  = file.getSampleCount();
-    unsigned int channelCount = file.getChannelCount();
-    unsigned int sampleRate   = file.getSampleRate();
-
-    // Read the samples from the provided file
-    m_samples.resize(static_cast<std::size_t>(sampleCount));
-    if (file.read(&m_samples[0], sampleCount) == sampleCount)
-    {
-        // Update the internal buffer with the new samples
-        return update(channelCount, sampleRate);
-    }
-    else
-    {
+    priv::SoundBufferLoader::setThreadCount(count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundBuffer::getLoadingThreadCount()
+{
+    return priv::SoundBufferLoader::getThreadCount();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::setCacheCapacity(Uint64 capacity)
+{
+    priv::SampleCache::setCapacity(capacity);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundBuffer::getCacheCapacity()
+{
+    return priv::SampleCache::getCapacity();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBuffer::initialize(InputStream& stream)
+{
+    // Decode the samples from the provided stream
+    std::vector<Int16> samples;
+    unsigned int channelCount = 0;
+    unsigned int sampleRate = 0;
+    if (!priv::SoundBufferLoader::decode(stream, samples, channelCount, sampleRate))
         return false;
+
+    // Update the internal buffer with the new samples
+    m_samples.swap(samples);
+    return update(channelCount, sampleRate);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::startLoading(InputStream* stream, bool ownsStream)
+{
+    m_task = new priv::SoundBufferTask(stream, ownsStream);
+    priv::SoundBufferLoader::submit(m_task);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBuffer::cancelLoading()
+{
+    if (m_task)
+    {
+        priv::SoundBufferLoader::cancel(m_task);
+        delete m_task;
+        m_task = NULL;
     }
 }
 
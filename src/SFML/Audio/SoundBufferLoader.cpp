@@ -0,0 +1,379 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundBufferLoader.hpp>
+#include <SFML/Audio/SampleCache.hpp>
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/System/InputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace
+{
+    // Sound buffers counter and its mutex
+    unsigned int count = 0;
+    sf::Mutex mutex;
+
+    // The loader is created with the first sound buffer and
+    // destroyed with the last one, like the audio device
+    sf::priv::SoundBufferLoader* globalLoader = NULL;
+
+    // Number of loading threads
+    unsigned int threadCount = 2;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SoundBufferTask::SoundBufferTask(InputStream* source, bool ownsSource) :
+stream      (source),
+ownsStream  (ownsSource),
+status      (Queued),
+cancelled   (false),
+samples     (),
+channelCount(0),
+sampleRate  (0),
+finished    ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferTask::~SoundBufferTask()
+{
+    if (ownsStream)
+        delete stream;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::acquire()
+{
+    Lock lock(mutex);
+
+    if (count == 0)
+        globalLoader = new SoundBufferLoader;
+
+    count++;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::release()
+{
+    Lock lock(mutex);
+
+    count--;
+
+    if (count == 0)
+    {
+        delete globalLoader;
+        globalLoader = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoader::decode(InputStream& stream, std::vector<Int16>& samples, unsigned int& channelCount, unsigned int& sampleRate, const SoundBufferTask* task)
+{
+    // Look for the contents of the stream in the cache first
+    SampleCache::Key key;
+    bool hasKey = (SampleCache::getCapacity() > 0) && SampleCache::computeKey(stream, key);
+    if (hasKey && SampleCache::find(key, samples, channelCount, sampleRate))
+        return true;
+
+    // Read the samples from the provided file
+    InputSoundFile file;
+    bool success = file.openFromStream(stream);
+    if (success)
+    {
+        Uint64 sampleCount = file.getSampleCount();
+        samples.resize(static_cast<std::size_t>(sampleCount));
+        success = (sampleCount > 0);
+
+        channelCount = file.getChannelCount();
+        sampleRate = file.getSampleRate();
+
+        // Read a task by chunks of whole frames, so that it can be cancelled
+        // without waiting for the whole file to be decoded
+        Uint64 chunkSize = task ? 8192 * channelCount : sampleCount;
+        for (Uint64 offset = 0; success && (offset < sampleCount); offset += chunkSize)
+        {
+            if (task && isCancelled(task))
+            {
+                success = false;
+                break;
+            }
+
+            Uint64 count = std::min(chunkSize, sampleCount - offset);
+            success = (file.read(&samples[static_cast<std::size_t>(offset)], count) == count);
+        }
+    }
+
+    // Let the other threads loading the same file know the result
+    if (hasKey)
+    {
+        if (success)
+            SampleCache::insert(key, samples, channelCount, sampleRate);
+        else
+            SampleCache::abandon(key);
+    }
+
+    return success;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::submit(SoundBufferTask* task)
+{
+    {
+        Lock lock(globalLoader->m_mutex);
+
+        task->status = SoundBufferTask::Queued;
+        globalLoader->m_queue.push_back(task);
+    }
+
+    globalLoader->m_wakeUp.post();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoader::isFinished(const SoundBufferTask* task)
+{
+    Lock lock(globalLoader->m_mutex);
+
+    return (task->status == SoundBufferTask::Succeeded) || (task->status == SoundBufferTask::Failed);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::wait(SoundBufferTask* task)
+{
+    SoundBufferTask::Status status;
+
+    {
+        Lock lock(globalLoader->m_mutex);
+
+        status = task->status;
+
+        // Take the task out of the queue, rather than waiting for it
+        if (status == SoundBufferTask::Queued)
+        {
+            globalLoader->m_queue.erase(std::find(globalLoader->m_queue.begin(), globalLoader->m_queue.end(), task));
+            task->status = SoundBufferTask::Decoding;
+        }
+    }
+
+    if (status == SoundBufferTask::Queued)
+    {
+        globalLoader->execute(task);
+    }
+    else if (status == SoundBufferTask::Decoding)
+    {
+        task->finished.wait();
+
+        // Make sure that the loading thread has released the task
+        Lock lock(globalLoader->m_mutex);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::cancel(SoundBufferTask* task)
+{
+    SoundBufferTask::Status status;
+
+    {
+        Lock lock(globalLoader->m_mutex);
+
+        status = task->status;
+
+        if (status == SoundBufferTask::Queued)
+        {
+            globalLoader->m_queue.erase(std::find(globalLoader->m_queue.begin(), globalLoader->m_queue.end(), task));
+            task->status = SoundBufferTask::Failed;
+        }
+
+        // Let the loading thread stop decoding the task at the next chunk
+        task->cancelled = true;
+    }
+
+    // A loading thread is using the task: wait until it is done with it
+    if (status == SoundBufferTask::Decoding)
+    {
+        task->finished.wait();
+        Lock lock(globalLoader->m_mutex);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::setThreadCount(unsigned int count)
+{
+    Lock lock(mutex);
+
+    threadCount = std::max(count, 1u);
+
+    // Restart the threads of the existing loader
+    if (globalLoader && (globalLoader->m_threads.size() != threadCount))
+    {
+        globalLoader->terminateThreads();
+        globalLoader->launchThreads(threadCount);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundBufferLoader::getThreadCount()
+{
+    Lock lock(mutex);
+
+    return threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoader::SoundBufferLoader() :
+m_threads  (),
+m_mutex    (),
+m_wakeUp   (),
+m_queue    (),
+m_isRunning(false)
+{
+    launchThreads(threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundBufferLoader::~SoundBufferLoader()
+{
+    terminateThreads();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::launchThreads(unsigned int count)
+{
+    m_isRunning = true;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        m_threads.push_back(new Thread(&SoundBufferLoader::run, this));
+        m_threads.back()->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::terminateThreads()
+{
+    // Request the threads to terminate
+    {
+        Lock lock(m_mutex);
+        m_isRunning = false;
+    }
+
+    for (std::size_t i = 0; i < m_threads.size(); ++i)
+        m_wakeUp.post();
+
+    // Wait for the threads to terminate
+    for (std::size_t i = 0; i < m_threads.size(); ++i)
+    {
+        m_threads[i]->wait();
+        delete m_threads[i];
+    }
+
+    m_threads.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::run()
+{
+    for (;;)
+    {
+        m_wakeUp.wait();
+
+        SoundBufferTask* task = NULL;
+
+        {
+            Lock lock(m_mutex);
+
+            if (!m_isRunning)
+                break;
+
+            // The task may have been taken by a thread waiting for it
+            if (m_queue.empty())
+                continue;
+
+            task = m_queue.front();
+            m_queue.pop_front();
+            task->status = SoundBufferTask::Decoding;
+        }
+
+        execute(task);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundBufferLoader::execute(SoundBufferTask* task)
+{
+    bool success = decode(*task->stream, task->samples, task->channelCount, task->sampleRate, task);
+
+    // Release the samples of a failed or cancelled task right away
+    if (!success)
+        std::vector<Int16>().swap(task->samples);
+
+    // Wake up the thread waiting for the task, if any; this is done under
+    // the lock so that the task is not deleted before it is posted
+    Lock lock(m_mutex);
+    task->status = success ? SoundBufferTask::Succeeded : SoundBufferTask::Failed;
+    task->finished.post();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundBufferLoader::isCancelled(const SoundBufferTask* task)
+{
+    Lock lock(globalLoader->m_mutex);
+
+    return task->cancelled;
+}
+
+} // namespace priv
+
+} // namespace sf
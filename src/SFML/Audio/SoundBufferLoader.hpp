@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDBUFFERLOADER_HPP
+#define SFML_SOUNDBUFFERLOADER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/Thread.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Sound file decoded in the background for a sound buffer
+///
+////////////////////////////////////////////////////////////
+struct SoundBufferTask : NonCopyable
+{
+    ////////////////////////////////////////////////////////////
+    /// \brief Enumeration of the task states
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Status
+    {
+        Queued,    ///< The task waits for a loading thread
+        Decoding,  ///< The sound file is being decoded
+        Succeeded, ///< The samples have been decoded
+        Failed     ///< The sound file couldn't be decoded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the task from the stream to decode
+    ///
+    /// \param source      Stream containing the sound file
+    /// \param ownsSource  Whether the task must delete the stream
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundBufferTask(InputStream* source, bool ownsSource);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundBufferTask();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    InputStream*       stream;       ///< Stream containing the sound file
+    bool               ownsStream;   ///< Whether the task must delete the stream
+    Status             status;       ///< Current state of the task
+    bool               cancelled;    ///< Whether the owner of the task gave up on it
+    std::vector<Int16> samples;      ///< Decoded samples
+    unsigned int       channelCount; ///< Number of channels of the decoded sound
+    unsigned int       sampleRate;   ///< Sample rate of the decoded sound
+    Semaphore          finished;     ///< Semaphore posted when the file has been decoded
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Pool of background threads shared by all the sound
+///        buffers, which decode the sound files loaded
+///        asynchronously
+///
+////////////////////////////////////////////////////////////
+class SoundBufferLoader : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new sound buffer instance
+    ///
+    /// The loader is created with the first instance,
+    /// and destroyed with the last one.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a sound buffer instance
+    ///
+    ////////////////////////////////////////////////////////////
+    static void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a whole sound file on the calling thread
+    ///
+    /// The samples are taken from the sample cache if the
+    /// same contents were decoded before.
+    ///
+    /// When decoding for a task, the samples are read by
+    /// chunks, and decoding stops early if the task gets
+    /// cancelled in the meantime.
+    ///
+    /// \param stream       Stream containing the sound file
+    /// \param samples      Vector to fill with the decoded samples
+    /// \param channelCount Variable to fill with the number of channels
+    /// \param sampleRate   Variable to fill with the sample rate
+    /// \param task         Task being decoded, or NULL when decoding on the calling thread
+    ///
+    /// \return True on success, false on failure or cancellation
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool decode(InputStream& stream, std::vector<Int16>& samples, unsigned int& channelCount, unsigned int& sampleRate, const SoundBufferTask* task = NULL);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a task to be decoded by the loading threads
+    ///
+    /// \param task Task to queue
+    ///
+    ////////////////////////////////////////////////////////////
+    static void submit(SoundBufferTask* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a task is decoded
+    ///
+    /// \param task Task to check
+    ///
+    /// \return True if the task has succeeded or failed
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isFinished(const SoundBufferTask* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until a task is decoded
+    ///
+    /// A task that hasn't been picked by a loading thread
+    /// yet is decoded on the calling thread.
+    ///
+    /// \param task Task to wait for
+    ///
+    ////////////////////////////////////////////////////////////
+    static void wait(SoundBufferTask* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a task from the queue
+    ///
+    /// If the task is being decoded, it is marked as cancelled
+    /// and this function waits until the loading thread notices
+    /// it, which happens at the latest after the current chunk
+    /// of samples is decoded; the samples are then discarded.
+    /// It still blocks while the stream is hashed for the sample
+    /// cache, if it is enabled. The task can then be deleted.
+    ///
+    /// \param task Task to cancel
+    ///
+    ////////////////////////////////////////////////////////////
+    static void cancel(SoundBufferTask* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of loading threads
+    ///
+    /// \param count Number of threads (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of loading threads
+    ///
+    /// \return Number of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getThreadCount();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Launches the loading threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundBufferLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the loading threads to terminate.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundBufferLoader();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Launch the loading threads
+    ///
+    /// \param count Number of threads to launch
+    ///
+    ////////////////////////////////////////////////////////////
+    void launchThreads(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Terminate the loading threads
+    ///
+    /// The tasks being decoded are completed first.
+    ///
+    ////////////////////////////////////////////////////////////
+    void terminateThreads();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the threads
+    ///
+    /// This function decodes the queued tasks in order,
+    /// and sleeps while the queue is empty.
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode a task whose status is Decoding
+    ///
+    /// \param task Task to decode
+    ///
+    ////////////////////////////////////////////////////////////
+    void execute(SoundBufferTask* task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a task was cancelled by its owner
+    ///
+    /// \param task Task to check
+    ///
+    /// \return True if the task was cancelled
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCancelled(const SoundBufferTask* task);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Thread*>         m_threads;   ///< Loading threads
+    Mutex                        m_mutex;     ///< Mutex protecting the queue and the status of the tasks
+    Semaphore                    m_wakeUp;    ///< Semaphore posted once per queued task
+    std::deque<SoundBufferTask*> m_queue;     ///< Tasks waiting for a loading thread
+    bool                         m_isRunning; ///< Whether the threads must keep running
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDBUFFERLOADER_HPP
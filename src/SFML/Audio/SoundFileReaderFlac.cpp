@@ -28,11 +28,16 @@
 #include <SFML/Audio/SoundFileReaderFlac.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 
 
 namespace
 {
+    // Maximum distance between the seek target and the closest entry of the
+    // seek index, in seconds, beyond which the decoder's own seek is faster
+    const sf::Uint64 maxIndexDistance = 10;
+
     FLAC__StreamDecoderReadStatus streamRead(const FLAC__StreamDecoder*, FLAC__byte buffer[], std::size_t* bytes, void* clientData)
     {
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
@@ -107,6 +112,12 @@ namespace
     {
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
 
+        // Keep track of the index of the sample frame that follows this FLAC frame
+        if (frame->header.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER)
+            data->position = frame->header.number.sample_number + frame->header.blocksize;
+        else
+            data->position = (static_cast<sf::Uint64>(frame->header.number.frame_number) + 1) * frame->header.blocksize;
+
         // Reserve memory if we're going to use the leftovers buffer
         unsigned int frameSamples = frame->header.blocksize * frame->header.channels;
         if (data->remaining < frameSamples)
@@ -117,31 +128,18 @@ namespace
         {
             for (unsigned int j = 0; j < frame->header.channels; ++j)
             {
-                // Decode the current sample
-                sf::Int16 sample = 0;
-                switch (frame->header.bits_per_sample)
-                {
-                    case 8:
-                        sample = buffer[j][i] << 8;
-                        break;
-                    case 16:
-                        sample = buffer[j][i];
-                        break;
-                    case 24:
-                        sample = buffer[j][i] >> 8;
-                        break;
-                    case 32:
-                        sample = buffer[j][i] >> 16;
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                }
+                // Decode the current sample, scaled to the full 32-bit range
+                sf::Int32 sample = static_cast<sf::Int32>(static_cast<sf::Uint32>(buffer[j][i]) << (32 - frame->header.bits_per_sample));
 
                 if (data->buffer && data->remaining > 0)
                 {
                     // If there's room in the output buffer, copy the sample there
-                    *data->buffer++ = sample;
+                    *data->buffer++ = static_cast<sf::Int16>(sample >> 16);
+                    data->remaining--;
+                }
+                else if (data->floatBuffer && data->remaining > 0)
+                {
+                    *data->floatBuffer++ = sample / 2147483648.f;
                     data->remaining--;
                 }
                 else
@@ -156,6 +154,30 @@ namespace
         return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
     }
 
+    // Convert the samples stored in the leftovers buffer to the requested type
+    void convert(sf::Int32 sample, sf::Int16& output)
+    {
+        output = static_cast<sf::Int16>(sample >> 16);
+    }
+
+    void convert(sf::Int32 sample, float& output)
+    {
+        output = sample / 2147483648.f;
+    }
+
+    // Set the output buffer of the "write" callback
+    void setOutput(sf::priv::SoundFileReaderFlac::ClientData& data, sf::Int16* samples)
+    {
+        data.buffer = samples;
+        data.floatBuffer = NULL;
+    }
+
+    void setOutput(sf::priv::SoundFileReaderFlac::ClientData& data, float* samples)
+    {
+        data.buffer = NULL;
+        data.floatBuffer = samples;
+    }
+
     void streamMetadata(const FLAC__StreamDecoder*, const FLAC__StreamMetadata* meta, void* clientData)
     {
         sf::priv::SoundFileReaderFlac::ClientData* data = static_cast<sf::priv::SoundFileReaderFlac::ClientData*>(clientData);
@@ -166,6 +188,22 @@ namespace
             data->info.sampleRate = meta->data.stream_info.sample_rate;
             data->info.channelCount = meta->data.stream_info.channels;
         }
+        else if (meta->type == FLAC__METADATA_TYPE_SEEKTABLE)
+        {
+            // Keep the seek points for the seek index; their offsets are relative
+            // to the first frame, whose position is only known after the metadata
+            for (unsigned int i = 0; i < meta->data.seek_table.num_points; ++i)
+            {
+                const FLAC__StreamMetadata_SeekPoint& point = meta->data.seek_table.points[i];
+                if (point.sample_number != FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER)
+                {
+                    sf::priv::SeekIndex::Entry entry;
+                    entry.frame = point.sample_number;
+                    entry.position = point.stream_offset;
+                    data->seekPoints.push_back(entry);
+                }
+            }
+        }
     }
 
     void streamError(const FLAC__StreamDecoder*, FLAC__StreamDecoderErrorStatus, void* clientData)
@@ -206,8 +244,9 @@ bool SoundFileReaderFlac::check(InputStream& stream)
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderFlac::SoundFileReaderFlac() :
-m_decoder(NULL),
-m_clientData()
+m_decoder   (NULL),
+m_clientData(),
+m_seekIndex ()
 {
 }
 
@@ -230,8 +269,9 @@ bool SoundFileReaderFlac::open(InputStream& stream, Info& info)
         return false;
     }
 
-    // Initialize the decoder with our callbacks
+    // Initialize the decoder with our callbacks, and ask for the seek table
     m_clientData.stream = &stream;
+    FLAC__stream_decoder_set_metadata_respond(m_decoder, FLAC__METADATA_TYPE_SEEKTABLE);
     FLAC__stream_decoder_init_stream(m_decoder, &streamRead, &streamSeek, &streamTell, &streamLength, &streamEof, &streamWrite, &streamMetadata, &streamError, &m_clientData);
 
     // Read the header
@@ -245,6 +285,21 @@ bool SoundFileReaderFlac::open(InputStream& stream, Info& info)
     // Retrieve the sound properties
     info = m_clientData.info; // was filled in the "metadata" callback
 
+    // Start the seek index with the first frame and the points of the seek table; the
+    // other entries are added while decoding, roughly one per second of audio
+    m_seekIndex.clear();
+    m_seekIndex.setSpacing(info.sampleRate);
+
+    FLAC__uint64 firstFrame;
+    if (FLAC__stream_decoder_get_decode_position(m_decoder, &firstFrame))
+    {
+        m_seekIndex.insert(0, firstFrame);
+        for (std::size_t i = 0; i < m_clientData.seekPoints.size(); ++i)
+            m_seekIndex.insert(m_clientData.seekPoints[i].frame, firstFrame + m_clientData.seekPoints[i].position);
+    }
+
+    std::vector<SeekIndex::Entry>().swap(m_clientData.seekPoints);
+
     return true;
 }
 
@@ -256,15 +311,23 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
 
     // Reset the callback data (the "write" callback will be called)
     m_clientData.buffer = NULL;
+    m_clientData.floatBuffer = NULL;
     m_clientData.remaining = 0;
     m_clientData.leftovers.clear();
 
     // FLAC decoder expects absolute sample offset, so we take the channel count out
     if (sampleOffset < m_clientData.info.sampleCount)
     {
+        Uint64 frame = sampleOffset / m_clientData.info.channelCount;
+
         // The "write" callback will populate the leftovers buffer with the first batch of samples from the
         // seek destination, and since we want that data in this typical case, we don't re-clear it afterward
-        FLAC__stream_decoder_seek_absolute(m_decoder, sampleOffset / m_clientData.info.channelCount);
+        if (!seekWithIndex(frame))
+        {
+            // Not enough entries in the index around the destination: let the decoder search for it
+            m_clientData.leftovers.clear();
+            FLAC__stream_decoder_seek_absolute(m_decoder, frame);
+        }
     }
     else
     {
@@ -280,6 +343,21 @@ void SoundFileReaderFlac::seek(Uint64 sampleOffset)
 
 ////////////////////////////////////////////////////////////
 Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
+{
+    return decode(samples, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderFlac::read(float* samples, Uint64 maxCount)
+{
+    return decode(samples, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Uint64 SoundFileReaderFlac::decode(T* samples, Uint64 maxCount)
 {
     assert(m_decoder);
 
@@ -287,23 +365,20 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
     std::size_t left = m_clientData.leftovers.size();
     if (left > 0)
     {
+        std::size_t toCopy = static_cast<std::size_t>(std::min<Uint64>(left, maxCount));
+        for (std::size_t i = 0; i < toCopy; ++i)
+            convert(m_clientData.leftovers[i], samples[i]);
+
         if (left > maxCount)
         {
             // There are more leftovers than needed
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + static_cast<std::size_t>(maxCount), samples);
-            std::vector<Int16> leftovers(m_clientData.leftovers.begin() + static_cast<std::size_t>(maxCount), m_clientData.leftovers.end());
-            m_clientData.leftovers.swap(leftovers);
+            m_clientData.leftovers.erase(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + toCopy);
             return maxCount;
         }
-        else
-        {
-            // We can use all the leftovers and decode new frames
-            std::copy(m_clientData.leftovers.begin(), m_clientData.leftovers.end(), samples);
-        }
     }
 
     // Reset the data that will be used in the callback
-    m_clientData.buffer = samples + left;
+    setOutput(m_clientData, samples + left);
     m_clientData.remaining = maxCount - left;
     m_clientData.leftovers.clear();
 
@@ -312,18 +387,73 @@ Uint64 SoundFileReaderFlac::read(Int16* samples, Uint64 maxCount)
     {
         // Everything happens in the "write" callback
         // This will break on any fatal error (does not include EOF)
+        m_clientData.position = 0;
         if (!FLAC__stream_decoder_process_single(m_decoder))
             break;
 
         // Break on EOF
         if (FLAC__stream_decoder_get_state(m_decoder) == FLAC__STREAM_DECODER_END_OF_STREAM)
             break;
+
+        indexPosition();
     }
 
     return maxCount - m_clientData.remaining;
 }
 
 
+////////////////////////////////////////////////////////////
+bool SoundFileReaderFlac::seekWithIndex(Uint64 frame)
+{
+    // Decoding from an entry far before the destination would cost more than searching for it
+    SeekIndex::Entry entry;
+    if (!m_seekIndex.find(frame, entry) || (frame - entry.frame > maxIndexDistance * m_clientData.info.sampleRate))
+        return false;
+
+    // Jump to the FLAC frame that starts at the entry's position, with a single seek
+    if (m_clientData.stream->seek(static_cast<Int64>(entry.position)) != static_cast<Int64>(entry.position))
+        return false;
+
+    if (!FLAC__stream_decoder_flush(m_decoder))
+        return false;
+
+    // Decode FLAC frames until the one that contains the destination
+    do
+    {
+        m_clientData.leftovers.clear();
+        m_clientData.position = 0;
+
+        // The position is only updated if a frame was actually decoded
+        if (!FLAC__stream_decoder_process_single(m_decoder) || (m_clientData.position == 0))
+            return false;
+
+        indexPosition();
+    }
+    while (m_clientData.position <= frame);
+
+    // Drop the samples that precede the destination
+    Uint64 channelCount = m_clientData.info.channelCount;
+    Uint64 frameStart = m_clientData.position - m_clientData.leftovers.size() / channelCount;
+    if (frameStart > frame)
+        return false;
+
+    std::size_t skipped = static_cast<std::size_t>((frame - frameStart) * channelCount);
+    m_clientData.leftovers.erase(m_clientData.leftovers.begin(), m_clientData.leftovers.begin() + skipped);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderFlac::indexPosition()
+{
+    // Right after a FLAC frame is decoded, the decoder's position is the beginning of the next one
+    FLAC__uint64 position;
+    if ((m_clientData.position > 0) && FLAC__stream_decoder_get_decode_position(m_decoder, &position))
+        m_seekIndex.insert(m_clientData.position, position);
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderFlac::close()
 {
@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
+#include <SFML/Audio/SeekIndex.hpp>
 #include <FLAC/stream_decoder.h>
 #include <string>
 #include <vector>
@@ -105,6 +106,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -113,16 +125,50 @@ public:
     ////////////////////////////////////////////////////////////
     struct ClientData
     {
-        InputStream*          stream;
-        SoundFileReader::Info info;
-        Int16*                buffer;
-        Uint64                remaining;
-        std::vector<Int16>    leftovers;
-        bool                  error;
+        InputStream*                  stream;
+        SoundFileReader::Info         info;
+        Int16*                        buffer;
+        float*                        floatBuffer;
+        Uint64                        remaining;
+        std::vector<Int32>            leftovers;
+        Uint64                        position;
+        std::vector<SeekIndex::Entry> seekPoints;
+        bool                          error;
     };
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Decode audio samples from the open file
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Uint64 decode(T* samples, Uint64 maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Jump to a sample frame from the closest entry of the seek index
+    ///
+    /// On success, the leftovers buffer is filled with the
+    /// samples of the decoded frame, starting at \a frame.
+    ///
+    /// \param frame Index of the sample frame to jump to
+    ///
+    /// \return True on success, false if the index is too sparse around \a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekWithIndex(Uint64 frame);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the position of the next frame to the seek index
+    ///
+    ////////////////////////////////////////////////////////////
+    void indexPosition();
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the open FLAC file
     ///
@@ -134,6 +180,7 @@ private:
     ////////////////////////////////////////////////////////////
     FLAC__StreamDecoder* m_decoder;    ///< FLAC decoder
     ClientData           m_clientData; ///< Structure passed to the decoder callbacks
+    SeekIndex            m_seekIndex;  ///< Stream positions of some of the FLAC frames
 };
 
 } // namespace priv
@@ -35,6 +35,14 @@
 
 namespace
 {
+    // Maximum distance between the seek target and the closest entry of the
+    // seek index, in seconds, beyond which the Vorbis library's seek is faster
+    const sf::Uint64 maxIndexDistance = 10;
+
+    // Largest Vorbis block, in sample frames: decoding from the beginning of a page may
+    // only start after the first block, since it needs the previous one to be complete
+    const sf::Uint64 maxBlockSize = 8192;
+
     size_t read(void* ptr, size_t size, size_t nmemb, void* data)
     {
         sf::InputStream* stream = static_cast<sf::InputStream*>(data);
@@ -88,8 +96,10 @@ bool SoundFileReaderOgg::check(InputStream& stream)
 
 ////////////////////////////////////////////////////////////
 SoundFileReaderOgg::SoundFileReaderOgg() :
-m_vorbis      (),
-m_channelCount(0)
+m_vorbis        (),
+m_channelCount  (0),
+m_seekIndex     (),
+m_indexable     (false)
 {
     m_vorbis.datasource = NULL;
 }
@@ -122,6 +132,12 @@ bool SoundFileReaderOgg::open(InputStream& stream, Info& info)
     // We must keep the channel count for the seek function
     m_channelCount = info.channelCount;
 
+    // The seek index is filled as the file is decoded, with roughly one entry per second
+    // of audio; unseekable and chained streams are left to the Vorbis library
+    m_seekIndex.clear();
+    m_seekIndex.setSpacing(info.sampleRate);
+    m_indexable = ov_seekable(&m_vorbis) && (ov_streams(&m_vorbis) == 1);
+
     return true;
 }
 
@@ -131,7 +147,8 @@ void SoundFileReaderOgg::seek(Uint64 sampleOffset)
 {
     assert(m_vorbis.datasource);
 
-    ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
+    if (!seekWithIndex(sampleOffset / m_channelCount))
+        ov_pcm_seek(&m_vorbis, sampleOffset / m_channelCount);
 }
 
 
@@ -144,8 +161,12 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
     Uint64 count = 0;
     while (count < maxCount)
     {
+        ogg_int64_t frame = ov_pcm_tell(&m_vorbis);
+        ogg_int64_t position = ov_raw_tell(&m_vorbis);
+
         int bytesToRead = static_cast<int>(maxCount - count) * sizeof(Int16);
         long bytesRead = ov_read(&m_vorbis, reinterpret_cast<char*>(samples), bytesToRead, 0, 2, 1, NULL);
+        indexPosition(frame, position);
         if (bytesRead > 0)
         {
             long samplesRead = bytesRead / sizeof(Int16);
@@ -163,6 +184,101 @@ Uint64 SoundFileReaderOgg::read(Int16* samples, Uint64 maxCount)
 }
 
 
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderOgg::read(float* samples, Uint64 maxCount)
+{
+    assert(m_vorbis.datasource);
+
+    // Vorbis decodes to floating point samples, one array per channel:
+    // interleave them instead of converting them to 16-bit integers
+    Uint64 count = 0;
+    while (maxCount - count >= m_channelCount)
+    {
+        ogg_int64_t frame = ov_pcm_tell(&m_vorbis);
+        ogg_int64_t position = ov_raw_tell(&m_vorbis);
+
+        float** channels = NULL;
+        int framesToRead = static_cast<int>(std::min<Uint64>((maxCount - count) / m_channelCount, 4096));
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        indexPosition(frame, position);
+        if (framesRead > 0)
+        {
+            for (long i = 0; i < framesRead; ++i)
+            {
+                for (unsigned int j = 0; j < m_channelCount; ++j)
+                    *samples++ = channels[j][i];
+            }
+
+            count += static_cast<Uint64>(framesRead) * m_channelCount;
+        }
+        else
+        {
+            // error or end of file
+            break;
+        }
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundFileReaderOgg::indexPosition(ogg_int64_t frame, ogg_int64_t position)
+{
+    // The stream position only moves when a page is fetched, so the position taken
+    // before the call is the beginning of that page; decoding from there resumes
+    // shortly after frame (the first block of a page can't be decoded on its own,
+    // seekWithIndex accounts for it)
+    if (m_indexable && (frame >= 0) && (position >= 0) && (ov_raw_tell(&m_vorbis) != position))
+        m_seekIndex.insert(static_cast<Uint64>(frame), static_cast<Uint64>(position));
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoundFileReaderOgg::seekWithIndex(Uint64 frame)
+{
+    if (!m_indexable)
+        return false;
+
+    // Seeking past the end is left to the Vorbis library
+    ogg_int64_t frameCount = ov_pcm_total(&m_vorbis, -1);
+    if ((frameCount < 0) || (frame >= static_cast<Uint64>(frameCount)))
+        return false;
+
+    // Decoding from an entry far before the destination would cost more than searching for it
+    SeekIndex::Entry entry;
+    if (!m_seekIndex.find(frame - std::min(frame, maxBlockSize), entry) ||
+        (frame - entry.frame > maxIndexDistance * ov_info(&m_vorbis, -1)->rate))
+        return false;
+
+    // Jump to the page with a single seek, the Vorbis library works out the exact sample it
+    // starts at; the entries are only approximate, this is checked before decoding forward
+    if (ov_raw_seek(&m_vorbis, static_cast<ogg_int64_t>(entry.position)) != 0)
+        return false;
+
+    ogg_int64_t position = ov_pcm_tell(&m_vorbis);
+    if ((position < 0) || (static_cast<Uint64>(position) > frame))
+        return false;
+
+    // Decode and drop the samples that precede the destination
+    while (static_cast<Uint64>(position) < frame)
+    {
+        ogg_int64_t rawPosition = ov_raw_tell(&m_vorbis);
+
+        float** channels = NULL;
+        int framesToRead = static_cast<int>(std::min<Uint64>(frame - position, 4096));
+        long framesRead = ov_read_float(&m_vorbis, &channels, framesToRead, NULL);
+        if (framesRead <= 0)
+            return false;
+
+        indexPosition(position, rawPosition);
+        position += framesRead;
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundFileReaderOgg::close()
 {
@@ -171,6 +287,8 @@ void SoundFileReaderOgg::close()
         ov_clear(&m_vorbis);
         m_vorbis.datasource = NULL;
         m_channelCount = 0;
+        m_seekIndex.clear();
+        m_indexable = false;
     }
 }
 
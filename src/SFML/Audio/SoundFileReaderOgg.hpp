@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
+#include <SFML/Audio/SeekIndex.hpp>
 #include <vorbis/vorbisfile.h>
 
 
@@ -105,8 +106,43 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Add the page fetched by the last decoding call to the seek index
+    ///
+    /// The Vorbis library fetches a new page only once all the
+    /// samples decoded before it have been returned, so the
+    /// positions taken right before that call tell which sample
+    /// decoding from the beginning of the page resumes at.
+    ///
+    /// \param frame    Sample frame position before the decoding call
+    /// \param position Stream position before the decoding call
+    ///
+    ////////////////////////////////////////////////////////////
+    void indexPosition(ogg_int64_t frame, ogg_int64_t position);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Jump to a sample frame from the closest entry of the seek index
+    ///
+    /// \param frame Index of the sample frame to jump to
+    ///
+    /// \return True on success, false if the index can't be used for \a frame
+    ///
+    ////////////////////////////////////////////////////////////
+    bool seekWithIndex(Uint64 frame);
+
     ////////////////////////////////////////////////////////////
     /// \brief Close the open Vorbis file
     ///
@@ -116,8 +152,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    OggVorbis_File m_vorbis;       // ogg/vorbis file handle
-    unsigned int   m_channelCount; // number of channels of the open sound file
+    OggVorbis_File m_vorbis;         // ogg/vorbis file handle
+    unsigned int   m_channelCount;   // number of channels of the open sound file
+    SeekIndex      m_seekIndex;      // stream positions of some of the Ogg pages
+    bool           m_indexable;      // can the stream be indexed (seekable, and not chained)?
 };
 
 } // namespace priv
@@ -32,6 +32,7 @@
 #include <cctype>
 #include <cassert>
 #include <cstring>
+#include <cstddef>
 
 
 namespace
@@ -39,12 +40,7 @@ namespace
     // The following functions read integers as little endian and
     // return them in the host byte order
 
-    bool decode(sf::InputStream& stream, sf::Uint8& value)
-    {
-         return stream.read(&value, sizeof(value)) == sizeof(value);
-    }
-
-    bool decode(sf::InputStream& stream, sf::Int16& value)
+    bool decode(sf::InputStream& stream, sf::Uint16& value)
     {
         unsigned char bytes[sizeof(value)];
         if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
@@ -55,48 +51,102 @@ namespace
         return true;
     }
 
-    bool decode(sf::InputStream& stream, sf::Uint16& value)
+    bool decode(sf::InputStream& stream, sf::Uint32& value)
     {
         unsigned char bytes[sizeof(value)];
         if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
             return false;
 
-        value = bytes[0] | (bytes[1] << 8);
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
 
         return true;
     }
 
-    bool decode24bit(sf::InputStream& stream, sf::Uint32& value)
+    // The following functions convert blocks of little endian samples
+    // to 16-bit signed integers or to normalized floating point numbers;
+    // they are simple loops without branches or calls, so that the
+    // compiler can vectorize them
+
+    void convert8bit(const unsigned char* bytes, sf::Int16* samples, std::size_t count)
     {
-        unsigned char bytes[3];
-        if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
-            return false;
+        for (std::size_t i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>((bytes[i] - 128) << 8);
+    }
 
-        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16);
+    void convert8bit(const unsigned char* bytes, float* samples, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            samples[i] = (bytes[i] - 128) / 128.f;
+    }
 
-        return true;
+    // 16, 24 and 32-bit samples are truncated to their 16 most significant bits,
+    // which are the last two bytes of each sample
+    template <std::size_t BytesPerSample>
+    void convertPcm(const unsigned char* bytes, sf::Int16* samples, std::size_t count)
+    {
+        bytes += BytesPerSample - 2;
+        for (std::size_t i = 0; i < count; ++i)
+            samples[i] = static_cast<sf::Int16>(bytes[i * BytesPerSample] | (bytes[i * BytesPerSample + 1] << 8));
     }
 
-    bool decode(sf::InputStream& stream, sf::Uint32& value)
+    // All the bits are kept when converting to floating point numbers
+    template <std::size_t BytesPerSample>
+    void convertPcm(const unsigned char* bytes, float* samples, std::size_t count)
     {
-        unsigned char bytes[sizeof(value)];
-        if (stream.read(bytes, sizeof(bytes)) != sizeof(bytes))
-            return false;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Uint32 value = 0;
+            for (std::size_t j = 0; j < BytesPerSample; ++j)
+                value |= static_cast<sf::Uint32>(bytes[i * BytesPerSample + j]) << (8 * (4 - BytesPerSample + j));
 
-        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (bytes[3] << 24);
+            samples[i] = static_cast<sf::Int32>(value) / 2147483648.f;
+        }
+    }
 
-        return true;
+    float decodeFloat(const unsigned char* bytes)
+    {
+        sf::Uint32 bits = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<sf::Uint32>(bytes[3]) << 24);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void convertFloat(const unsigned char* bytes, sf::Int16* samples, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // Clamp to the valid range (this also maps NaN to -1)
+            float value = decodeFloat(bytes + i * 4);
+            value = value < 1.f ? value : 1.f;
+            value = value > -1.f ? value : -1.f;
+            samples[i] = static_cast<sf::Int16>(value * 32767.f);
+        }
+    }
+
+    void convertFloat(const unsigned char* bytes, float* samples, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            samples[i] = decodeFloat(bytes + i * 4);
     }
 
     const sf::Uint64 mainChunkSize = 12;
 
     const sf::Uint16 waveFormatPcm = 1;
 
+    const sf::Uint16 waveFormatFloat = 3;
+
     const sf::Uint16 waveFormatExtensible= 65534;
 
     const char* waveSubformatPcm =
         "\x01\x00\x00\x00\x00\x00\x10\x00"
         "\x80\x00\x00\xAA\x00\x38\x9B\x71";
+
+    const char* waveSubformatFloat =
+        "\x03\x00\x00\x00\x00\x00\x10\x00"
+        "\x80\x00\x00\xAA\x00\x38\x9B\x71";
+
+    // Size of the block of raw data read from the stream at once
+    const std::size_t blockSize = 65536;
 }
 
 namespace sf
@@ -119,8 +169,10 @@ bool SoundFileReaderWav::check(InputStream& stream)
 SoundFileReaderWav::SoundFileReaderWav() :
 m_stream        (NULL),
 m_bytesPerSample(0),
+m_isFloat       (false),
 m_dataStart     (0),
-m_dataEnd       (0)
+m_dataEnd       (0),
+m_block         ()
 {
 }
 
@@ -151,66 +203,72 @@ void SoundFileReaderWav::seek(Uint64 sampleOffset)
 
 ////////////////////////////////////////////////////////////
 Uint64 SoundFileReaderWav::read(Int16* samples, Uint64 maxCount)
+{
+    return readSamples(samples, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 SoundFileReaderWav::read(float* samples, Uint64 maxCount)
+{
+    return readSamples(samples, maxCount);
+}
+
+
+////////////////////////////////////////////////////////////
+template <typename T>
+Uint64 SoundFileReaderWav::readSamples(T* samples, Uint64 maxCount)
 {
     assert(m_stream);
 
-    Uint64 count = 0;
-    Uint64 startPos = m_stream->tell();
+    Int64 position = m_stream->tell();
+    if (position == -1)
+        return 0;
 
     // Tracking of m_dataEnd is important to prevent sf::Music from reading
     // data until EOF, as WAV files may have metadata at the end.
-    while ((count < maxCount) && (startPos + count * m_bytesPerSample < m_dataEnd))
+    Uint64 startPos = static_cast<Uint64>(position);
+    if (startPos >= m_dataEnd)
+        return 0;
+    maxCount = std::min(maxCount, (m_dataEnd - startPos) / m_bytesPerSample);
+
+    // Read the raw data by blocks and convert them all at once, rather
+    // than sample by sample, to minimize the calls to the stream
+    if (m_block.empty())
+        m_block.resize(blockSize);
+    const std::size_t samplesPerBlock = blockSize / m_bytesPerSample;
+
+    // Select the conversion function matching the sample format
+    void (*convert)(const unsigned char*, T*, std::size_t) = NULL;
+    switch (m_bytesPerSample)
     {
-        switch (m_bytesPerSample)
-        {
-            case 1:
-            {
-                Uint8 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = (static_cast<Int16>(sample) - 128) << 8;
-                else
-                    return count;
-                break;
-            }
+        case 1:  convert = &convert8bit;   break;
+        case 2:  convert = &convertPcm<2>; break;
+        case 3:  convert = &convertPcm<3>; break;
+        case 4:  convert = &convertPcm<4>; break;
+        default: assert(false); return 0;
+    }
 
-            case 2:
-            {
-                Int16 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample;
-                else
-                    return count;
-                break;
-            }
+    if (m_isFloat)
+        convert = &convertFloat;
 
-            case 3:
-            {
-                Uint32 sample = 0;
-                if (decode24bit(*m_stream, sample))
-                    *samples++ = sample >> 8;
-                else
-                    return count;
-                break;
-            }
+    Uint64 count = 0;
+    while (count < maxCount)
+    {
+        std::size_t toRead = static_cast<std::size_t>(std::min<Uint64>(maxCount - count, samplesPerBlock));
+        Int64 bytesRead = m_stream->read(&m_block[0], toRead * m_bytesPerSample);
+        if (bytesRead <= 0)
+            break;
 
-            case 4:
-            {
-                Uint32 sample = 0;
-                if (decode(*m_stream, sample))
-                    *samples++ = sample >> 16;
-                else
-                    return count;
-                break;
-            }
+        // Only convert whole samples
+        std::size_t samplesRead = static_cast<std::size_t>(bytesRead) / m_bytesPerSample;
+        convert(&m_block[0], samples, samplesRead);
 
-            default:
-            {
-                assert(false);
-                return 0;
-            }
-        }
+        samples += samplesRead;
+        count += samplesRead;
 
-        ++count;
+        if (samplesRead < toRead)
+            break;
     }
 
     return count;
@@ -252,8 +310,9 @@ bool SoundFileReaderWav::parseHeader(Info& info)
             Uint16 format = 0;
             if (!decode(*m_stream, format))
                 return false;
-            if ((format != waveFormatPcm) && (format != waveFormatExtensible))
+            if ((format != waveFormatPcm) && (format != waveFormatFloat) && (format != waveFormatExtensible))
                 return false;
+            m_isFloat = (format == waveFormatFloat);
 
             // Channel count
             Uint16 channelCount = 0;
@@ -310,7 +369,11 @@ bool SoundFileReaderWav::parseHeader(Info& info)
                 if (m_stream->read(subformat, sizeof(subformat)) != sizeof(subformat))
                     return false;
 
-                if (std::memcmp(subformat, waveSubformatPcm, sizeof(subformat)) != 0)
+                if (std::memcmp(subformat, waveSubformatFloat, sizeof(subformat)) == 0)
+                {
+                    m_isFloat = true;
+                }
+                else if (std::memcmp(subformat, waveSubformatPcm, sizeof(subformat)) != 0)
                 {
                     err() << "Unsupported format: extensible format with non-PCM subformat" << std::endl;
                     return false;
@@ -324,6 +387,12 @@ bool SoundFileReaderWav::parseHeader(Info& info)
                 }
             }
 
+            if (m_isFloat && (bitsPerSample != 32))
+            {
+                err() << "Unsupported sample size: " << bitsPerSample << " bit floating point (Supported size is 32 bit)" << std::endl;
+                return false;
+            }
+
             // Skip potential extra information
             if (m_stream->seek(subChunkStart + subChunkSize) == -1)
                 return false;
@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundFileReader.hpp>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -97,6 +98,17 @@ public:
     ////////////////////////////////////////////////////////////
     virtual Uint64 read(Int16* samples, Uint64 maxCount);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples from the open file, as floating point numbers
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Uint64 read(float* samples, Uint64 maxCount);
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -109,13 +121,27 @@ private:
     ////////////////////////////////////////////////////////////
     bool parseHeader(Info& info);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Read audio samples and convert them to the requested type
+    ///
+    /// \param samples  Pointer to the sample array to fill
+    /// \param maxCount Maximum number of samples to read
+    ///
+    /// \return Number of samples actually read (may be less than \a maxCount)
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    Uint64 readSamples(T* samples, Uint64 maxCount);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    InputStream* m_stream;         ///< Source stream to read from
-    unsigned int m_bytesPerSample; ///< Size of a sample, in bytes
-    Uint64       m_dataStart;      ///< Starting position of the audio data in the open file
-    Uint64       m_dataEnd;        ///< Position one byte past the end of the audio data in the open file
+    InputStream*               m_stream;         ///< Source stream to read from
+    unsigned int               m_bytesPerSample; ///< Size of a sample, in bytes
+    bool                       m_isFloat;        ///< Are the samples stored as floating point numbers?
+    Uint64                     m_dataStart;      ///< Starting position of the audio data in the open file
+    Uint64                     m_dataEnd;        ///< Position one byte past the end of the audio data in the open file
+    std::vector<unsigned char> m_block;          ///< Scratch buffer receiving the raw data read from the stream
 };
 
 } // namespace priv
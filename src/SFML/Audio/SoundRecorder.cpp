@@ -28,8 +28,11 @@
 #include <SFML/Audio/SoundRecorder.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cstring>
 #include <cassert>
 
@@ -50,9 +53,14 @@ SoundRecorder::SoundRecorder() :
 m_thread            (&SoundRecorder::record, this),
 m_sampleRate        (0),
 m_processingInterval(milliseconds(100)),
+m_preciseProcessing (false),
 m_isCapturing       (false),
 m_deviceName        (getDefaultDevice()),
-m_channelCount      (1)
+m_channelCount      (1),
+m_lastRead          (Time::Zero),
+m_pendingFrames     (0),
+m_chunkCount        (0),
+m_overruns          (0)
 {
 
 }
@@ -98,8 +106,9 @@ bool SoundRecorder::start(unsigned int sampleRate)
         return false;
     }
 
-    // Clear the array of samples
-    m_samples.clear();
+    // Allocate the array of samples once for all, as large as the capture buffer
+    // (one second of audio), so that the capture loop never has to resize it
+    m_samples.resize(sampleRate * m_channelCount);
 
     // Store the sample rate
     m_sampleRate = sampleRate;
@@ -109,6 +118,8 @@ bool SoundRecorder::start(unsigned int sampleRate)
     {
         // Start the capture
         alcCaptureStart(captureDevice);
+        m_lastRead = Clock::now();
+        m_pendingFrames = 0;
 
         // Start the capture in a new thread, to avoid blocking the main thread
         m_isCapturing = true;
@@ -200,6 +211,8 @@ bool SoundRecorder::setDevice(const std::string& name)
 
         // Start the capture
         alcCaptureStart(captureDevice);
+        m_lastRead = Clock::now();
+        m_pendingFrames = 0;
 
         // Start the capture in a new thread, to avoid blocking the main thread
         m_isCapturing = true;
@@ -243,6 +256,47 @@ unsigned int SoundRecorder::getChannelCount() const
 }
 
 
+////////////////////////////////////////////////////////////
+CaptureStatistics SoundRecorder::getCaptureStatistics() const
+{
+    Lock lock(m_statisticsMutex);
+
+    CaptureStatistics statistics;
+    statistics.chunkCount = m_chunkCount;
+    statistics.overruns = m_overruns;
+
+    std::size_t count = static_cast<std::size_t>(std::min<Uint64>(m_chunkCount, HistorySize));
+    if (count == 0)
+        return statistics;
+
+    std::vector<Int64> delays(m_delays, m_delays + count);
+
+    Int64 total = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        total += delays[i];
+
+    // Smallest delay which is greater than or equal to 99% of the delays
+    std::size_t rank = (count * 99 + 99) / 100 - 1;
+    std::nth_element(delays.begin(), delays.begin() + rank, delays.end());
+
+    statistics.meanDelay = microseconds(total / static_cast<Int64>(count));
+    statistics.p99Delay  = microseconds(delays[rank]);
+    statistics.maxDelay  = microseconds(*std::max_element(delays.begin() + rank, delays.end()));
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundRecorder::resetCaptureStatistics()
+{
+    Lock lock(m_statisticsMutex);
+
+    m_chunkCount = 0;
+    m_overruns = 0;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::isAvailable()
 {
@@ -258,6 +312,13 @@ void SoundRecorder::setProcessingInterval(Time interval)
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::setPreciseProcessingEnabled(bool enabled)
+{
+    m_preciseProcessing = enabled;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool SoundRecorder::onStart()
 {
@@ -276,13 +337,26 @@ void SoundRecorder::onStop()
 ////////////////////////////////////////////////////////////
 void SoundRecorder::record()
 {
+    Time deadline = Clock::now();
+
     while (m_isCapturing)
     {
         // Process available samples
-        processCapturedSamples();
+        processCapturedSamples(Clock::now() - deadline);
+
+        // The deadlines follow a fixed grid so that the time spent processing the samples
+        // doesn't add up to the interval; if the processing is late by more than a whole
+        // interval, the grid restarts from now rather than processing tiny chunks in a row
+        Time now = Clock::now();
+        deadline += m_processingInterval;
+        if (deadline <= now)
+            deadline = now + m_processingInterval;
 
         // Don't bother the CPU while waiting for more captured data
-        sleep(m_processingInterval);
+        if (m_preciseProcessing)
+            spinUntil(deadline);
+        else
+            sleepUntil(deadline);
     }
 
     // Capture is finished: clean up everything
@@ -291,20 +365,33 @@ void SoundRecorder::record()
 
 
 ////////////////////////////////////////////////////////////
-void SoundRecorder::processCapturedSamples()
+void SoundRecorder::processCapturedSamples(Time delay)
 {
     // Get the number of samples available
     ALCint samplesAvailable;
     alcGetIntegerv(captureDevice, ALC_CAPTURE_SAMPLES, 1, &samplesAvailable);
 
+    // Samples were lost if the device captured more frames since the previous read
+    // than its buffer (as large as m_samples) could hold on top of the frames left there
+    Time now = Clock::now();
+    std::size_t capacity = m_samples.size() / m_channelCount;
+    Uint64 capturedFrames = static_cast<Uint64>((now - m_lastRead).asMicroseconds()) * m_sampleRate / 1000000;
+    bool overrun = (m_pendingFrames + capturedFrames > capacity);
+
+    m_lastRead = now;
+    m_pendingFrames = 0;
+
     if (samplesAvailable > 0)
     {
         // Get the recorded samples
-        m_samples.resize(samplesAvailable * getChannelCount());
-        alcCaptureSamples(captureDevice, &m_samples[0], samplesAvailable);
+        std::size_t frameCount = std::min(static_cast<std::size_t>(samplesAvailable), capacity);
+        alcCaptureSamples(captureDevice, &m_samples[0], static_cast<ALCsizei>(frameCount));
+        m_pendingFrames = static_cast<std::size_t>(samplesAvailable) - frameCount;
+
+        recordChunk(delay, overrun);
 
         // Forward them to the derived class
-        if (!onProcessSamples(&m_samples[0], m_samples.size()))
+        if (!onProcessSamples(&m_samples[0], frameCount * m_channelCount))
         {
             // The user wants to stop the capture
             m_isCapturing = false;
@@ -313,6 +400,19 @@ void SoundRecorder::processCapturedSamples()
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundRecorder::recordChunk(Time delay, bool overrun)
+{
+    Lock lock(m_statisticsMutex);
+
+    m_delays[m_chunkCount % HistorySize] = delay.asMicroseconds();
+    ++m_chunkCount;
+
+    if (overrun)
+        ++m_overruns;
+}
+
+
 ////////////////////////////////////////////////////////////
 void SoundRecorder::cleanup()
 {
@@ -320,7 +420,7 @@ void SoundRecorder::cleanup()
     alcCaptureStop(captureDevice);
 
     // Get the samples left in the buffer
-    processCapturedSamples();
+    processCapturedSamples(Time::Zero);
 
     // Close the device
     alcCaptureCloseDevice(captureDevice);
@@ -26,60 +26,120 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundSource.hpp>
+#include <SFML/Audio/VoiceManager.hpp>
 #include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace
+{
+    // Locks the mutex of the voice manager, but only for sources whose
+    // OpenAL source is assigned and released by the voice manager; the
+    // others (music, custom streams) own their source and don't need it
+    class AttributesLock : sf::NonCopyable
+    {
+    public:
+
+        explicit AttributesLock(bool managed) :
+        m_mutex(managed ? &sf::priv::VoiceManager::getMutex() : NULL)
+        {
+            if (m_mutex)
+                m_mutex->lock();
+        }
+
+        ~AttributesLock()
+        {
+            if (m_mutex)
+                m_mutex->unlock();
+        }
+
+    private:
+
+        sf::Mutex* m_mutex;
+    };
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
-SoundSource::SoundSource()
+SoundSource::SoundSource(bool createSource) :
+m_source            (0),
+m_pitch             (1.f),
+m_volume            (100.f),
+m_position          (0.f, 0.f, 0.f),
+m_relativeToListener(false),
+m_minDistance       (1.f),
+m_attenuation       (1.f),
+m_managed           (!createSource)
 {
-    alCheck(alGenSources(1, &m_source));
-    alCheck(alSourcei(m_source, AL_BUFFER, 0));
+    if (createSource)
+    {
+        alCheck(alGenSources(1, &m_source));
+        alCheck(alSourcei(m_source, AL_BUFFER, 0));
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
-SoundSource::SoundSource(const SoundSource& copy)
+SoundSource::SoundSource(const SoundSource& copy) :
+m_source            (0),
+m_pitch             (copy.m_pitch),
+m_volume            (copy.m_volume),
+m_position          (copy.m_position),
+m_relativeToListener(copy.m_relativeToListener),
+m_minDistance       (copy.m_minDistance),
+m_attenuation       (copy.m_attenuation),
+m_managed           (false)
 {
     alCheck(alGenSources(1, &m_source));
     alCheck(alSourcei(m_source, AL_BUFFER, 0));
-
-    setPitch(copy.getPitch());
-    setVolume(copy.getVolume());
-    setPosition(copy.getPosition());
-    setRelativeToListener(copy.isRelativeToListener());
-    setMinDistance(copy.getMinDistance());
-    setAttenuation(copy.getAttenuation());
+    applyAttributes();
 }
 
 
 ////////////////////////////////////////////////////////////
 SoundSource::~SoundSource()
 {
-    alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteSources(1, &m_source));
+    if (m_source)
+    {
+        alCheck(alSourcei(m_source, AL_BUFFER, 0));
+        alCheck(alDeleteSources(1, &m_source));
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setPitch(float pitch)
 {
-    alCheck(alSourcef(m_source, AL_PITCH, pitch));
+    AttributesLock lock(m_managed);
+
+    m_pitch = pitch;
+    if (m_source)
+        alCheck(alSourcef(m_source, AL_PITCH, pitch));
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setVolume(float volume)
 {
-    alCheck(alSourcef(m_source, AL_GAIN, volume * 0.01f));
+    AttributesLock lock(m_managed);
+
+    m_volume = volume;
+    if (m_source)
+        alCheck(alSourcef(m_source, AL_GAIN, volume * 0.01f));
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setPosition(float x, float y, float z)
 {
-    alCheck(alSource3f(m_source, AL_POSITION, x, y, z));
+    AttributesLock lock(m_managed);
+
+    m_position = Vector3f(x, y, z);
+    if (m_source)
+        alCheck(alSource3f(m_source, AL_POSITION, x, y, z));
 }
 
 
@@ -93,81 +153,75 @@ void SoundSource::setPosition(const Vector3f& position)
 ////////////////////////////////////////////////////////////
 void SoundSource::setRelativeToListener(bool relative)
 {
-    alCheck(alSourcei(m_source, AL_SOURCE_RELATIVE, relative));
+    AttributesLock lock(m_managed);
+
+    m_relativeToListener = relative;
+    if (m_source)
+        alCheck(alSourcei(m_source, AL_SOURCE_RELATIVE, relative));
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setMinDistance(float distance)
 {
-    alCheck(alSourcef(m_source, AL_REFERENCE_DISTANCE, distance));
+    AttributesLock lock(m_managed);
+
+    m_minDistance = distance;
+    if (m_source)
+        alCheck(alSourcef(m_source, AL_REFERENCE_DISTANCE, distance));
 }
 
 
 ////////////////////////////////////////////////////////////
 void SoundSource::setAttenuation(float attenuation)
 {
-    alCheck(alSourcef(m_source, AL_ROLLOFF_FACTOR, attenuation));
+    AttributesLock lock(m_managed);
+
+    m_attenuation = attenuation;
+    if (m_source)
+        alCheck(alSourcef(m_source, AL_ROLLOFF_FACTOR, attenuation));
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getPitch() const
 {
-    ALfloat pitch;
-    alCheck(alGetSourcef(m_source, AL_PITCH, &pitch));
-
-    return pitch;
+    return m_pitch;
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getVolume() const
 {
-    ALfloat gain;
-    alCheck(alGetSourcef(m_source, AL_GAIN, &gain));
-
-    return gain * 100.f;
+    return m_volume;
 }
 
 
 ////////////////////////////////////////////////////////////
 Vector3f SoundSource::getPosition() const
 {
-    Vector3f position;
-    alCheck(alGetSource3f(m_source, AL_POSITION, &position.x, &position.y, &position.z));
-
-    return position;
+    return m_position;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool SoundSource::isRelativeToListener() const
 {
-    ALint relative;
-    alCheck(alGetSourcei(m_source, AL_SOURCE_RELATIVE, &relative));
-
-    return relative != 0;
+    return m_relativeToListener;
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getMinDistance() const
 {
-    ALfloat distance;
-    alCheck(alGetSourcef(m_source, AL_REFERENCE_DISTANCE, &distance));
-
-    return distance;
+    return m_minDistance;
 }
 
 
 ////////////////////////////////////////////////////////////
 float SoundSource::getAttenuation() const
 {
-    ALfloat attenuation;
-    alCheck(alGetSourcef(m_source, AL_ROLLOFF_FACTOR, &attenuation));
-
-    return attenuation;
+    return m_attenuation;
 }
 
 
@@ -192,6 +246,9 @@ SoundSource& SoundSource::operator =(const SoundSource& right)
 ////////////////////////////////////////////////////////////
 SoundSource::Status SoundSource::getStatus() const
 {
+    if (!m_source)
+        return Stopped;
+
     ALint status;
     alCheck(alGetSourcei(m_source, AL_SOURCE_STATE, &status));
 
@@ -206,4 +263,16 @@ SoundSource::Status SoundSource::getStatus() const
     return Stopped;
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundSource::applyAttributes()
+{
+    alCheck(alSourcef(m_source, AL_PITCH, m_pitch));
+    alCheck(alSourcef(m_source, AL_GAIN, m_volume * 0.01f));
+    alCheck(alSource3f(m_source, AL_POSITION, m_position.x, m_position.y, m_position.z));
+    alCheck(alSourcei(m_source, AL_SOURCE_RELATIVE, m_relativeToListener));
+    alCheck(alSourcef(m_source, AL_REFERENCE_DISTANCE, m_minDistance));
+    alCheck(alSourcef(m_source, AL_ROLLOFF_FACTOR, m_attenuation));
+}
+
 } // namespace sf
@@ -26,34 +26,45 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Audio/SoundStream.hpp>
+#include <SFML/Audio/SoundStreamScheduler.hpp>
 #include <SFML/Audio/AudioDevice.hpp>
 #include <SFML/Audio/ALCheck.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Lock.hpp>
+#include <algorithm>
 
-#ifdef _MSC_VER
-    #pragma warning(disable: 4355) // 'this' used in base member initializer list
-#endif
+
+namespace
+{
+    // Minimum delay between two updates of a playing stream, so that
+    // the streaming thread doesn't spin while OpenAL catches up
+    const sf::Time minUpdateDelay = sf::milliseconds(1);
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 SoundStream::SoundStream() :
-m_thread          (&SoundStream::streamData, this),
 m_threadMutex     (),
+m_updateMutex     (),
 m_threadStartState(Stopped),
 m_isStreaming     (false),
+m_requestStop     (false),
 m_buffers         (),
+m_bufferCount     (3),
+m_bufferDuration  (seconds(1)),
+m_queueHead       (0),
 m_channelCount    (0),
 m_sampleRate      (0),
 m_format          (0),
+m_floatFormat     (0),
+m_convertedSamples(),
 m_loop            (false),
 m_samplesProcessed(0),
 m_bufferSeeks     ()
 {
-
+    priv::SoundStreamScheduler::acquire();
 }
 
 
@@ -62,14 +73,17 @@ SoundStream::~SoundStream()
 {
     // Stop the sound if it was playing
 
-    // Request the thread to terminate
+    // Request the streaming to terminate
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait for the current update to finish, if any
+    priv::SoundStreamScheduler::unschedule(this);
+    releaseBuffers();
+
+    priv::SoundStreamScheduler::release();
 }
 
 
@@ -81,8 +95,9 @@ void SoundStream::initialize(unsigned int channelCount, unsigned int sampleRate)
     m_samplesProcessed = 0;
     m_isStreaming = false;
 
-    // Deduce the format from the number of channels
+    // Deduce the formats from the number of channels
     m_format = priv::AudioDevice::getFormatFromChannelCount(channelCount);
+    m_floatFormat = priv::AudioDevice::getFloatFormatFromChannelCount(channelCount);
 
     // Check if the format is valid
     if (m_format == 0)
@@ -118,9 +133,14 @@ void SoundStream::play()
     if (isStreaming && (threadStartState == Paused))
     {
         // If the sound is paused, resume it
-        Lock lock(m_threadMutex);
-        m_threadStartState = Playing;
-        alCheck(alSourcePlay(m_source));
+        {
+            Lock lock(m_threadMutex);
+            m_threadStartState = Playing;
+            alCheck(alSourcePlay(m_source));
+        }
+
+        // The next buffer to refill has changed
+        priv::SoundStreamScheduler::schedule(this);
         return;
     }
     else if (isStreaming && (threadStartState == Playing))
@@ -129,10 +149,14 @@ void SoundStream::play()
         stop();
     }
 
-    // Start updating the stream in a separate thread to avoid blocking the application
-    m_isStreaming = true;
-    m_threadStartState = Playing;
-    m_thread.launch();
+    // Start updating the stream in the streaming thread to avoid blocking the application
+    {
+        Lock lock(m_threadMutex);
+        m_isStreaming = true;
+        m_threadStartState = Playing;
+    }
+
+    priv::SoundStreamScheduler::schedule(this);
 }
 
 
@@ -156,14 +180,15 @@ void SoundStream::pause()
 ////////////////////////////////////////////////////////////
 void SoundStream::stop()
 {
-    // Request the thread to terminate
+    // Request the streaming to terminate
     {
         Lock lock(m_threadMutex);
         m_isStreaming = false;
     }
 
-    // Wait for the thread to terminate
-    m_thread.wait();
+    // Wait for the current update to finish, if any
+    priv::SoundStreamScheduler::unschedule(this);
+    releaseBuffers();
 
     // Move to the beginning
     onSeek(Time::Zero);
@@ -220,9 +245,13 @@ void SoundStream::setPlayingOffset(Time timeOffset)
     if (oldStatus == Stopped)
         return;
 
-    m_isStreaming = true;
-    m_threadStartState = oldStatus;
-    m_thread.launch();
+    {
+        Lock lock(m_threadMutex);
+        m_isStreaming = true;
+        m_threadStartState = oldStatus;
+    }
+
+    priv::SoundStreamScheduler::schedule(this);
 }
 
 
@@ -257,6 +286,48 @@ bool SoundStream::getLoop() const
 }
 
 
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferCount(unsigned int count)
+{
+    m_bufferCount = std::max(count, 2u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getBufferCount() const
+{
+    return m_bufferCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setBufferDuration(Time duration)
+{
+    m_bufferDuration = duration;
+}
+
+
+////////////////////////////////////////////////////////////
+Time SoundStream::getBufferDuration() const
+{
+    return m_bufferDuration;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStream::setStreamingThreadCount(unsigned int count)
+{
+    priv::SoundStreamScheduler::setThreadCount(count);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStream::getStreamingThreadCount()
+{
+    return priv::SoundStreamScheduler::getThreadCount();
+}
+
+
 ////////////////////////////////////////////////////////////
 Int64 SoundStream::onLoop()
 {
@@ -266,139 +337,185 @@ Int64 SoundStream::onLoop()
 
 
 ////////////////////////////////////////////////////////////
-void SoundStream::streamData()
+bool SoundStream::streamData(Time& delay, Time& remaining)
 {
-    bool requestStop = false;
-
+    // Start the stream on the first update
+    if (m_buffers.empty())
     {
-        Lock lock(m_threadMutex);
-
-        // Check if the thread was launched Stopped
-        if (m_threadStartState == Stopped)
         {
-            m_isStreaming = false;
-            return;
+            Lock lock(m_threadMutex);
+
+            // Check if the stream was started Stopped
+            if (m_threadStartState == Stopped)
+            {
+                m_isStreaming = false;
+                return false;
+            }
         }
-    }
 
-    // Create the buffers
-    alCheck(alGenBuffers(BufferCount, m_buffers));
-    for (int i = 0; i < BufferCount; ++i)
-        m_bufferSeeks[i] = NoLoop;
+        // Create the buffers
+        m_buffers.resize(m_bufferCount);
+        m_bufferSeeks.assign(m_bufferCount, NoLoop);
+        alCheck(alGenBuffers(static_cast<ALsizei>(m_buffers.size()), &m_buffers[0]));
 
-    // Fill the queue
-    requestStop = fillQueue();
+        // Fill the queue
+        m_queueHead = 0;
+        m_requestStop = fillQueue();
 
-    // Play the sound
-    alCheck(alSourcePlay(m_source));
+        // Play the sound
+        alCheck(alSourcePlay(m_source));
+
+        {
+            Lock lock(m_threadMutex);
+
+            // Check if the stream was started Paused
+            if (m_threadStartState == Paused)
+                alCheck(alSourcePause(m_source));
+        }
+    }
 
     {
         Lock lock(m_threadMutex);
-
-        // Check if the thread was launched Paused
-        if (m_threadStartState == Paused)
-            alCheck(alSourcePause(m_source));
+        if (!m_isStreaming)
+        {
+            releaseBuffers();
+            return false;
+        }
     }
 
-    for (;;)
+    // The stream has been interrupted!
+    if (SoundSource::getStatus() == Stopped)
     {
+        if (!m_requestStop)
         {
+            // Just continue
+            alCheck(alSourcePlay(m_source));
+        }
+        else
+        {
+            // End streaming
             Lock lock(m_threadMutex);
-            if (!m_isStreaming)
-                break;
+            m_isStreaming = false;
         }
+    }
 
-        // The stream has been interrupted!
-        if (SoundSource::getStatus() == Stopped)
-        {
-            if (!requestStop)
-            {
-                // Just continue
-                alCheck(alSourcePlay(m_source));
-            }
-            else
+    // Get the number of buffers that have been processed (i.e. ready for reuse)
+    ALint nbProcessed = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+
+    while (nbProcessed--)
+    {
+        // Pop the first unused buffer from the queue
+        ALuint buffer;
+        alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
+
+        // Find its number
+        unsigned int bufferNum = 0;
+        for (std::size_t i = 0; i < m_buffers.size(); ++i)
+            if (m_buffers[i] == buffer)
             {
-                // End streaming
-                Lock lock(m_threadMutex);
-                m_isStreaming = false;
+                bufferNum = static_cast<unsigned int>(i);
+                break;
             }
-        }
 
-        // Get the number of buffers that have been processed (i.e. ready for reuse)
-        ALint nbProcessed = 0;
-        alCheck(alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nbProcessed));
+        // Buffers are always queued again in the same order
+        m_queueHead = (bufferNum + 1) % static_cast<unsigned int>(m_buffers.size());
 
-        while (nbProcessed--)
+        // Retrieve its size and add it to the samples count
+        if (m_bufferSeeks[bufferNum] != NoLoop)
         {
-            // Pop the first unused buffer from the queue
-            ALuint buffer;
-            alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
-
-            // Find its number
-            unsigned int bufferNum = 0;
-            for (int i = 0; i < BufferCount; ++i)
-                if (m_buffers[i] == buffer)
-                {
-                    bufferNum = i;
-                    break;
-                }
+            // This was the last buffer before EOF or Loop End: reset the sample count
+            m_samplesProcessed = m_bufferSeeks[bufferNum];
+            m_bufferSeeks[bufferNum] = NoLoop;
+        }
+        else
+        {
+            ALint size, bits;
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
 
-            // Retrieve its size and add it to the samples count
-            if (m_bufferSeeks[bufferNum] != NoLoop)
+            // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
+            if (bits == 0)
             {
-                // This was the last buffer before EOF or Loop End: reset the sample count
-                m_samplesProcessed = m_bufferSeeks[bufferNum];
-                m_bufferSeeks[bufferNum] = NoLoop;
+                err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
+                      << "and initialize() has been called correctly" << std::endl;
+
+                // Abort streaming
+                Lock lock(m_threadMutex);
+                m_isStreaming = false;
+                m_requestStop = true;
+                break;
             }
             else
             {
-                ALint size, bits;
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                // Bits can be 0 if the format or parameters are corrupt, avoid division by zero
-                if (bits == 0)
-                {
-                    err() << "Bits in sound stream are 0: make sure that the audio format is not corrupt "
-                          << "and initialize() has been called correctly" << std::endl;
-
-                    // Abort streaming (exit main loop)
-                    Lock lock(m_threadMutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += size / (bits / 8);
-                }
+                m_samplesProcessed += size / (bits / 8);
             }
+        }
 
-            // Fill it and push it back into the playing queue
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferNum))
-                    requestStop = true;
-            }
+        // Fill it and push it back into the playing queue
+        if (!m_requestStop)
+        {
+            if (fillAndPushBuffer(bufferNum))
+                m_requestStop = true;
         }
+    }
 
-        // Leave some time for the other threads if the stream is still playing
-        if (SoundSource::getStatus() != Stopped)
-            sleep(milliseconds(10));
+    {
+        Lock lock(m_threadMutex);
+        if (!m_isStreaming)
+        {
+            releaseBuffers();
+            return false;
+        }
     }
 
-    // Stop the playback
-    alCheck(alSourceStop(m_source));
+    // Wait until the buffer at the head of the queue has been played
+    delay = minUpdateDelay;
+    remaining = Time::Zero;
 
-    // Dequeue any buffer left in the queue
-    clearQueue();
+    ALint nbQueued = 0;
+    alCheck(alGetSourcei(m_source, AL_BUFFERS_QUEUED, &nbQueued));
 
-    // Reset the playing position
-    m_samplesProcessed = 0;
+    Status status = SoundSource::getStatus();
+    if (status == Paused)
+    {
+        // Nothing is played until the stream is resumed, which
+        // schedules it again; just check it from time to time
+        delay = std::max(m_bufferDuration, delay);
+        remaining = delay;
+    }
+    else if ((status == Playing) && (nbQueued > 0) && (m_sampleRate > 0))
+    {
+        ALint offset;
+        alCheck(alGetSourcei(m_source, AL_SAMPLE_OFFSET, &offset));
 
-    // Delete the buffers
-    alCheck(alSourcei(m_source, AL_BUFFER, 0));
-    alCheck(alDeleteBuffers(BufferCount, m_buffers));
+        // Count the frames of the queued buffers, starting with the head
+        Int64 headFrames = 0;
+        Int64 queuedFrames = 0;
+        for (ALint i = 0; i < nbQueued; ++i)
+        {
+            unsigned int buffer = m_buffers[(m_queueHead + i) % m_buffers.size()];
+
+            ALint size, bits, channels;
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+            alCheck(alGetBufferi(buffer, AL_CHANNELS, &channels));
+
+            if ((bits > 0) && (channels > 0))
+                queuedFrames += size / (bits / 8) / channels;
+
+            if (i == 0)
+                headFrames = queuedFrames;
+        }
+
+        if (headFrames > offset)
+            delay = std::max(microseconds((headFrames - offset) * 1000000 / m_sampleRate), delay);
+
+        if (queuedFrames > offset)
+            remaining = microseconds((queuedFrames - offset) * 1000000 / m_sampleRate);
+    }
+
+    return true;
 }
 
 
@@ -408,14 +525,14 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
     bool requestStop = false;
 
     // Acquire audio data, also address EOF and error cases if they occur
-    Chunk data = {NULL, 0};
+    Chunk data = {NULL, 0, NULL};
     for (Uint32 retryCount = 0; !onGetData(data) && (retryCount < BufferRetries); ++retryCount)
     {
         // Check if the stream must loop or stop
         if (!m_loop)
         {
             // Not looping: Mark this buffer as ending with 0 and request stop
-            if (data.samples != NULL && data.sampleCount != 0)
+            if ((data.samples != NULL || data.floatSamples != NULL) && data.sampleCount != 0)
                 m_bufferSeeks[bufferNum] = 0;
             requestStop = true;
             break;
@@ -426,7 +543,7 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
         m_bufferSeeks[bufferNum] = onLoop();
 
         // If we got data, break and process it, else try to fill the buffer once again
-        if (data.samples != NULL && data.sampleCount != 0)
+        if ((data.samples != NULL || data.floatSamples != NULL) && data.sampleCount != 0)
             break;
 
         // If immediateLoop is specified, we have to immediately adjust the sample count
@@ -441,13 +558,38 @@ bool SoundStream::fillAndPushBuffer(unsigned int bufferNum, bool immediateLoop)
     }
 
     // Fill the buffer if some data was returned
-    if (data.samples && data.sampleCount)
+    if ((data.samples || data.floatSamples) && data.sampleCount)
     {
         unsigned int buffer = m_buffers[bufferNum];
 
         // Fill the buffer
-        ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
-        alCheck(alBufferData(buffer, m_format, data.samples, size, m_sampleRate));
+        if (data.floatSamples && m_floatFormat)
+        {
+            ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(float);
+            alCheck(alBufferData(buffer, m_floatFormat, data.floatSamples, size, m_sampleRate));
+        }
+        else
+        {
+            const Int16* samples = data.samples;
+
+            // Floating point buffers are not supported: convert the samples to 16 bits
+            if (data.floatSamples)
+            {
+                m_convertedSamples.resize(data.sampleCount);
+                for (std::size_t i = 0; i < data.sampleCount; ++i)
+                {
+                    float value = data.floatSamples[i];
+                    value = value < 1.f ? value : 1.f;
+                    value = value > -1.f ? value : -1.f;
+                    m_convertedSamples[i] = static_cast<Int16>(value * 32767.f);
+                }
+
+                samples = &m_convertedSamples[0];
+            }
+
+            ALsizei size = static_cast<ALsizei>(data.sampleCount) * sizeof(Int16);
+            alCheck(alBufferData(buffer, m_format, samples, size, m_sampleRate));
+        }
 
         // Push it into the sound queue
         alCheck(alSourceQueueBuffers(m_source, 1, &buffer));
@@ -467,7 +609,7 @@ bool SoundStream::fillQueue()
 {
     // Fill and enqueue all the available buffers
     bool requestStop = false;
-    for (int i = 0; (i < BufferCount) && !requestStop; ++i)
+    for (unsigned int i = 0; (i < m_buffers.size()) && !requestStop; ++i)
     {
         // Since no sound has been loaded yet, we can't schedule loop seeks preemptively,
         // So if we start on EOF or Loop End, we let fillAndPushBuffer() adjust the sample count
@@ -492,4 +634,26 @@ void SoundStream::clearQueue()
         alCheck(alSourceUnqueueBuffers(m_source, 1, &buffer));
 }
 
+
+////////////////////////////////////////////////////////////
+void SoundStream::releaseBuffers()
+{
+    if (m_buffers.empty())
+        return;
+
+    // Stop the playback
+    alCheck(alSourceStop(m_source));
+
+    // Dequeue any buffer left in the queue
+    clearQueue();
+
+    // Reset the playing position
+    m_samplesProcessed = 0;
+
+    // Delete the buffers
+    alCheck(alSourcei(m_source, AL_BUFFER, 0));
+    alCheck(alDeleteBuffers(static_cast<ALsizei>(m_buffers.size()), &m_buffers[0]));
+    m_buffers.clear();
+}
+
 } // namespace sf
@@ -0,0 +1,324 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/SoundStreamScheduler.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <limits>
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace
+{
+    // Sound streams counter and its mutex
+    unsigned int count = 0;
+    sf::Mutex mutex;
+
+    // The scheduler is created with the first sound stream and
+    // destroyed with the last one, like the audio device
+    sf::priv::SoundStreamScheduler* globalScheduler = NULL;
+
+    // Number of streaming threads
+    unsigned int threadCount = 2;
+
+    // Deadline of the streams that are being updated
+    const sf::Time pending = sf::microseconds(std::numeric_limits<sf::Int64>::max());
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::acquire()
+{
+    Lock lock(mutex);
+
+    if (count == 0)
+        globalScheduler = new SoundStreamScheduler;
+
+    count++;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::release()
+{
+    Lock lock(mutex);
+
+    count--;
+
+    if (count == 0)
+    {
+        delete globalScheduler;
+        globalScheduler = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::schedule(SoundStream* stream)
+{
+    {
+        Lock lock(globalScheduler->m_mutex);
+
+        std::vector<Entry>& entries = globalScheduler->m_entries;
+
+        std::vector<Entry>::iterator it = entries.begin();
+        while ((it != entries.end()) && (it->stream != stream))
+            ++it;
+
+        if (it == entries.end())
+        {
+            Entry entry = {stream, Time::Zero, Time::Zero, false};
+            entries.push_back(entry);
+        }
+        else
+        {
+            // If the stream is being updated, this makes it
+            // updated again right after
+            it->deadline = Time::Zero;
+            it->starvation = Time::Zero;
+        }
+    }
+
+    globalScheduler->m_wakeUp.post();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::unschedule(SoundStream* stream)
+{
+    {
+        Lock lock(globalScheduler->m_mutex);
+
+        std::vector<Entry>& entries = globalScheduler->m_entries;
+
+        for (std::vector<Entry>::iterator it = entries.begin(); it != entries.end(); ++it)
+        {
+            if (it->stream == stream)
+            {
+                entries.erase(it);
+                break;
+            }
+        }
+    }
+
+    // The streaming threads hold the update mutex of the stream
+    // during its update: wait until it is finished
+    Lock lock(stream->m_updateMutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::setThreadCount(unsigned int count)
+{
+    Lock lock(mutex);
+
+    threadCount = std::max(count, 1u);
+
+    // Restart the threads of the existing scheduler
+    if (globalScheduler && (globalScheduler->m_threads.size() != threadCount))
+    {
+        globalScheduler->terminateThreads();
+        globalScheduler->launchThreads(threadCount);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoundStreamScheduler::getThreadCount()
+{
+    Lock lock(mutex);
+
+    return threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStreamScheduler::SoundStreamScheduler() :
+m_threads  (),
+m_mutex    (),
+m_wakeUp   (),
+m_entries  (),
+m_isRunning(false)
+{
+    launchThreads(threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+SoundStreamScheduler::~SoundStreamScheduler()
+{
+    terminateThreads();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::launchThreads(unsigned int count)
+{
+    m_isRunning = true;
+
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        m_threads.push_back(new Thread(&SoundStreamScheduler::run, this));
+        m_threads.back()->launch();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::terminateThreads()
+{
+    // Request the threads to terminate
+    {
+        Lock lock(m_mutex);
+        m_isRunning = false;
+    }
+
+    for (std::size_t i = 0; i < m_threads.size(); ++i)
+        m_wakeUp.post();
+
+    // Wait for the threads to terminate
+    for (std::size_t i = 0; i < m_threads.size(); ++i)
+    {
+        m_threads[i]->wait();
+        delete m_threads[i];
+    }
+
+    m_threads.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void SoundStreamScheduler::run()
+{
+    m_mutex.lock();
+
+    while (m_isRunning)
+    {
+        Time now = Clock::now();
+
+        // Among the streams that must be updated, find the one which
+        // will run out of audio first; find the next deadline too
+        std::vector<Entry>::iterator next = m_entries.end();
+        Time nextDeadline = pending;
+        std::size_t dueCount = 0;
+
+        for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->isUpdating)
+                continue;
+
+            if (it->deadline <= now)
+            {
+                if ((next == m_entries.end()) || (it->starvation < next->starvation))
+                    next = it;
+
+                ++dueCount;
+            }
+            else if (it->deadline < nextDeadline)
+            {
+                nextDeadline = it->deadline;
+            }
+        }
+
+        // Nothing to do: sleep until the next deadline, unless
+        // a stream is scheduled meanwhile
+        if (next == m_entries.end())
+        {
+            m_mutex.unlock();
+
+            if (nextDeadline == pending)
+                m_wakeUp.wait();
+            else
+                m_wakeUp.wait(nextDeadline - now);
+
+            m_mutex.lock();
+            continue;
+        }
+
+        // Let another thread update the other streams meanwhile
+        if (dueCount > 1)
+            m_wakeUp.post();
+
+        // Update the stream outside of the scheduler lock, so
+        // that the other streams can be scheduled meanwhile
+        SoundStream* stream = next->stream;
+        next->deadline = pending;
+        next->isUpdating = true;
+
+        stream->m_updateMutex.lock();
+        m_mutex.unlock();
+
+        Time delay;
+        Time remaining;
+        bool isStreaming = stream->streamData(delay, remaining);
+
+        m_mutex.lock();
+        stream->m_updateMutex.unlock();
+
+        // Schedule the next update, unless the stream was removed or
+        // has ended; a request received meanwhile takes precedence
+        now = Clock::now();
+        for (std::vector<Entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if ((it->stream == stream) && it->isUpdating)
+            {
+                it->isUpdating = false;
+
+                if (it->deadline == pending)
+                {
+                    if (isStreaming)
+                    {
+                        it->deadline = now + delay;
+                        it->starvation = now + remaining;
+                    }
+                    else
+                    {
+                        m_entries.erase(it);
+                    }
+                }
+
+                break;
+            }
+        }
+    }
+
+    m_mutex.unlock();
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOUNDSTREAMSCHEDULER_HPP
+#define SFML_SOUNDSTREAMSCHEDULER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class SoundStream;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Pool of background threads shared by all the sound
+///        streams, which refill each stream when one of its
+///        buffers has been played
+///
+////////////////////////////////////////////////////////////
+class SoundStreamScheduler : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new sound stream instance
+    ///
+    /// The scheduler is created with the first instance,
+    /// and destroyed with the last one.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a sound stream instance
+    ///
+    ////////////////////////////////////////////////////////////
+    static void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Request an update of a stream as soon as possible
+    ///
+    /// The stream is added to the scheduled streams if it
+    /// is not already part of them.
+    ///
+    /// \param stream Stream to update
+    ///
+    ////////////////////////////////////////////////////////////
+    static void schedule(SoundStream* stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a stream from the scheduled streams
+    ///
+    /// If the stream is being updated, this function waits
+    /// until the update is finished.
+    ///
+    /// \param stream Stream to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    static void unschedule(SoundStream* stream);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the number of streaming threads
+    ///
+    /// \param count Number of threads (at least 1)
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of streaming threads
+    ///
+    /// \return Number of threads
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getThreadCount();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Launches the streaming threads.
+    ///
+    ////////////////////////////////////////////////////////////
+    SoundStreamScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the streaming threads to terminate.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoundStreamScheduler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Launch the streaming threads
+    ///
+    /// \param count Number of threads to launch
+    ///
+    ////////////////////////////////////////////////////////////
+    void launchThreads(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Terminate the streaming threads
+    ///
+    /// The updates in progress are completed first.
+    ///
+    ////////////////////////////////////////////////////////////
+    void terminateThreads();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the threads
+    ///
+    /// This function updates the streams when their deadline
+    /// expires, the ones closest to running out of audio first,
+    /// and sleeps until the next deadline otherwise.
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure describing a scheduled stream
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Entry
+    {
+        SoundStream* stream;     ///< Scheduled stream
+        Time         deadline;   ///< Time at which the stream must be updated (see Clock::now)
+        Time         starvation; ///< Time at which the stream will have played all its queued audio
+        bool         isUpdating; ///< Whether a thread is updating the stream
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Thread*> m_threads;   ///< Streaming threads
+    Mutex                m_mutex;     ///< Mutex protecting the entries
+    Semaphore            m_wakeUp;    ///< Semaphore posted to wake up a thread before its next deadline
+    std::vector<Entry>   m_entries;   ///< Scheduled streams
+    bool                 m_isRunning; ///< Whether the threads must keep running
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_SOUNDSTREAMSCHEDULER_HPP
@@ -0,0 +1,377 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Audio/VoiceManager.hpp>
+#include <SFML/Audio/AudioDevice.hpp>
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/Audio/ALCheck.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+    #pragma warning(disable: 4355) // 'this' used in base member initializer list
+#endif
+
+
+namespace
+{
+    // Sounds counter, and mutex protecting the sounds and their voices
+    unsigned int count = 0;
+    sf::Mutex mutex;
+
+    // The voice manager is created with the first sound and
+    // destroyed with the last one, like the audio device
+    sf::priv::VoiceManager* globalManager = NULL;
+
+    // Maximum number of voices
+    unsigned int voiceCount = 128;
+
+    // Period of the updates while some sounds are played virtually
+    const sf::Time updateInterval = sf::milliseconds(50);
+
+    // Sounds that already have a voice are considered slightly
+    // more audible, so that sounds of similar audibility don't
+    // keep exchanging their voices
+    const float voiceBonus = 1.25f;
+
+    // Sound competing for a voice
+    struct Candidate
+    {
+        float      priority;
+        float      audibility;
+        sf::Sound* sound;
+    };
+
+    // Sort the candidates, the one that deserves a voice the most first
+    struct CandidateCompare
+    {
+        bool operator ()(const Candidate& left, const Candidate& right) const
+        {
+            if (left.priority != right.priority)
+                return left.priority > right.priority;
+
+            return left.audibility > right.audibility;
+        }
+    };
+
+    // Estimate the gain with which a sound is heard, following
+    // the attenuation model of OpenAL (inverse distance clamped)
+    float computeAudibility(const sf::Sound& sound, const sf::Vector3f& listener)
+    {
+        sf::Vector3f offset = sound.getPosition();
+        if (!sound.isRelativeToListener())
+            offset -= listener;
+
+        float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+        float minDistance = sound.getMinDistance();
+        float gain = sound.getVolume() * 0.01f;
+
+        if ((distance > minDistance) && (minDistance > 0.f))
+            gain *= minDistance / (minDistance + sound.getAttenuation() * (distance - minDistance));
+
+        return gain;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void VoiceManager::acquire()
+{
+    Lock lock(mutex);
+
+    if (count == 0)
+        globalManager = new VoiceManager;
+
+    count++;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::release()
+{
+    VoiceManager* manager = NULL;
+
+    {
+        Lock lock(mutex);
+
+        count--;
+
+        if (count == 0)
+        {
+            manager = globalManager;
+            globalManager = NULL;
+        }
+    }
+
+    // Destroy the manager outside of the lock, its thread may be waiting for it
+    delete manager;
+}
+
+
+////////////////////////////////////////////////////////////
+Mutex& VoiceManager::getMutex()
+{
+    return mutex;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::play(Sound* sound)
+{
+    Lock lock(mutex);
+
+    globalManager->m_sounds.insert(sound);
+
+    if (!sound->m_source)
+    {
+        unsigned int voice = globalManager->takeVoice();
+
+        // If all the voices are used, let the thread decide
+        // whether this sound deserves one more than the others
+        if (voice)
+            sound->attachVoice(voice);
+        else
+            globalManager->m_wakeUp.post();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::stop(Sound* sound)
+{
+    Lock lock(mutex);
+
+    globalManager->m_sounds.erase(sound);
+
+    if (sound->m_source)
+        globalManager->giveVoiceBack(sound);
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::setVoiceCount(unsigned int count)
+{
+    Lock lock(mutex);
+
+    voiceCount = count;
+
+    // Let the thread redistribute the voices
+    if (globalManager)
+        globalManager->m_wakeUp.post();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VoiceManager::getVoiceCount()
+{
+    Lock lock(mutex);
+
+    return voiceCount;
+}
+
+
+////////////////////////////////////////////////////////////
+VoiceManager::VoiceManager() :
+m_thread    (&VoiceManager::run, this),
+m_wakeUp    (),
+m_sounds    (),
+m_voices    (),
+m_freeVoices(),
+m_isRunning (true)
+{
+    m_thread.launch();
+}
+
+
+////////////////////////////////////////////////////////////
+VoiceManager::~VoiceManager()
+{
+    // Request the thread to terminate
+    {
+        Lock lock(mutex);
+        m_isRunning = false;
+    }
+
+    m_wakeUp.post();
+
+    // Wait for the thread to terminate
+    m_thread.wait();
+
+    // All the sounds are stopped by now, all the voices are free
+    if (!m_voices.empty())
+        alCheck(alDeleteSources(static_cast<ALsizei>(m_voices.size()), &m_voices[0]));
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VoiceManager::takeVoice()
+{
+    if (!m_freeVoices.empty())
+    {
+        unsigned int voice = m_freeVoices.back();
+        m_freeVoices.pop_back();
+        return voice;
+    }
+
+    if (m_voices.size() >= voiceCount)
+        return 0;
+
+    // OpenAL implementations limit the number of sources, reaching
+    // this limit is not an error but means that no voice is left
+    alGetError();
+
+    ALuint voice = 0;
+    alGenSources(1, &voice);
+
+    if (alGetError() != AL_NO_ERROR)
+        return 0;
+
+    m_voices.push_back(voice);
+
+    return voice;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::giveVoiceBack(Sound* sound)
+{
+    m_freeVoices.push_back(sound->detachVoice());
+}
+
+
+////////////////////////////////////////////////////////////
+bool VoiceManager::update()
+{
+    Vector3f listener = AudioDevice::getPosition();
+
+    // Forget the sounds that have ended, and rate the others
+    std::vector<Candidate> candidates;
+    candidates.reserve(m_sounds.size());
+
+    for (std::set<Sound*>::iterator it = m_sounds.begin(); it != m_sounds.end();)
+    {
+        Sound* sound = *it;
+        Sound::Status status = sound->getStatus();
+
+        if (status == Sound::Stopped)
+        {
+            sound->m_status = Sound::Stopped;
+            sound->m_offset = Time::Zero;
+
+            if (sound->m_source)
+                giveVoiceBack(sound);
+
+            m_sounds.erase(it++);
+            continue;
+        }
+
+        // Paused sounds are not heard, their voices go first
+        Candidate candidate = {sound->m_priority, -1.f, sound};
+        if (status == Sound::Playing)
+        {
+            candidate.audibility = computeAudibility(*sound, listener);
+            if (sound->m_source)
+                candidate.audibility *= voiceBonus;
+        }
+
+        candidates.push_back(candidate);
+        ++it;
+    }
+
+    std::sort(candidates.begin(), candidates.end(), CandidateCompare());
+
+    // Take the voices of the sounds that are not audible enough
+    std::size_t audibleCount = std::min<std::size_t>(candidates.size(), voiceCount);
+    for (std::size_t i = audibleCount; i < candidates.size(); ++i)
+    {
+        if (candidates[i].sound->m_source)
+            giveVoiceBack(candidates[i].sound);
+    }
+
+    // Delete the voices that exceed a reduced voice count
+    while ((m_voices.size() > voiceCount) && !m_freeVoices.empty())
+    {
+        ALuint voice = m_freeVoices.back();
+        m_freeVoices.pop_back();
+        m_voices.erase(std::find(m_voices.begin(), m_voices.end(), voice));
+        alCheck(alDeleteSources(1, &voice));
+    }
+
+    // Give the voices to the most audible sounds
+    bool hasVirtualSounds = false;
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        Sound* sound = candidates[i].sound;
+        if (sound->m_source || (sound->m_status != Sound::Playing))
+            continue;
+
+        unsigned int voice = (i < audibleCount) ? takeVoice() : 0;
+        if (voice)
+            sound->attachVoice(voice);
+        else
+            hasVirtualSounds = true;
+    }
+
+    return hasVirtualSounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void VoiceManager::run()
+{
+    for (;;)
+    {
+        bool hasVirtualSounds = false;
+
+        {
+            Lock lock(mutex);
+
+            if (!m_isRunning)
+                break;
+
+            hasVirtualSounds = update();
+        }
+
+        // The audibility of the virtual sounds changes as they and
+        // the listener move, check it regularly; otherwise, wait
+        // until a sound is left without a voice
+        if (hasVirtualSounds)
+            m_wakeUp.wait(updateInterval);
+        else
+            m_wakeUp.wait();
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_VOICEMANAGER_HPP
+#define SFML_VOICEMANAGER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Semaphore.hpp>
+#include <SFML/System/Thread.hpp>
+#include <set>
+#include <vector>
+
+
+namespace sf
+{
+class Sound;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Shares a limited number of OpenAL sources (voices)
+///        between all the sounds, the most audible ones first
+///
+////////////////////////////////////////////////////////////
+class VoiceManager : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Register a new sound instance
+    ///
+    /// The voice manager is created with the first sound,
+    /// and destroyed with the last one.
+    ///
+    ////////////////////////////////////////////////////////////
+    static void acquire();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unregister a sound instance
+    ///
+    ////////////////////////////////////////////////////////////
+    static void release();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the mutex protecting the sounds and their voices
+    ///
+    /// It must be locked by every function that reads or
+    /// changes the state of a sound, or the attributes that
+    /// define how audible it is.
+    ///
+    /// \return Reference to the mutex
+    ///
+    ////////////////////////////////////////////////////////////
+    static Mutex& getMutex();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start managing a sound that has started playing
+    ///
+    /// The sound is given a voice if one is available,
+    /// otherwise it is played virtually until it becomes
+    /// audible enough to get one.
+    ///
+    /// \param sound Sound to manage
+    ///
+    ////////////////////////////////////////////////////////////
+    static void play(Sound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop managing a sound, and take its voice back
+    ///
+    /// \param sound Sound that has been stopped
+    ///
+    ////////////////////////////////////////////////////////////
+    static void stop(Sound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the maximum number of voices
+    ///
+    /// \param count Maximum number of voices
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setVoiceCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of voices
+    ///
+    /// \return Maximum number of voices
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getVoiceCount();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    VoiceManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Waits for the update thread to terminate and
+    /// deletes the voices.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~VoiceManager();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a free voice, creating it if needed
+    ///
+    /// \return OpenAL source, or 0 if no voice is available
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int takeVoice();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Take the voice of a sound back
+    ///
+    /// \param sound Sound playing on a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    void giveVoiceBack(Sound* sound);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the sounds that have ended, and assign
+    ///        the voices to the most audible sounds
+    ///
+    /// \return True if some playing sounds are left without a voice
+    ///
+    ////////////////////////////////////////////////////////////
+    bool update();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called as the entry point of the thread
+    ///
+    /// This function updates the voices periodically while
+    /// some sounds are played virtually, and sleeps otherwise.
+    ///
+    ////////////////////////////////////////////////////////////
+    void run();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Thread                    m_thread;     ///< Update thread
+    Semaphore                 m_wakeUp;     ///< Semaphore posted when a sound is left without a voice
+    std::set<Sound*>          m_sounds;     ///< Playing and paused sounds
+    std::vector<unsigned int> m_voices;     ///< All the voices that have been created
+    std::vector<unsigned int> m_freeVoices; ///< Voices that are not used by any sound
+    bool                      m_isRunning;  ///< Whether the thread must keep running
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_VOICEMANAGER_HPP
@@ -26,7 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/CircleShape.hpp>
-#include <cmath>
+#include <SFML/Graphics/UnitCircle.hpp>
 
 
 namespace sf
@@ -34,7 +34,8 @@ namespace sf
 ////////////////////////////////////////////////////////////
 CircleShape::CircleShape(float radius, std::size_t pointCount) :
 m_radius    (radius),
-m_pointCount(pointCount)
+m_pointCount(pointCount),
+m_unitCircle(NULL)
 {
     update();
 }
@@ -59,6 +60,7 @@ float CircleShape::getRadius() const
 void CircleShape::setPointCount(std::size_t count)
 {
     m_pointCount = count;
+    m_unitCircle = NULL;
     update();
 }
 
@@ -72,13 +74,14 @@ std::size_t CircleShape::getPointCount() const
 ////////////////////////////////////////////////////////////
 Vector2f CircleShape::getPoint(std::size_t index) const
 {
-    static const float pi = 3.141592654f;
+    // Fetch the shared table when first needed rather than at construction,
+    // so that circles constructed at global scope don't depend on it
+    if (!m_unitCircle)
+        m_unitCircle = &priv::getUnitCircle(m_pointCount);
 
-    float angle = index * 2 * pi / m_pointCount - pi / 2;
-    float x = std::cos(angle) * m_radius;
-    float y = std::sin(angle) * m_radius;
+    const Vector2f& point = (*m_unitCircle)[index];
 
-    return Vector2f(m_radius + x, m_radius + y);
+    return Vector2f(m_radius + point.x * m_radius, m_radius + point.y * m_radius);
 }
 
 } // namespace sf
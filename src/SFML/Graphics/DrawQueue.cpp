@@ -0,0 +1,495 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/DrawQueue.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <algorithm>
+#include <functional>
+
+
+namespace
+{
+    // Strict weak ordering of blend modes, only used to group identical modes
+    bool lessBlendMode(const sf::BlendMode& left, const sf::BlendMode& right)
+    {
+        if (left.colorSrcFactor != right.colorSrcFactor) return left.colorSrcFactor < right.colorSrcFactor;
+        if (left.colorDstFactor != right.colorDstFactor) return left.colorDstFactor < right.colorDstFactor;
+        if (left.colorEquation  != right.colorEquation)  return left.colorEquation  < right.colorEquation;
+        if (left.alphaSrcFactor != right.alphaSrcFactor) return left.alphaSrcFactor < right.alphaSrcFactor;
+        if (left.alphaDstFactor != right.alphaDstFactor) return left.alphaDstFactor < right.alphaDstFactor;
+        return left.alphaEquation < right.alphaEquation;
+    }
+
+    // Append a vertex to an array, transformed
+    void appendVertex(std::vector<sf::Vertex>& vertices, const sf::Vertex& vertex, const sf::Transform& transform)
+    {
+        vertices.push_back(vertex);
+        vertices.back().position = transform.transformPoint(vertex.position);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+class DrawQueue::Recorder : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    Recorder(DrawQueue& queue) :
+    m_queue(queue)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const
+    {
+        return Vector2u(0, 0);
+    }
+
+    ////////////////////////////////////////////////////////////
+    virtual bool setActive(bool)
+    {
+        // Nothing is ever drawn to the recorder, it doesn't need a context
+        return true;
+    }
+
+protected:
+
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const Vertex* vertices, std::size_t vertexCount,
+                         PrimitiveType type, const RenderStates& states)
+    {
+        m_queue.record(vertices, vertexCount, type, states);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                         std::size_t vertexCount, const RenderStates& states)
+    {
+        m_queue.record(vertexBuffer, NULL, firstVertex, vertexCount, states);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                         IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states)
+    {
+        m_queue.record(vertices, vertexCount, indices, indexCount, indexType, type, states);
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////
+    virtual bool capture(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer,
+                         std::size_t firstIndex, std::size_t indexCount, const RenderStates& states)
+    {
+        m_queue.record(vertexBuffer, &indexBuffer, firstIndex, indexCount, states);
+        return true;
+    }
+
+private:
+
+    DrawQueue& m_queue; ///< Queue receiving the recorded draws
+};
+
+
+////////////////////////////////////////////////////////////
+struct DrawQueue::CommandOrder
+{
+    CommandOrder(const std::vector<Command>& commands, SortMode mode) :
+    m_commands(commands),
+    m_mode    (mode)
+    {
+    }
+
+    bool operator ()(std::size_t leftIndex, std::size_t rightIndex) const
+    {
+        const Command& left  = m_commands[leftIndex];
+        const Command& right = m_commands[rightIndex];
+
+        if (left.layer != right.layer)
+            return left.layer < right.layer;
+        if (m_mode == KeepOrder)
+            return false;
+        if (left.states.shader != right.states.shader)
+            return std::less<const Shader*>()(left.states.shader, right.states.shader);
+        if (left.states.texture != right.states.texture)
+            return std::less<const Texture*>()(left.states.texture, right.states.texture);
+        if (left.states.blendMode != right.states.blendMode)
+            return lessBlendMode(left.states.blendMode, right.states.blendMode);
+        return left.type < right.type;
+    }
+
+    const std::vector<Command>& m_commands;
+    SortMode                    m_mode;
+};
+
+
+////////////////////////////////////////////////////////////
+DrawQueue::DrawQueue(SortMode mode) :
+m_recorder     (NULL),
+m_sortMode     (mode),
+m_layer        (0),
+m_vertices     (),
+m_commands     (),
+m_batches      (),
+m_batchVertices(),
+m_needUpdate   (false)
+{
+    m_recorder = new Recorder(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+DrawQueue::~DrawQueue()
+{
+    delete m_recorder;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::add(const Drawable& drawable, int layer, const RenderStates& states)
+{
+    m_layer = layer;
+    m_recorder->draw(drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::add(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type,
+                    int layer, const RenderStates& states)
+{
+    m_layer = layer;
+    m_recorder->draw(vertices, vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::append(const DrawQueue& queue)
+{
+    if (&queue == this)
+        return;
+
+    std::size_t offset = m_vertices.size();
+    m_vertices.insert(m_vertices.end(), queue.m_vertices.begin(), queue.m_vertices.end());
+
+    m_commands.reserve(m_commands.size() + queue.m_commands.size());
+    for (std::vector<Command>::const_iterator it = queue.m_commands.begin(); it != queue.m_commands.end(); ++it)
+    {
+        Command command = *it;
+
+        // Vertex buffer commands refer to the buffer, not to our vertices
+        if (!command.vertexBuffer)
+            command.first += offset;
+
+        m_commands.push_back(command);
+    }
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::clear()
+{
+    m_vertices.clear();
+    m_commands.clear();
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::setSortMode(SortMode mode)
+{
+    if (mode != m_sortMode)
+    {
+        m_sortMode = mode;
+        m_needUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+DrawQueue::SortMode DrawQueue::getSortMode() const
+{
+    return m_sortMode;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::setView(const View& view)
+{
+    m_recorder->setView(view);
+}
+
+
+////////////////////////////////////////////////////////////
+const View& DrawQueue::getView() const
+{
+    return m_recorder->getView();
+}
+
+
+////////////////////////////////////////////////////////////
+bool DrawQueue::isEmpty() const
+{
+    return m_commands.empty();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t DrawQueue::getBatchCount() const
+{
+    if (m_needUpdate)
+        update();
+
+    return m_batches.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_needUpdate)
+        update();
+
+    for (std::vector<Batch>::const_iterator batch = m_batches.begin(); batch != m_batches.end(); ++batch)
+    {
+        const Command& command = *batch->command;
+
+        RenderStates batchStates(command.states.blendMode, states.transform, command.states.texture, command.states.shader);
+
+        if (command.vertexBuffer)
+        {
+            batchStates.transform *= command.states.transform;
+
+            if (command.indexBuffer)
+                target.draw(*command.vertexBuffer, *command.indexBuffer, batch->first, batch->count, batchStates);
+            else
+                target.draw(*command.vertexBuffer, batch->first, batch->count, batchStates);
+        }
+        else
+        {
+            target.draw(&m_batchVertices[batch->first], batch->count, command.type, batchStates);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::record(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
+    const Transform& transform = states.transform;
+    std::size_t first = m_vertices.size();
+
+    // Convert the primitives to lists, so that consecutive draws can be merged
+    PrimitiveType listType = type;
+    switch (type)
+    {
+        case Points:
+        case Lines:
+        case Triangles:
+        {
+            m_vertices.reserve(first + vertexCount);
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                appendVertex(m_vertices, vertices[i], transform);
+            break;
+        }
+
+        case LineStrip:
+        {
+            listType = Lines;
+            for (std::size_t i = 1; i < vertexCount; ++i)
+            {
+                appendVertex(m_vertices, vertices[i - 1], transform);
+                appendVertex(m_vertices, vertices[i], transform);
+            }
+            break;
+        }
+
+        case TriangleStrip:
+        {
+            listType = Triangles;
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                // Keep the winding of the strip consistent
+                if (i % 2 == 0)
+                {
+                    appendVertex(m_vertices, vertices[i - 2], transform);
+                    appendVertex(m_vertices, vertices[i - 1], transform);
+                }
+                else
+                {
+                    appendVertex(m_vertices, vertices[i - 1], transform);
+                    appendVertex(m_vertices, vertices[i - 2], transform);
+                }
+                appendVertex(m_vertices, vertices[i], transform);
+            }
+            break;
+        }
+
+        case TriangleFan:
+        {
+            listType = Triangles;
+            for (std::size_t i = 2; i < vertexCount; ++i)
+            {
+                appendVertex(m_vertices, vertices[0], transform);
+                appendVertex(m_vertices, vertices[i - 1], transform);
+                appendVertex(m_vertices, vertices[i], transform);
+            }
+            break;
+        }
+
+        case Quads:
+        {
+            listType = Triangles;
+            for (std::size_t i = 3; i < vertexCount; i += 4)
+            {
+                appendVertex(m_vertices, vertices[i - 3], transform);
+                appendVertex(m_vertices, vertices[i - 2], transform);
+                appendVertex(m_vertices, vertices[i - 1], transform);
+                appendVertex(m_vertices, vertices[i - 3], transform);
+                appendVertex(m_vertices, vertices[i - 1], transform);
+                appendVertex(m_vertices, vertices[i], transform);
+            }
+            break;
+        }
+    }
+
+    // Nothing left to draw (incomplete primitives)?
+    if (m_vertices.size() == first)
+        return;
+
+    Command command;
+    command.layer        = m_layer;
+    command.states       = states;
+    command.type         = listType;
+    command.first        = first;
+    command.count        = m_vertices.size() - first;
+    command.vertexBuffer = NULL;
+    command.indexBuffer  = NULL;
+    m_commands.push_back(command);
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::record(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                       IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states)
+{
+    // Resolve the indices, the vertices are then merged like any other
+    std::vector<Vertex> resolved;
+    resolved.reserve(indexCount);
+
+    for (std::size_t i = 0; i < indexCount; ++i)
+    {
+        std::size_t index = (indexType == IndexBuffer::Index32) ? static_cast<const Uint32*>(indices)[i]
+                                                                 : static_cast<const Uint16*>(indices)[i];
+        if (index < vertexCount)
+            resolved.push_back(vertices[index]);
+    }
+
+    if (!resolved.empty())
+        record(&resolved[0], resolved.size(), type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::record(const VertexBuffer& vertexBuffer, const IndexBuffer* indexBuffer, std::size_t first, std::size_t count, const RenderStates& states)
+{
+    Command command;
+    command.layer        = m_layer;
+    command.states       = states;
+    command.type         = vertexBuffer.getPrimitiveType();
+    command.first        = first;
+    command.count        = count;
+    command.vertexBuffer = &vertexBuffer;
+    command.indexBuffer  = indexBuffer;
+    m_commands.push_back(command);
+
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void DrawQueue::update() const
+{
+    m_batches.clear();
+    m_batchVertices.clear();
+    m_batchVertices.reserve(m_vertices.size());
+
+    // Sort the draws by layer, then by render states unless their order must be kept
+    std::vector<std::size_t> order(m_commands.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), CommandOrder(m_commands, m_sortMode));
+
+    // Merge consecutive draws that share the same render states
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        const Command& command = m_commands[order[i]];
+
+        if (command.vertexBuffer)
+        {
+            Batch batch = {&command, command.first, command.count};
+            m_batches.push_back(batch);
+            continue;
+        }
+
+        bool merge = false;
+        if (!m_batches.empty())
+        {
+            const Command& previous = *m_batches.back().command;
+            merge = !previous.vertexBuffer &&
+                    (previous.states.shader == command.states.shader) &&
+                    (previous.states.texture == command.states.texture) &&
+                    (previous.states.blendMode == command.states.blendMode) &&
+                    (previous.type == command.type);
+        }
+
+        if (merge)
+        {
+            m_batches.back().count += command.count;
+        }
+        else
+        {
+            Batch batch = {&command, m_batchVertices.size(), command.count};
+            m_batches.push_back(batch);
+        }
+
+        m_batchVertices.insert(m_batchVertices.end(), m_vertices.begin() + command.first,
+                               m_vertices.begin() + command.first + command.count);
+    }
+
+    m_needUpdate = false;
+}
+
+} // namespace sf
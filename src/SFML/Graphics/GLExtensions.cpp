@@ -28,6 +28,8 @@
 #include <SFML/Graphics/GLExtensions.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 
 #if !defined(GL_MAJOR_VERSION)
     #define GL_MAJOR_VERSION 0x821B
@@ -38,6 +40,13 @@
 #endif
 
 
+namespace
+{
+    // Threads with a transient context may initialize the extensions concurrently
+    sf::Mutex mutex;
+}
+
+
 namespace sf
 {
 namespace priv
@@ -47,6 +56,9 @@ void ensureExtensionsInit()
 {
 #if !defined(SFML_OPENGL_ES)
     static bool initialized = false;
+
+    Lock lock(mutex);
+
     if (!initialized)
     {
         initialized = true;
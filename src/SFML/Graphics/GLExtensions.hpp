@@ -57,6 +57,7 @@
     // 1.1 does not support GL_STREAM_DRAW so we just define it to GL_DYNAMIC_DRAW
     #define GLEXT_vertex_buffer_object                true
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW
     #define GLEXT_GL_STREAM_DRAW                      GL_DYNAMIC_DRAW
@@ -133,9 +134,31 @@
     // Core since 3.0
     #define GLEXT_framebuffer_multisample             false
 
+    // Core since 3.0 - OES_element_index_uint
+    #ifdef GL_OES_element_index_uint
+        #define GLEXT_element_index_uint                  GL_OES_element_index_uint
+    #else
+        #define GLEXT_element_index_uint                  false
+    #endif
+
+    // Core since 3.0 - OES_vertex_array_object
+    #define GLEXT_vertex_array_object                 false
+
     // Core since 3.0 - NV_copy_buffer
     #define GLEXT_copy_buffer                         false
 
+    // Core since 3.0 - EXT_occlusion_query_boolean
+    #define GLEXT_occlusion_query                     false
+
+    // Not available - EXT_disjoint_timer_query
+    #define GLEXT_timer_query                         false
+
+    // Core since 3.0 - APPLE_sync
+    #define GLEXT_sync                                false
+
+    // Not available - desktop core profile
+    #define GLEXT_core_3_2                            false
+
     // Core since 3.0 - EXT_sRGB
     #ifdef GL_EXT_sRGB
         #define GLEXT_texture_sRGB                        GL_EXT_sRGB
@@ -156,6 +179,7 @@
     // Core since 1.1
     #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT
     #define GLEXT_GL_CLAMP                            GL_CLAMP
+    #define GLEXT_element_index_uint                  true
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -193,6 +217,7 @@
     // Core since 1.5 - ARB_vertex_buffer_object
     #define GLEXT_vertex_buffer_object                sfogl_ext_ARB_vertex_buffer_object
     #define GLEXT_GL_ARRAY_BUFFER                     GL_ARRAY_BUFFER_ARB
+    #define GLEXT_GL_ELEMENT_ARRAY_BUFFER             GL_ELEMENT_ARRAY_BUFFER_ARB
     #define GLEXT_GL_DYNAMIC_DRAW                     GL_DYNAMIC_DRAW_ARB
     #define GLEXT_GL_READ_ONLY                        GL_READ_ONLY_ARB
     #define GLEXT_GL_STATIC_DRAW                      GL_STATIC_DRAW_ARB
@@ -206,6 +231,14 @@
     #define GLEXT_glMapBuffer                         glMapBufferARB
     #define GLEXT_glUnmapBuffer                       glUnmapBufferARB
 
+    // Core since 1.5 - ARB_occlusion_query
+    #define GLEXT_occlusion_query                     sfogl_ext_ARB_occlusion_query
+    #define GLEXT_GL_QUERY_RESULT                     GL_QUERY_RESULT_ARB
+    #define GLEXT_GL_QUERY_RESULT_AVAILABLE           GL_QUERY_RESULT_AVAILABLE_ARB
+    #define GLEXT_glGenQueries                        glGenQueriesARB
+    #define GLEXT_glDeleteQueries                     glDeleteQueriesARB
+    #define GLEXT_glGetQueryObjectuiv                 glGetQueryObjectuivARB
+
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
 
@@ -247,6 +280,10 @@
     #define GLEXT_vertex_shader                       sfogl_ext_ARB_vertex_shader
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
+    #define GLEXT_glBindAttribLocation                glBindAttribLocationARB
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
 
     // Core since 2.0 - ARB_fragment_shader
     #define GLEXT_fragment_shader                     sfogl_ext_ARB_fragment_shader
@@ -302,6 +339,12 @@
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
     #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+    // Core since 3.0 - ARB_vertex_array_object
+    #define GLEXT_vertex_array_object                 sfogl_ext_ARB_vertex_array_object
+    #define GLEXT_glBindVertexArray                   glBindVertexArray
+    #define GLEXT_glDeleteVertexArrays                glDeleteVertexArrays
+    #define GLEXT_glGenVertexArrays                   glGenVertexArrays
+
     // Core since 3.1 - ARB_copy_buffer
     #define GLEXT_copy_buffer                         sfogl_ext_ARB_copy_buffer
     #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
@@ -312,6 +355,31 @@
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 3.3 - ARB_timer_query
+    #define GLEXT_timer_query                         sfogl_ext_ARB_timer_query
+    #define GLEXT_GL_TIMESTAMP                        GL_TIMESTAMP
+    #define GLEXT_glQueryCounter                      glQueryCounter
+    #define GLEXT_glGetQueryObjectui64v               glGetQueryObjectui64v
+
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                sfogl_ext_ARB_sync
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_ALREADY_SIGNALED                 GL_ALREADY_SIGNALED
+    #define GLEXT_GL_CONDITION_SATISFIED              GL_CONDITION_SATISFIED
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_GL_TIMEOUT_IGNORED                  GL_TIMEOUT_IGNORED
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glWaitSync                          glWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+
+    // Core since 3.2 - entry points of the programmable pipeline used within core profile
+    // contexts, which don't advertise ARB_shader_objects and the like; the version
+    // of the context must be checked as well since they are loaded regardless of it
+    #define GLEXT_core_3_2                            sfogl_core_VERSION_3_2
+
 #endif
 
 namespace sf
@@ -53,6 +53,11 @@ int sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+int sfogl_core_VERSION_3_2 = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -935,6 +940,363 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryivARB)(GLenum, GLenum, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsQueryARB)(GLuint) = NULL;
+
+static int Load_ARB_occlusion_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBeginQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBeginQueryARB"));
+    if (!sf_ptrc_glBeginQueryARB)
+        numFailed++;
+
+    sf_ptrc_glDeleteQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteQueriesARB"));
+    if (!sf_ptrc_glDeleteQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glEndQueryARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glEndQueryARB"));
+    if (!sf_ptrc_glEndQueryARB)
+        numFailed++;
+
+    sf_ptrc_glGenQueriesARB = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenQueriesARB"));
+    if (!sf_ptrc_glGenQueriesARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetQueryObjectivARB"));
+    if (!sf_ptrc_glGetQueryObjectivARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectuivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint*)>(glLoaderGetProcAddress("glGetQueryObjectuivARB"));
+    if (!sf_ptrc_glGetQueryObjectuivARB)
+        numFailed++;
+
+    sf_ptrc_glGetQueryivARB = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLenum, GLint*)>(glLoaderGetProcAddress("glGetQueryivARB"));
+    if (!sf_ptrc_glGetQueryivARB)
+        numFailed++;
+
+    sf_ptrc_glIsQueryARB = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsQueryARB"));
+    if (!sf_ptrc_glIsQueryARB)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjecti64v)(GLuint, GLenum, GLint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum) = NULL;
+
+static int Load_ARB_timer_query()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetQueryObjecti64v = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint64*)>(glLoaderGetProcAddress("glGetQueryObjecti64v"));
+    if (!sf_ptrc_glGetQueryObjecti64v)
+        numFailed++;
+
+    sf_ptrc_glGetQueryObjectui64v = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLuint64*)>(glLoaderGetProcAddress("glGetQueryObjectui64v"));
+    if (!sf_ptrc_glGetQueryObjectui64v)
+        numFailed++;
+
+    sf_ptrc_glQueryCounter = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum)>(glLoaderGetProcAddress("glQueryCounter"));
+    if (!sf_ptrc_glQueryCounter)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint) = NULL;
+
+static int Load_ARB_vertex_array_object()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glBindVertexArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glBindVertexArray"));
+    if (!sf_ptrc_glBindVertexArray)
+        numFailed++;
+
+    sf_ptrc_glDeleteVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteVertexArrays"));
+    if (!sf_ptrc_glDeleteVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glGenVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenVertexArrays"));
+    if (!sf_ptrc_glGenVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glIsVertexArray = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glIsVertexArray"));
+    if (!sf_ptrc_glIsVertexArray)
+        numFailed++;
+
+    return numFailed;
+}
+
+GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync) = NULL;
+GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*) = NULL;
+GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64) = NULL;
+
+static int Load_ARB_sync()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glClientWaitSync = reinterpret_cast<GLenum (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glClientWaitSync"));
+    if (!sf_ptrc_glClientWaitSync)
+        numFailed++;
+
+    sf_ptrc_glDeleteSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glDeleteSync"));
+    if (!sf_ptrc_glDeleteSync)
+        numFailed++;
+
+    sf_ptrc_glFenceSync = reinterpret_cast<GLsync (GL_FUNCPTR *)(GLenum, GLbitfield)>(glLoaderGetProcAddress("glFenceSync"));
+    if (!sf_ptrc_glFenceSync)
+        numFailed++;
+
+    sf_ptrc_glGetInteger64v = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLint64*)>(glLoaderGetProcAddress("glGetInteger64v"));
+    if (!sf_ptrc_glGetInteger64v)
+        numFailed++;
+
+    sf_ptrc_glGetSynciv = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLenum, GLsizei, GLsizei*, GLint*)>(glLoaderGetProcAddress("glGetSynciv"));
+    if (!sf_ptrc_glGetSynciv)
+        numFailed++;
+
+    sf_ptrc_glIsSync = reinterpret_cast<GLboolean (GL_FUNCPTR *)(GLsync)>(glLoaderGetProcAddress("glIsSync"));
+    if (!sf_ptrc_glIsSync)
+        numFailed++;
+
+    sf_ptrc_glWaitSync = reinterpret_cast<void (GL_FUNCPTR *)(GLsync, GLbitfield, GLuint64)>(glLoaderGetProcAddress("glWaitSync"));
+    if (!sf_ptrc_glWaitSync)
+        numFailed++;
+
+    return numFailed;
+}
+
+void (GL_FUNCPTR *sf_ptrc_glActiveTexture)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glAttachShader)(GLuint, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBindAttribLocation)(GLuint, GLuint, const GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBindBuffer)(GLenum, GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferData)(GLenum, GLsizeiptr, const void*, GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glBufferSubData)(GLenum, GLintptr, GLsizeiptr, const void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glCompileShader)(GLuint) = NULL;
+GLuint (GL_FUNCPTR *sf_ptrc_glCreateProgram)() = NULL;
+GLuint (GL_FUNCPTR *sf_ptrc_glCreateShader)(GLenum) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteBuffers)(GLsizei, const GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteProgram)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDeleteShader)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDisableVertexAttribArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glDrawElementsBaseVertex)(GLenum, GLsizei, GLenum, const void*, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glEnableVertexAttribArray)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGenBuffers)(GLsizei, GLuint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetProgramiv)(GLuint, GLenum, GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glGetShaderiv)(GLuint, GLenum, GLint*) = NULL;
+GLint (GL_FUNCPTR *sf_ptrc_glGetUniformLocation)(GLuint, const GLchar*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glLinkProgram)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform1f)(GLint, GLfloat) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform1fv)(GLint, GLsizei, const GLfloat*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform1i)(GLint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform2f)(GLint, GLfloat, GLfloat) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform2fv)(GLint, GLsizei, const GLfloat*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform2i)(GLint, GLint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform3f)(GLint, GLfloat, GLfloat, GLfloat) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform3fv)(GLint, GLsizei, const GLfloat*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform3i)(GLint, GLint, GLint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform4f)(GLint, GLfloat, GLfloat, GLfloat, GLfloat) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform4fv)(GLint, GLsizei, const GLfloat*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniform4i)(GLint, GLint, GLint, GLint, GLint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniformMatrix3fv)(GLint, GLsizei, GLboolean, const GLfloat*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glUseProgram)(GLuint) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glVertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) = NULL;
+
+static int Load_VERSION_3_2()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glActiveTexture = reinterpret_cast<void (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glActiveTexture"));
+    if (!sf_ptrc_glActiveTexture)
+        numFailed++;
+
+    sf_ptrc_glAttachShader = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint)>(glLoaderGetProcAddress("glAttachShader"));
+    if (!sf_ptrc_glAttachShader)
+        numFailed++;
+
+    sf_ptrc_glBindAttribLocation = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLuint, const GLchar*)>(glLoaderGetProcAddress("glBindAttribLocation"));
+    if (!sf_ptrc_glBindAttribLocation)
+        numFailed++;
+
+    sf_ptrc_glBindBuffer = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLuint)>(glLoaderGetProcAddress("glBindBuffer"));
+    if (!sf_ptrc_glBindBuffer)
+        numFailed++;
+
+    sf_ptrc_glBindVertexArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glBindVertexArray"));
+    if (!sf_ptrc_glBindVertexArray)
+        numFailed++;
+
+    sf_ptrc_glBufferData = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizeiptr, const void*, GLenum)>(glLoaderGetProcAddress("glBufferData"));
+    if (!sf_ptrc_glBufferData)
+        numFailed++;
+
+    sf_ptrc_glBufferSubData = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLintptr, GLsizeiptr, const void*)>(glLoaderGetProcAddress("glBufferSubData"));
+    if (!sf_ptrc_glBufferSubData)
+        numFailed++;
+
+    sf_ptrc_glCompileShader = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glCompileShader"));
+    if (!sf_ptrc_glCompileShader)
+        numFailed++;
+
+    sf_ptrc_glCreateProgram = reinterpret_cast<GLuint (GL_FUNCPTR *)()>(glLoaderGetProcAddress("glCreateProgram"));
+    if (!sf_ptrc_glCreateProgram)
+        numFailed++;
+
+    sf_ptrc_glCreateShader = reinterpret_cast<GLuint (GL_FUNCPTR *)(GLenum)>(glLoaderGetProcAddress("glCreateShader"));
+    if (!sf_ptrc_glCreateShader)
+        numFailed++;
+
+    sf_ptrc_glDeleteBuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteBuffers"));
+    if (!sf_ptrc_glDeleteBuffers)
+        numFailed++;
+
+    sf_ptrc_glDeleteProgram = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDeleteProgram"));
+    if (!sf_ptrc_glDeleteProgram)
+        numFailed++;
+
+    sf_ptrc_glDeleteShader = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDeleteShader"));
+    if (!sf_ptrc_glDeleteShader)
+        numFailed++;
+
+    sf_ptrc_glDeleteVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, const GLuint*)>(glLoaderGetProcAddress("glDeleteVertexArrays"));
+    if (!sf_ptrc_glDeleteVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glDisableVertexAttribArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glDisableVertexAttribArray"));
+    if (!sf_ptrc_glDisableVertexAttribArray)
+        numFailed++;
+
+    sf_ptrc_glDrawElementsBaseVertex = reinterpret_cast<void (GL_FUNCPTR *)(GLenum, GLsizei, GLenum, const void*, GLint)>(glLoaderGetProcAddress("glDrawElementsBaseVertex"));
+    if (!sf_ptrc_glDrawElementsBaseVertex)
+        numFailed++;
+
+    sf_ptrc_glEnableVertexAttribArray = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glEnableVertexAttribArray"));
+    if (!sf_ptrc_glEnableVertexAttribArray)
+        numFailed++;
+
+    sf_ptrc_glGenBuffers = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenBuffers"));
+    if (!sf_ptrc_glGenBuffers)
+        numFailed++;
+
+    sf_ptrc_glGenVertexArrays = reinterpret_cast<void (GL_FUNCPTR *)(GLsizei, GLuint*)>(glLoaderGetProcAddress("glGenVertexArrays"));
+    if (!sf_ptrc_glGenVertexArrays)
+        numFailed++;
+
+    sf_ptrc_glGetProgramInfoLog = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLchar*)>(glLoaderGetProcAddress("glGetProgramInfoLog"));
+    if (!sf_ptrc_glGetProgramInfoLog)
+        numFailed++;
+
+    sf_ptrc_glGetProgramiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetProgramiv"));
+    if (!sf_ptrc_glGetProgramiv)
+        numFailed++;
+
+    sf_ptrc_glGetShaderInfoLog = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLchar*)>(glLoaderGetProcAddress("glGetShaderInfoLog"));
+    if (!sf_ptrc_glGetShaderInfoLog)
+        numFailed++;
+
+    sf_ptrc_glGetShaderiv = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint*)>(glLoaderGetProcAddress("glGetShaderiv"));
+    if (!sf_ptrc_glGetShaderiv)
+        numFailed++;
+
+    sf_ptrc_glGetUniformLocation = reinterpret_cast<GLint (GL_FUNCPTR *)(GLuint, const GLchar*)>(glLoaderGetProcAddress("glGetUniformLocation"));
+    if (!sf_ptrc_glGetUniformLocation)
+        numFailed++;
+
+    sf_ptrc_glLinkProgram = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glLinkProgram"));
+    if (!sf_ptrc_glLinkProgram)
+        numFailed++;
+
+    sf_ptrc_glShaderSource = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, const GLchar* const*, const GLint*)>(glLoaderGetProcAddress("glShaderSource"));
+    if (!sf_ptrc_glShaderSource)
+        numFailed++;
+
+    sf_ptrc_glUniform1f = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat)>(glLoaderGetProcAddress("glUniform1f"));
+    if (!sf_ptrc_glUniform1f)
+        numFailed++;
+
+    sf_ptrc_glUniform1fv = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform1fv"));
+    if (!sf_ptrc_glUniform1fv)
+        numFailed++;
+
+    sf_ptrc_glUniform1i = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint)>(glLoaderGetProcAddress("glUniform1i"));
+    if (!sf_ptrc_glUniform1i)
+        numFailed++;
+
+    sf_ptrc_glUniform2f = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat, GLfloat)>(glLoaderGetProcAddress("glUniform2f"));
+    if (!sf_ptrc_glUniform2f)
+        numFailed++;
+
+    sf_ptrc_glUniform2fv = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform2fv"));
+    if (!sf_ptrc_glUniform2fv)
+        numFailed++;
+
+    sf_ptrc_glUniform2i = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint)>(glLoaderGetProcAddress("glUniform2i"));
+    if (!sf_ptrc_glUniform2i)
+        numFailed++;
+
+    sf_ptrc_glUniform3f = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat, GLfloat, GLfloat)>(glLoaderGetProcAddress("glUniform3f"));
+    if (!sf_ptrc_glUniform3f)
+        numFailed++;
+
+    sf_ptrc_glUniform3fv = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform3fv"));
+    if (!sf_ptrc_glUniform3fv)
+        numFailed++;
+
+    sf_ptrc_glUniform3i = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint, GLint)>(glLoaderGetProcAddress("glUniform3i"));
+    if (!sf_ptrc_glUniform3i)
+        numFailed++;
+
+    sf_ptrc_glUniform4f = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLfloat, GLfloat, GLfloat, GLfloat)>(glLoaderGetProcAddress("glUniform4f"));
+    if (!sf_ptrc_glUniform4f)
+        numFailed++;
+
+    sf_ptrc_glUniform4fv = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, const GLfloat*)>(glLoaderGetProcAddress("glUniform4fv"));
+    if (!sf_ptrc_glUniform4fv)
+        numFailed++;
+
+    sf_ptrc_glUniform4i = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLint, GLint, GLint, GLint)>(glLoaderGetProcAddress("glUniform4i"));
+    if (!sf_ptrc_glUniform4i)
+        numFailed++;
+
+    sf_ptrc_glUniformMatrix3fv = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, GLboolean, const GLfloat*)>(glLoaderGetProcAddress("glUniformMatrix3fv"));
+    if (!sf_ptrc_glUniformMatrix3fv)
+        numFailed++;
+
+    sf_ptrc_glUniformMatrix4fv = reinterpret_cast<void (GL_FUNCPTR *)(GLint, GLsizei, GLboolean, const GLfloat*)>(glLoaderGetProcAddress("glUniformMatrix4fv"));
+    if (!sf_ptrc_glUniformMatrix4fv)
+        numFailed++;
+
+    sf_ptrc_glUseProgram = reinterpret_cast<void (GL_FUNCPTR *)(GLuint)>(glLoaderGetProcAddress("glUseProgram"));
+    if (!sf_ptrc_glUseProgram)
+        numFailed++;
+
+    sf_ptrc_glVertexAttribPointer = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*)>(glLoaderGetProcAddress("glVertexAttribPointer"));
+    if (!sf_ptrc_glVertexAttribPointer)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -943,7 +1305,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[20] = {
+static sfogl_StrToExtMap ExtensionMap[24] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -963,10 +1325,14 @@ static sfogl_StrToExtMap ExtensionMap[20] = {
     {"GL_EXT_framebuffer_blit", &sfogl_ext_EXT_framebuffer_blit, Load_EXT_framebuffer_blit},
     {"GL_EXT_framebuffer_multisample", &sfogl_ext_EXT_framebuffer_multisample, Load_EXT_framebuffer_multisample},
     {"GL_ARB_copy_buffer", &sfogl_ext_ARB_copy_buffer, Load_ARB_copy_buffer},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_occlusion_query", &sfogl_ext_ARB_occlusion_query, Load_ARB_occlusion_query},
+    {"GL_ARB_timer_query", &sfogl_ext_ARB_timer_query, Load_ARB_timer_query},
+    {"GL_ARB_vertex_array_object", &sfogl_ext_ARB_vertex_array_object, Load_ARB_vertex_array_object},
+    {"GL_ARB_sync", &sfogl_ext_ARB_sync, Load_ARB_sync}
 };
 
-static int g_extensionMapSize = 20;
+static int g_extensionMapSize = 24;
 
 
 static void ClearExtensionVars()
@@ -991,6 +1357,11 @@ static void ClearExtensionVars()
     sfogl_ext_EXT_framebuffer_multisample = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_copy_buffer = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_occlusion_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_timer_query = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_vertex_array_object = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_sync = sfogl_LOAD_FAILED;
+    sfogl_core_VERSION_3_2 = sfogl_LOAD_FAILED;
 }
 
 
@@ -1016,4 +1387,10 @@ void sfogl_LoadFunctions()
         if (sf::Context::isExtensionAvailable(ExtensionMap[i].extensionName))
             LoadExtension(ExtensionMap[i]);
     }
+
+    // Core functions don't appear in the extension string, their entry points
+    // are loaded regardless of the context version, which must be checked
+    // before they are used; all of them are needed for the set to be usable
+    if (Load_VERSION_3_2() == 0)
+        sfogl_core_VERSION_3_2 = sfogl_LOAD_SUCCEEDED;
 }
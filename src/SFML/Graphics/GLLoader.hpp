@@ -190,6 +190,11 @@ extern int sfogl_ext_EXT_framebuffer_blit;
 extern int sfogl_ext_EXT_framebuffer_multisample;
 extern int sfogl_ext_ARB_copy_buffer;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_occlusion_query;
+extern int sfogl_ext_ARB_timer_query;
+extern int sfogl_ext_ARB_vertex_array_object;
+extern int sfogl_ext_ARB_sync;
+extern int sfogl_core_VERSION_3_2;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -454,6 +459,47 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_CURRENT_QUERY_ARB 0x8865
+#define GL_QUERY_COUNTER_BITS_ARB 0x8864
+#define GL_QUERY_RESULT_ARB 0x8866
+#define GL_QUERY_RESULT_AVAILABLE_ARB 0x8867
+#define GL_SAMPLES_PASSED_ARB 0x8914
+
+#define GL_TIMESTAMP 0x8E28
+#define GL_TIME_ELAPSED 0x88BF
+
+#define GL_VERTEX_ARRAY_BINDING 0x85B5
+
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_MAX_SERVER_WAIT_TIMEOUT 0x9111
+#define GL_OBJECT_TYPE 0x9112
+#define GL_SIGNALED 0x9119
+#define GL_SYNC_CONDITION 0x9113
+#define GL_SYNC_FENCE 0x9116
+#define GL_SYNC_FLAGS 0x9115
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_STATUS 0x9114
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFFull
+#define GL_UNSIGNALED 0x9118
+#define GL_WAIT_FAILED 0x911D
+
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_COMPILE_STATUS 0x8B81
+#define GL_CURRENT_PROGRAM 0x8B8D
+#define GL_CONTEXT_CORE_PROFILE_BIT 0x00000001
+#define GL_CONTEXT_PROFILE_MASK 0x9126
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_FRAGMENT_SHADER 0x8B30
+#define GL_GEOMETRY_SHADER 0x8DD9
+#define GL_LINK_STATUS 0x8B82
+#define GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS 0x8B4D
+#define GL_STREAM_DRAW 0x88E0
+#define GL_TEXTURE0 0x84C0
+#define GL_VERTEX_SHADER 0x8B31
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1353,6 +1399,148 @@ extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteriARB)(GLuint, GLenum, GLint);
 #define glProgramParameteriARB sf_ptrc_glProgramParameteriARB
 #endif // GL_ARB_geometry_shader4
 
+#ifndef GL_ARB_occlusion_query
+#define GL_ARB_occlusion_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glBeginQueryARB)(GLenum, GLuint);
+#define glBeginQueryARB sf_ptrc_glBeginQueryARB
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteQueriesARB)(GLsizei, const GLuint*);
+#define glDeleteQueriesARB sf_ptrc_glDeleteQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glEndQueryARB)(GLenum);
+#define glEndQueryARB sf_ptrc_glEndQueryARB
+extern void (GL_FUNCPTR *sf_ptrc_glGenQueriesARB)(GLsizei, GLuint*);
+#define glGenQueriesARB sf_ptrc_glGenQueriesARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectivARB)(GLuint, GLenum, GLint*);
+#define glGetQueryObjectivARB sf_ptrc_glGetQueryObjectivARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectuivARB)(GLuint, GLenum, GLuint*);
+#define glGetQueryObjectuivARB sf_ptrc_glGetQueryObjectuivARB
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryivARB)(GLenum, GLenum, GLint*);
+#define glGetQueryivARB sf_ptrc_glGetQueryivARB
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsQueryARB)(GLuint);
+#define glIsQueryARB sf_ptrc_glIsQueryARB
+#endif // GL_ARB_occlusion_query
+
+#ifndef GL_ARB_timer_query
+#define GL_ARB_timer_query 1
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjecti64v)(GLuint, GLenum, GLint64*);
+#define glGetQueryObjecti64v sf_ptrc_glGetQueryObjecti64v
+extern void (GL_FUNCPTR *sf_ptrc_glGetQueryObjectui64v)(GLuint, GLenum, GLuint64*);
+#define glGetQueryObjectui64v sf_ptrc_glGetQueryObjectui64v
+extern void (GL_FUNCPTR *sf_ptrc_glQueryCounter)(GLuint, GLenum);
+#define glQueryCounter sf_ptrc_glQueryCounter
+#endif // GL_ARB_timer_query
+
+#ifndef GL_ARB_vertex_array_object
+#define GL_ARB_vertex_array_object 1
+extern void (GL_FUNCPTR *sf_ptrc_glBindVertexArray)(GLuint);
+#define glBindVertexArray sf_ptrc_glBindVertexArray
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteVertexArrays)(GLsizei, const GLuint*);
+#define glDeleteVertexArrays sf_ptrc_glDeleteVertexArrays
+extern void (GL_FUNCPTR *sf_ptrc_glGenVertexArrays)(GLsizei, GLuint*);
+#define glGenVertexArrays sf_ptrc_glGenVertexArrays
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsVertexArray)(GLuint);
+#define glIsVertexArray sf_ptrc_glIsVertexArray
+#endif // GL_ARB_vertex_array_object
+
+#ifndef GL_ARB_sync
+#define GL_ARB_sync 1
+extern GLenum (GL_FUNCPTR *sf_ptrc_glClientWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glClientWaitSync sf_ptrc_glClientWaitSync
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteSync)(GLsync);
+#define glDeleteSync sf_ptrc_glDeleteSync
+extern GLsync (GL_FUNCPTR *sf_ptrc_glFenceSync)(GLenum, GLbitfield);
+#define glFenceSync sf_ptrc_glFenceSync
+extern void (GL_FUNCPTR *sf_ptrc_glGetInteger64v)(GLenum, GLint64*);
+#define glGetInteger64v sf_ptrc_glGetInteger64v
+extern void (GL_FUNCPTR *sf_ptrc_glGetSynciv)(GLsync, GLenum, GLsizei, GLsizei*, GLint*);
+#define glGetSynciv sf_ptrc_glGetSynciv
+extern GLboolean (GL_FUNCPTR *sf_ptrc_glIsSync)(GLsync);
+#define glIsSync sf_ptrc_glIsSync
+extern void (GL_FUNCPTR *sf_ptrc_glWaitSync)(GLsync, GLbitfield, GLuint64);
+#define glWaitSync sf_ptrc_glWaitSync
+#endif // GL_ARB_sync
+
+#ifndef GL_VERSION_3_2
+#define GL_VERSION_3_2 1
+extern void (GL_FUNCPTR *sf_ptrc_glActiveTexture)(GLenum);
+#define glActiveTexture sf_ptrc_glActiveTexture
+extern void (GL_FUNCPTR *sf_ptrc_glAttachShader)(GLuint, GLuint);
+#define glAttachShader sf_ptrc_glAttachShader
+extern void (GL_FUNCPTR *sf_ptrc_glBindAttribLocation)(GLuint, GLuint, const GLchar*);
+#define glBindAttribLocation sf_ptrc_glBindAttribLocation
+extern void (GL_FUNCPTR *sf_ptrc_glBindBuffer)(GLenum, GLuint);
+#define glBindBuffer sf_ptrc_glBindBuffer
+extern void (GL_FUNCPTR *sf_ptrc_glBufferData)(GLenum, GLsizeiptr, const void*, GLenum);
+#define glBufferData sf_ptrc_glBufferData
+extern void (GL_FUNCPTR *sf_ptrc_glBufferSubData)(GLenum, GLintptr, GLsizeiptr, const void*);
+#define glBufferSubData sf_ptrc_glBufferSubData
+extern void (GL_FUNCPTR *sf_ptrc_glCompileShader)(GLuint);
+#define glCompileShader sf_ptrc_glCompileShader
+extern GLuint (GL_FUNCPTR *sf_ptrc_glCreateProgram)();
+#define glCreateProgram sf_ptrc_glCreateProgram
+extern GLuint (GL_FUNCPTR *sf_ptrc_glCreateShader)(GLenum);
+#define glCreateShader sf_ptrc_glCreateShader
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteBuffers)(GLsizei, const GLuint*);
+#define glDeleteBuffers sf_ptrc_glDeleteBuffers
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteProgram)(GLuint);
+#define glDeleteProgram sf_ptrc_glDeleteProgram
+extern void (GL_FUNCPTR *sf_ptrc_glDeleteShader)(GLuint);
+#define glDeleteShader sf_ptrc_glDeleteShader
+extern void (GL_FUNCPTR *sf_ptrc_glDisableVertexAttribArray)(GLuint);
+#define glDisableVertexAttribArray sf_ptrc_glDisableVertexAttribArray
+extern void (GL_FUNCPTR *sf_ptrc_glDrawElementsBaseVertex)(GLenum, GLsizei, GLenum, const void*, GLint);
+#define glDrawElementsBaseVertex sf_ptrc_glDrawElementsBaseVertex
+extern void (GL_FUNCPTR *sf_ptrc_glEnableVertexAttribArray)(GLuint);
+#define glEnableVertexAttribArray sf_ptrc_glEnableVertexAttribArray
+extern void (GL_FUNCPTR *sf_ptrc_glGenBuffers)(GLsizei, GLuint*);
+#define glGenBuffers sf_ptrc_glGenBuffers
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+#define glGetProgramInfoLog sf_ptrc_glGetProgramInfoLog
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramiv)(GLuint, GLenum, GLint*);
+#define glGetProgramiv sf_ptrc_glGetProgramiv
+extern void (GL_FUNCPTR *sf_ptrc_glGetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*);
+#define glGetShaderInfoLog sf_ptrc_glGetShaderInfoLog
+extern void (GL_FUNCPTR *sf_ptrc_glGetShaderiv)(GLuint, GLenum, GLint*);
+#define glGetShaderiv sf_ptrc_glGetShaderiv
+extern GLint (GL_FUNCPTR *sf_ptrc_glGetUniformLocation)(GLuint, const GLchar*);
+#define glGetUniformLocation sf_ptrc_glGetUniformLocation
+extern void (GL_FUNCPTR *sf_ptrc_glLinkProgram)(GLuint);
+#define glLinkProgram sf_ptrc_glLinkProgram
+extern void (GL_FUNCPTR *sf_ptrc_glShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*);
+#define glShaderSource sf_ptrc_glShaderSource
+extern void (GL_FUNCPTR *sf_ptrc_glUniform1f)(GLint, GLfloat);
+#define glUniform1f sf_ptrc_glUniform1f
+extern void (GL_FUNCPTR *sf_ptrc_glUniform1fv)(GLint, GLsizei, const GLfloat*);
+#define glUniform1fv sf_ptrc_glUniform1fv
+extern void (GL_FUNCPTR *sf_ptrc_glUniform1i)(GLint, GLint);
+#define glUniform1i sf_ptrc_glUniform1i
+extern void (GL_FUNCPTR *sf_ptrc_glUniform2f)(GLint, GLfloat, GLfloat);
+#define glUniform2f sf_ptrc_glUniform2f
+extern void (GL_FUNCPTR *sf_ptrc_glUniform2fv)(GLint, GLsizei, const GLfloat*);
+#define glUniform2fv sf_ptrc_glUniform2fv
+extern void (GL_FUNCPTR *sf_ptrc_glUniform2i)(GLint, GLint, GLint);
+#define glUniform2i sf_ptrc_glUniform2i
+extern void (GL_FUNCPTR *sf_ptrc_glUniform3f)(GLint, GLfloat, GLfloat, GLfloat);
+#define glUniform3f sf_ptrc_glUniform3f
+extern void (GL_FUNCPTR *sf_ptrc_glUniform3fv)(GLint, GLsizei, const GLfloat*);
+#define glUniform3fv sf_ptrc_glUniform3fv
+extern void (GL_FUNCPTR *sf_ptrc_glUniform3i)(GLint, GLint, GLint, GLint);
+#define glUniform3i sf_ptrc_glUniform3i
+extern void (GL_FUNCPTR *sf_ptrc_glUniform4f)(GLint, GLfloat, GLfloat, GLfloat, GLfloat);
+#define glUniform4f sf_ptrc_glUniform4f
+extern void (GL_FUNCPTR *sf_ptrc_glUniform4fv)(GLint, GLsizei, const GLfloat*);
+#define glUniform4fv sf_ptrc_glUniform4fv
+extern void (GL_FUNCPTR *sf_ptrc_glUniform4i)(GLint, GLint, GLint, GLint, GLint);
+#define glUniform4i sf_ptrc_glUniform4i
+extern void (GL_FUNCPTR *sf_ptrc_glUniformMatrix3fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+#define glUniformMatrix3fv sf_ptrc_glUniformMatrix3fv
+extern void (GL_FUNCPTR *sf_ptrc_glUniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+#define glUniformMatrix4fv sf_ptrc_glUniformMatrix4fv
+extern void (GL_FUNCPTR *sf_ptrc_glUseProgram)(GLuint);
+#define glUseProgram sf_ptrc_glUseProgram
+extern void (GL_FUNCPTR *sf_ptrc_glVertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+#define glVertexAttribPointer sf_ptrc_glVertexAttribPointer
+#endif // GL_VERSION_3_2
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
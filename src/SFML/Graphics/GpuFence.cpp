@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GpuFence.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cstddef>
+
+
+namespace
+{
+    sf::Mutex isAvailableMutex;
+
+    // Longest wait of a single call to glClientWaitSync, in nanoseconds
+    const sf::Uint64 maxWaitSlice = 1000000000;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+GpuFence::GpuFence() :
+m_sync     (NULL),
+m_contextId(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+GpuFence::~GpuFence()
+{
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuFence::insert()
+{
+    TransientContextLock lock;
+
+    release();
+
+#ifndef SFML_OPENGL_ES
+
+    if (isAvailable())
+    {
+        GLEXT_GLsync sync = 0;
+        glCheck(sync = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+        m_sync = sync;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    m_contextId = Context::getActiveContextId();
+
+    // Flush the commands, a context could otherwise wait forever
+    // for a fence that was never submitted to the GPU
+    glCheck(glFlush());
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuFence::isSignaled() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_sync)
+    {
+        TransientContextLock lock;
+
+        GLenum result = GL_FALSE;
+        glCheck(result = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_sync), 0, 0));
+
+        // A failed wait (GL_WAIT_FAILED) won't succeed later either: give up on the fence
+        if (result == GLEXT_GL_TIMEOUT_EXPIRED)
+            return false;
+
+        release();
+    }
+
+#endif // SFML_OPENGL_ES
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuFence::wait(Time timeout) const
+{
+    if (!m_contextId)
+        return true;
+
+    TransientContextLock lock;
+
+#ifndef SFML_OPENGL_ES
+
+    if (m_sync)
+    {
+        // The wait is split in slices of at most one second, GLuint64
+        // timeouts can't express an infinite wait with glClientWaitSync
+        bool infinite = (timeout == Time::Zero);
+        Uint64 remaining = static_cast<Uint64>(timeout.asMicroseconds()) * 1000;
+
+        for (;;)
+        {
+            Uint64 slice = (infinite || (remaining > maxWaitSlice)) ? maxWaitSlice : remaining;
+
+            GLenum result = GL_FALSE;
+            glCheck(result = GLEXT_glClientWaitSync(static_cast<GLEXT_GLsync>(m_sync), 0, slice));
+
+            if ((result == GLEXT_GL_ALREADY_SIGNALED) || (result == GLEXT_GL_CONDITION_SATISFIED))
+                break;
+
+            if (result != GLEXT_GL_TIMEOUT_EXPIRED)
+                return false;
+
+            if (!infinite)
+            {
+                remaining -= slice;
+
+                if (remaining == 0)
+                    return false;
+            }
+        }
+
+        release();
+
+        return true;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Fences are not supported: wait for all the commands of the active context
+    glCheck(glFinish());
+
+    m_contextId = 0;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuFence::synchronize() const
+{
+#ifndef SFML_OPENGL_ES
+
+    // Commands of a same context are executed in order, only the others have to wait
+    if (!m_sync || (Context::getActiveContextId() == m_contextId))
+        return;
+
+    // No need to make the GPU wait if the fence is already signaled
+    if (isSignaled())
+        return;
+
+    TransientContextLock lock;
+
+    glCheck(GLEXT_glWaitSync(static_cast<GLEXT_GLsync>(m_sync), 0, GLEXT_GL_TIMEOUT_IGNORED));
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool GpuFence::isAvailable()
+{
+    Lock lock(isAvailableMutex);
+
+    static bool checked = false;
+    static bool available = false;
+
+    if (!checked)
+    {
+        checked = true;
+
+        TransientContextLock contextLock;
+
+        // Make sure that extensions are initialized
+        sf::priv::ensureExtensionsInit();
+
+        available = GLEXT_sync;
+    }
+
+    return available;
+}
+
+
+////////////////////////////////////////////////////////////
+void GpuFence::release() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_sync)
+    {
+        TransientContextLock lock;
+
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(m_sync)));
+    }
+
+#endif // SFML_OPENGL_ES
+
+    m_sync = NULL;
+    m_contextId = 0;
+}
+
+} // namespace sf
@@ -0,0 +1,829 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderImage.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Size of the tiles that the image is split into, in pixels
+    const int tileSize = 64;
+
+    // Plane equation of a value interpolated across a triangle
+    struct Gradient
+    {
+        float dx;   // Change per pixel along X
+        float dy;   // Change per pixel along Y
+        float base; // Value at the origin
+
+        float at(float x, float y) const
+        {
+            return base + dx * x + dy * y;
+        }
+    };
+
+    // Edge of a triangle; the inside of the triangle is where a * x + b * y + c is positive
+    struct Edge
+    {
+        float a;
+        float b;
+        float c;
+        bool  inclusive; // Are the pixels exactly on the edge inside? (top-left rule)
+    };
+
+    Edge makeEdge(const sf::Vector2f& from, const sf::Vector2f& to)
+    {
+        Edge edge;
+        edge.a = from.y - to.y;
+        edge.b = to.x - from.x;
+        edge.c = -(edge.a * from.x + edge.b * from.y);
+        edge.inclusive = (edge.a > 0) || ((edge.a == 0) && (edge.b > 0));
+
+        return edge;
+    }
+
+    Gradient makeGradient(const Edge* edges, float area, float value0, float value1, float value2)
+    {
+        Gradient gradient;
+        gradient.dx   = (edges[0].a * value0 + edges[1].a * value1 + edges[2].a * value2) / area;
+        gradient.dy   = (edges[0].b * value0 + edges[1].b * value1 + edges[2].b * value2) / area;
+        gradient.base = (edges[0].c * value0 + edges[1].c * value1 + edges[2].c * value2) / area;
+
+        return gradient;
+    }
+
+    // Wrap or clamp a texel coordinate
+    int wrap(int coordinate, int size, bool repeated)
+    {
+        if (repeated)
+        {
+            coordinate %= size;
+            return coordinate < 0 ? coordinate + size : coordinate;
+        }
+
+        return std::min(std::max(coordinate, 0), size - 1);
+    }
+
+    // Sample a texture at the given coordinates, in pixels; the texel
+    // components are returned in [0, 255]
+    void sample(const sf::Image& image, bool smooth, bool repeated, float u, float v, float* texel)
+    {
+        const sf::Uint8* pixels = image.getPixelsPtr();
+        int width  = static_cast<int>(image.getSize().x);
+        int height = static_cast<int>(image.getSize().y);
+
+        if (!smooth)
+        {
+            int x = wrap(static_cast<int>(std::floor(u)), width, repeated);
+            int y = wrap(static_cast<int>(std::floor(v)), height, repeated);
+            const sf::Uint8* texel0 = pixels + 4 * (y * width + x);
+
+            for (int i = 0; i < 4; ++i)
+                texel[i] = texel0[i];
+
+            return;
+        }
+
+        // Bilinear filtering between the 4 texels around the sample point
+        float fx = u - 0.5f;
+        float fy = v - 0.5f;
+        float x0 = std::floor(fx);
+        float y0 = std::floor(fy);
+        float tx = fx - x0;
+        float ty = fy - y0;
+
+        int left   = wrap(static_cast<int>(x0), width, repeated);
+        int right  = wrap(static_cast<int>(x0) + 1, width, repeated);
+        int top    = wrap(static_cast<int>(y0), height, repeated);
+        int bottom = wrap(static_cast<int>(y0) + 1, height, repeated);
+
+        const sf::Uint8* topLeft     = pixels + 4 * (top * width + left);
+        const sf::Uint8* topRight    = pixels + 4 * (top * width + right);
+        const sf::Uint8* bottomLeft  = pixels + 4 * (bottom * width + left);
+        const sf::Uint8* bottomRight = pixels + 4 * (bottom * width + right);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            float upper = topLeft[i] + (topRight[i] - topLeft[i]) * tx;
+            float lower = bottomLeft[i] + (bottomRight[i] - bottomLeft[i]) * tx;
+            texel[i] = upper + (lower - upper) * ty;
+        }
+    }
+
+    // Compute a blending factor for one component
+    float getFactor(sf::BlendMode::Factor factor, const float* source, const float* destination, int component)
+    {
+        switch (factor)
+        {
+            case sf::BlendMode::Zero:             return 0.f;
+            case sf::BlendMode::One:              return 1.f;
+            case sf::BlendMode::SrcColor:         return source[component];
+            case sf::BlendMode::OneMinusSrcColor: return 1.f - source[component];
+            case sf::BlendMode::DstColor:         return destination[component];
+            case sf::BlendMode::OneMinusDstColor: return 1.f - destination[component];
+            case sf::BlendMode::SrcAlpha:         return source[3];
+            case sf::BlendMode::OneMinusSrcAlpha: return 1.f - source[3];
+            case sf::BlendMode::DstAlpha:         return destination[3];
+            case sf::BlendMode::OneMinusDstAlpha: return 1.f - destination[3];
+        }
+
+        return 0.f;
+    }
+
+    // Combine a source and a destination component
+    float combine(sf::BlendMode::Equation equation, float source, float destination)
+    {
+        switch (equation)
+        {
+            case sf::BlendMode::Add:             return source + destination;
+            case sf::BlendMode::Subtract:        return source - destination;
+            case sf::BlendMode::ReverseSubtract: return destination - source;
+        }
+
+        return source;
+    }
+
+    // Convert a component in [0, 1] to a byte
+    sf::Uint8 toByte(float value)
+    {
+        return static_cast<sf::Uint8>(std::min(std::max(value, 0.f), 1.f) * 255.f + 0.5f);
+    }
+
+    // Blend a source color, whose components are in [0, 1], into a pixel
+    void blend(const sf::BlendMode& mode, const float* source, sf::Uint8* pixel)
+    {
+        float destination[4] = {pixel[0] / 255.f, pixel[1] / 255.f, pixel[2] / 255.f, pixel[3] / 255.f};
+
+        for (int i = 0; i < 3; ++i)
+        {
+            float sourceFactor      = getFactor(mode.colorSrcFactor, source, destination, i);
+            float destinationFactor = getFactor(mode.colorDstFactor, source, destination, i);
+            pixel[i] = toByte(combine(mode.colorEquation, source[i] * sourceFactor, destination[i] * destinationFactor));
+        }
+
+        float sourceFactor      = getFactor(mode.alphaSrcFactor, source, destination, 3);
+        float destinationFactor = getFactor(mode.alphaDstFactor, source, destination, 3);
+        pixel[3] = toByte(combine(mode.alphaEquation, source[3] * sourceFactor, destination[3] * destinationFactor));
+    }
+
+    // Kind of blending, to pick a fast path for the most common modes
+    enum BlendKind
+    {
+        BlendReplace, // The source replaces the destination
+        BlendOver,    // Regular alpha blending (sf::BlendAlpha)
+        BlendGeneric  // Any other mode
+    };
+
+    BlendKind getBlendKind(const sf::BlendMode& mode)
+    {
+        if ((mode.colorSrcFactor == sf::BlendMode::One) && (mode.colorDstFactor == sf::BlendMode::Zero) &&
+            (mode.alphaSrcFactor == sf::BlendMode::One) && (mode.alphaDstFactor == sf::BlendMode::Zero) &&
+            (mode.colorEquation == sf::BlendMode::Add)  && (mode.alphaEquation == sf::BlendMode::Add))
+            return BlendReplace;
+
+        if (mode == sf::BlendAlpha)
+            return BlendOver;
+
+        return BlendGeneric;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderImage::RenderImage() :
+m_image      (),
+m_threadCount(4),
+m_states     (),
+m_triangles  (),
+m_tiles      (),
+m_tileCount  (0, 0),
+m_nextTile   (0),
+m_tileMutex  (),
+m_textures   ()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderImage::~RenderImage()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderImage::create(unsigned int width, unsigned int height)
+{
+    if ((width == 0) || (height == 0))
+    {
+        err() << "Failed to create render image, invalid size (" << width << "x" << height << ")" << std::endl;
+        return false;
+    }
+
+    m_image.create(width, height, Color::Transparent);
+
+    m_states.clear();
+    m_triangles.clear();
+    m_tileCount.x = (width + tileSize - 1) / tileSize;
+    m_tileCount.y = (height + tileSize - 1) / tileSize;
+    m_tiles.clear();
+    m_tiles.resize(m_tileCount.x * m_tileCount.y);
+
+    // We can now initialize the render target part
+    RenderTarget::initialize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::setThreadCount(unsigned int count)
+{
+    m_threadCount = std::max(count, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderImage::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderImage::setActive(bool)
+{
+    // Nothing is rendered with OpenGL, textures are read back by Texture::copyToImage
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::display()
+{
+    rasterize();
+
+    // Forget the textures that were not used since the last display
+    for (std::map<const Texture*, TextureImage>::iterator it = m_textures.begin(); it != m_textures.end(); )
+    {
+        if (it->second.used)
+        {
+            it->second.used = false;
+            ++it;
+        }
+        else
+        {
+            m_textures.erase(it++);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u RenderImage::getSize() const
+{
+    return m_image.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& RenderImage::getImage() const
+{
+    return m_image;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderImage::capture(const Vertex* vertices, std::size_t vertexCount,
+                          PrimitiveType type, const RenderStates& states)
+{
+    addPrimitives(vertices, vertexCount, type, states);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderImage::capture(const VertexBuffer&, std::size_t, std::size_t, const RenderStates&)
+{
+    err() << "Vertex buffers can't be drawn to a render image, drawing skipped" << std::endl;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderImage::capture(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                          IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states)
+{
+    // Resolve the indices, out of range ones are skipped
+    std::vector<Vertex> resolved;
+    resolved.reserve(indexCount);
+
+    for (std::size_t i = 0; i < indexCount; ++i)
+    {
+        std::size_t index = (indexType == IndexBuffer::Index16) ? static_cast<const Uint16*>(indices)[i]
+                                                                : static_cast<const Uint32*>(indices)[i];
+        if (index < vertexCount)
+            resolved.push_back(vertices[index]);
+    }
+
+    if (!resolved.empty())
+        addPrimitives(&resolved[0], resolved.size(), type, states);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderImage::capture(const VertexBuffer&, const IndexBuffer&, std::size_t, std::size_t, const RenderStates&)
+{
+    err() << "Vertex buffers can't be drawn to a render image, drawing skipped" << std::endl;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderImage::captureClear(const Color& color)
+{
+    // Whatever was drawn before is overwritten
+    m_states.clear();
+    m_triangles.clear();
+    for (std::size_t i = 0; i < m_tiles.size(); ++i)
+        m_tiles[i].clear();
+
+    std::vector<Uint8>& pixels = m_image.m_pixels;
+    for (std::size_t i = 0; i < pixels.size(); i += 4)
+    {
+        pixels[i + 0] = color.r;
+        pixels[i + 1] = color.g;
+        pixels[i + 2] = color.b;
+        pixels[i + 3] = color.a;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Transform RenderImage::beginDraw(const RenderStates& states)
+{
+    const View& view = getView();
+    IntRect viewport = getViewport(view);
+
+    DrawState state;
+    state.blendMode = states.blendMode;
+    state.texture   = states.texture ? getTextureImage(*states.texture) : NULL;
+    state.smooth    = states.texture && states.texture->isSmooth();
+    state.repeated  = states.texture && states.texture->isRepeated();
+
+    // Like OpenGL, only draw inside the viewport
+    if (!viewport.intersects(IntRect(0, 0, static_cast<int>(getSize().x), static_cast<int>(getSize().y)), state.scissor))
+        state.scissor = IntRect();
+
+    // Consecutive draws with the same states share their state
+    const DrawState* last = m_states.empty() ? NULL : &m_states.back();
+    if (!last || (last->blendMode != state.blendMode) || (last->texture != state.texture) || (last->smooth != state.smooth) ||
+        (last->repeated != state.repeated) || (last->scissor != state.scissor))
+        m_states.push_back(state);
+
+    // Map the view to the viewport, with Y pointing down like the image rows
+    Transform toPixels;
+    toPixels.translate(viewport.left + viewport.width / 2.f, viewport.top + viewport.height / 2.f);
+    toPixels.scale(viewport.width / 2.f, -viewport.height / 2.f);
+
+    return toPixels * view.getTransform() * states.transform;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::addPrimitives(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states)
+{
+    if (!vertices || (vertexCount == 0) || m_tiles.empty())
+        return;
+
+    Transform transform = beginDraw(states);
+
+    // Move the vertices to pixel coordinates
+    std::vector<Vertex> transformed(vertices, vertices + vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+        transformed[i].position = transform.transformPoint(vertices[i].position);
+
+    const Vertex* v = &transformed[0];
+
+    switch (type)
+    {
+        case Points:
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                addPoint(v[i]);
+            break;
+
+        case Lines:
+            for (std::size_t i = 0; i + 1 < vertexCount; i += 2)
+                addLine(v[i], v[i + 1]);
+            break;
+
+        case LineStrip:
+            for (std::size_t i = 0; i + 1 < vertexCount; ++i)
+                addLine(v[i], v[i + 1]);
+            break;
+
+        case Triangles:
+            for (std::size_t i = 0; i + 2 < vertexCount; i += 3)
+                addTriangle(v[i], v[i + 1], v[i + 2]);
+            break;
+
+        case TriangleStrip:
+            for (std::size_t i = 0; i + 2 < vertexCount; ++i)
+                addTriangle(v[i], v[i + 1], v[i + 2]);
+            break;
+
+        case TriangleFan:
+            for (std::size_t i = 1; i + 1 < vertexCount; ++i)
+                addTriangle(v[0], v[i], v[i + 1]);
+            break;
+
+        case Quads:
+            for (std::size_t i = 0; i + 3 < vertexCount; i += 4)
+            {
+                addTriangle(v[i], v[i + 1], v[i + 2]);
+                addTriangle(v[i], v[i + 2], v[i + 3]);
+            }
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::addPoint(const Vertex& point)
+{
+    Vertex corners[4] = {point, point, point, point};
+    corners[0].position += Vector2f(-0.5f, -0.5f);
+    corners[1].position += Vector2f( 0.5f, -0.5f);
+    corners[2].position += Vector2f( 0.5f,  0.5f);
+    corners[3].position += Vector2f(-0.5f,  0.5f);
+
+    addTriangle(corners[0], corners[1], corners[2]);
+    addTriangle(corners[0], corners[2], corners[3]);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::addLine(const Vertex& a, const Vertex& b)
+{
+    Vector2f direction = b.position - a.position;
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+
+    if (length == 0.f)
+        return;
+
+    // Offset both ends by half a pixel on each side of the line
+    Vector2f normal(-direction.y / length * 0.5f, direction.x / length * 0.5f);
+
+    Vertex corners[4] = {a, b, b, a};
+    corners[0].position += normal;
+    corners[1].position += normal;
+    corners[2].position -= normal;
+    corners[3].position -= normal;
+
+    addTriangle(corners[0], corners[1], corners[2]);
+    addTriangle(corners[0], corners[2], corners[3]);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::addTriangle(const Vertex& a, const Vertex& b, const Vertex& c)
+{
+    const IntRect& scissor = m_states.back().scissor;
+
+    // Find the pixels that the triangle may cover
+    float left   = std::min(a.position.x, std::min(b.position.x, c.position.x));
+    float top    = std::min(a.position.y, std::min(b.position.y, c.position.y));
+    float right  = std::max(a.position.x, std::max(b.position.x, c.position.x));
+    float bottom = std::max(a.position.y, std::max(b.position.y, c.position.y));
+
+    float scissorRight  = static_cast<float>(scissor.left + scissor.width);
+    float scissorBottom = static_cast<float>(scissor.top + scissor.height);
+
+    if ((right <= scissor.left) || (bottom <= scissor.top) || (left >= scissorRight) || (top >= scissorBottom))
+        return;
+
+    int firstX = static_cast<int>(std::max(left, static_cast<float>(scissor.left))) / tileSize;
+    int firstY = static_cast<int>(std::max(top, static_cast<float>(scissor.top))) / tileSize;
+    int lastX  = static_cast<int>(std::min(right, scissorRight - 1)) / tileSize;
+    int lastY  = static_cast<int>(std::min(bottom, scissorBottom - 1)) / tileSize;
+
+    Triangle triangle;
+    triangle.vertices[0] = a;
+    triangle.vertices[1] = b;
+    triangle.vertices[2] = c;
+    triangle.state = m_states.size() - 1;
+
+    Uint32 index = static_cast<Uint32>(m_triangles.size());
+    m_triangles.push_back(triangle);
+
+    for (int y = firstY; y <= lastY; ++y)
+        for (int x = firstX; x <= lastX; ++x)
+            m_tiles[y * m_tileCount.x + x].push_back(index);
+}
+
+
+////////////////////////////////////////////////////////////
+const Image* RenderImage::getTextureImage(const Texture& texture)
+{
+    TextureImage& entry = m_textures[&texture];
+    entry.used = true;
+
+    if ((entry.cacheId != texture.m_cacheId) || (entry.image.getSize() != texture.getSize()))
+    {
+        // The texture changed: what was drawn with it before must still use the previous pixels
+        if (entry.image.getSize().x > 0)
+            rasterize();
+
+        entry.image   = texture.copyToImage();
+        entry.cacheId = texture.m_cacheId;
+    }
+
+    return entry.image.getSize().x > 0 ? &entry.image : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::rasterize()
+{
+    if (m_triangles.empty())
+        return;
+
+    // Rasterize the tiles in parallel, the calling thread takes part
+    m_nextTile = 0;
+
+    std::size_t threadCount = std::min(static_cast<std::size_t>(m_threadCount), m_tiles.size());
+    std::vector<Thread*> threads;
+
+    for (std::size_t i = 1; i < threadCount; ++i)
+    {
+        threads.push_back(new Thread(&RenderImage::rasterizeTiles, this));
+        threads.back()->launch();
+    }
+
+    rasterizeTiles();
+
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+
+    m_states.clear();
+    m_triangles.clear();
+    for (std::size_t i = 0; i < m_tiles.size(); ++i)
+        m_tiles[i].clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::rasterizeTiles()
+{
+    for (;;)
+    {
+        std::size_t index;
+        {
+            Lock lock(m_tileMutex);
+            index = m_nextTile++;
+        }
+
+        if (index >= m_tiles.size())
+            return;
+
+        const std::vector<Uint32>& tile = m_tiles[index];
+        if (tile.empty())
+            continue;
+
+        int left = static_cast<int>(index % m_tileCount.x) * tileSize;
+        int top  = static_cast<int>(index / m_tileCount.x) * tileSize;
+        IntRect area(left, top,
+                     std::min(tileSize, static_cast<int>(m_image.getSize().x) - left),
+                     std::min(tileSize, static_cast<int>(m_image.getSize().y) - top));
+
+        // Triangles are rasterized in the order they were drawn
+        for (std::size_t i = 0; i < tile.size(); ++i)
+            rasterize(m_triangles[tile[i]], area);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderImage::rasterize(const Triangle& triangle, const IntRect& area)
+{
+    const DrawState& state = m_states[triangle.state];
+
+    IntRect clip;
+    if (!area.intersects(state.scissor, clip))
+        return;
+
+    // Order the vertices so that the inside is where the edge functions are positive
+    const Vertex* v0 = &triangle.vertices[0];
+    const Vertex* v1 = &triangle.vertices[1];
+    const Vertex* v2 = &triangle.vertices[2];
+
+    float doubleArea = (v1->position.x - v0->position.x) * (v2->position.y - v0->position.y) -
+                       (v1->position.y - v0->position.y) * (v2->position.x - v0->position.x);
+
+    if (doubleArea == 0.f)
+        return;
+
+    if (doubleArea < 0.f)
+    {
+        std::swap(v1, v2);
+        doubleArea = -doubleArea;
+    }
+
+    // Edge i is opposite to vertex i, so that its function gives the barycentric weight of the vertex
+    Edge edges[3] = {makeEdge(v1->position, v2->position),
+                     makeEdge(v2->position, v0->position),
+                     makeEdge(v0->position, v1->position)};
+
+    // Colors are interpolated in [0, 1], texture coordinates in pixels
+    const float normalize = 1.f / 255.f;
+
+    Gradient red   = makeGradient(edges, doubleArea, v0->color.r * normalize, v1->color.r * normalize, v2->color.r * normalize);
+    Gradient green = makeGradient(edges, doubleArea, v0->color.g * normalize, v1->color.g * normalize, v2->color.g * normalize);
+    Gradient blue  = makeGradient(edges, doubleArea, v0->color.b * normalize, v1->color.b * normalize, v2->color.b * normalize);
+    Gradient alpha = makeGradient(edges, doubleArea, v0->color.a * normalize, v1->color.a * normalize, v2->color.a * normalize);
+    Gradient u     = makeGradient(edges, doubleArea, v0->texCoords.x, v1->texCoords.x, v2->texCoords.x);
+    Gradient v     = makeGradient(edges, doubleArea, v0->texCoords.y, v1->texCoords.y, v2->texCoords.y);
+
+    const Image* texture = state.texture;
+    BlendKind    kind    = getBlendKind(state.blendMode);
+
+    // Untextured triangles of a single color have dedicated span loops
+    bool flat   = !texture && (v0->color == v1->color) && (v1->color == v2->color);
+    bool opaque = (kind == BlendReplace) || ((kind == BlendOver) && (v0->color.a == 255));
+
+    // Premultiplied color and inverse alpha, for flat alpha blending
+    Uint32 flatColor[4] = {static_cast<Uint32>(v0->color.r * v0->color.a),
+                           static_cast<Uint32>(v0->color.g * v0->color.a),
+                           static_cast<Uint32>(v0->color.b * v0->color.a),
+                           static_cast<Uint32>(v0->color.a * 255)};
+    Uint32 flatInverse = 255 - v0->color.a;
+
+    Uint8*       pixels    = &m_image.m_pixels[0];
+    unsigned int width     = m_image.getSize().x;
+    float        clipLeft  = static_cast<float>(clip.left);
+    float        clipRight = static_cast<float>(clip.left + clip.width);
+
+    for (int y = clip.top; y < clip.top + clip.height; ++y)
+    {
+        float centerY = y + 0.5f;
+
+        // Compute the span of pixel centers inside the three edges
+        int  first = clip.left;
+        int  last  = clip.left + clip.width; // exclusive
+        bool empty = false;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const Edge& edge = edges[i];
+            float constant = edge.b * centerY + edge.c;
+
+            if (edge.a == 0.f)
+            {
+                if ((constant < 0.f) || ((constant == 0.f) && !edge.inclusive))
+                    empty = true;
+
+                continue;
+            }
+
+            // The edge function is zero at this X coordinate of pixel centers
+            float bound = std::min(std::max(-constant / edge.a - 0.5f, clipLeft - 1.f), clipRight + 1.f);
+
+            if (edge.a > 0.f)
+            {
+                int start = edge.inclusive ? static_cast<int>(std::ceil(bound)) : static_cast<int>(std::floor(bound)) + 1;
+                first = std::max(first, start);
+            }
+            else
+            {
+                int end = edge.inclusive ? static_cast<int>(std::floor(bound)) + 1 : static_cast<int>(std::ceil(bound));
+                last = std::min(last, end);
+            }
+        }
+
+        if (empty || (first >= last))
+            continue;
+
+        Uint8* pixel = pixels + 4 * (y * width + first);
+        Uint8* end   = pixels + 4 * (y * width + last);
+
+        if (flat && opaque)
+        {
+            for (; pixel != end; pixel += 4)
+            {
+                pixel[0] = v0->color.r;
+                pixel[1] = v0->color.g;
+                pixel[2] = v0->color.b;
+                pixel[3] = v0->color.a;
+            }
+
+            continue;
+        }
+
+        if (flat && (kind == BlendOver))
+        {
+            for (; pixel != end; pixel += 4)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    // Rounded division by 255, exact for sums of products of bytes up to 255 * 255
+                    Uint32 value = flatColor[i] + pixel[i] * flatInverse + 128;
+                    pixel[i] = static_cast<Uint8>((value + (value >> 8)) >> 8);
+                }
+            }
+
+            continue;
+        }
+
+        // Interpolate the attributes incrementally along the span
+        float centerX = first + 0.5f;
+        float r  = red.at(centerX, centerY);
+        float g  = green.at(centerX, centerY);
+        float b  = blue.at(centerX, centerY);
+        float a  = alpha.at(centerX, centerY);
+        float tu = u.at(centerX, centerY);
+        float tv = v.at(centerX, centerY);
+
+        for (; pixel != end; pixel += 4)
+        {
+            float source[4] = {r, g, b, a};
+
+            if (texture)
+            {
+                float texel[4];
+                sample(*texture, state.smooth, state.repeated, tu, tv, texel);
+
+                for (int i = 0; i < 4; ++i)
+                    source[i] *= texel[i] * normalize;
+            }
+
+            for (int i = 0; i < 4; ++i)
+                source[i] = std::min(std::max(source[i], 0.f), 1.f);
+
+            if (kind == BlendReplace)
+            {
+                for (int i = 0; i < 4; ++i)
+                    pixel[i] = toByte(source[i]);
+            }
+            else if (kind == BlendOver)
+            {
+                // Both terms are in [0, 255], no need to clamp
+                float inverse = 1.f - source[3];
+                for (int i = 0; i < 3; ++i)
+                    pixel[i] = static_cast<Uint8>(source[i] * source[3] * 255.f + pixel[i] * inverse + 0.5f);
+                pixel[3] = static_cast<Uint8>(source[3] * 255.f + pixel[3] * inverse + 0.5f);
+            }
+            else
+            {
+                blend(state.blendMode, source, pixel);
+            }
+
+            r  += red.dx;
+            g  += green.dx;
+            b  += blue.dx;
+            a  += alpha.dx;
+            tu += u.dx;
+            tv += v.dx;
+        }
+    }
+}
+
+} // namespace sf
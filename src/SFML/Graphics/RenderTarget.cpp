@@ -26,6 +26,8 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTargetCore.hpp>
+#include <SFML/Graphics/RenderTargetProfiler.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include <SFML/Graphics/Texture.hpp>
@@ -37,6 +39,7 @@
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <algorithm>
 #include <map>
@@ -47,6 +50,11 @@
 
     #define GL_QUADS 0
 
+    // Only defined by OpenGL ES 1 headers along with OES_element_index_uint
+    #ifndef GL_UNSIGNED_INT
+        #define GL_UNSIGNED_INT 0x1405
+    #endif
+
 #endif // SFML_OPENGL_ES
 
 
@@ -55,6 +63,15 @@ namespace
     // Mutex to protect ID generation and our context-RenderTarget-map
     sf::Mutex mutex;
 
+    // Statistics returned when profiling is disabled
+    const sf::RenderStatistics emptyStatistics;
+
+    // Texture matrix used when no texture is bound
+    const float identityMatrix[16] = {1.f, 0.f, 0.f, 0.f,
+                                      0.f, 1.f, 0.f, 0.f,
+                                      0.f, 0.f, 1.f, 0.f,
+                                      0.f, 0.f, 0.f, 1.f};
+
     // Unique identifier, used for identifying RenderTargets when
     // tracking the currently active RenderTarget within a given context
     sf::Uint64 getUniqueId()
@@ -129,25 +146,38 @@ RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
 m_cache      (),
-m_id         (0)
+m_id         (0),
+m_profiler   (NULL),
+m_core       (NULL)
 {
     m_cache.glStatesSet = false;
+    m_cache.drawingSkipped = false;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+    delete m_profiler;
+    delete m_core;
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::clear(const Color& color)
 {
+    // Let targets that don't use OpenGL do their job
+    if (captureClear(color))
+        return;
+
     if (isActive(m_id) || setActive(true))
     {
+        if (m_profiler)
+            m_profiler->beginFrame();
+
         // Unbind texture to fix RenderTexture preventing clear
-        applyTexture(NULL);
+        if (!m_cache.enable || m_cache.lastTextureId)
+            applyTexture(NULL);
 
         glCheck(glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f));
         glCheck(glClear(GL_COLOR_BUFFER_BIT));
@@ -250,6 +280,10 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
+    // Let targets that record primitives do their job
+    if (capture(vertices, vertexCount, type, states))
+        return;
+
     // GL_QUADS is unavailable on OpenGL ES
     #ifdef SFML_OPENGL_ES
         if (type == Quads)
@@ -259,95 +293,207 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         }
     #endif
 
-    if (isActive(m_id) || setActive(true))
+    drawVertices(vertices, vertexCount, NULL, 0, IndexBuffer::Index16, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
+                        std::size_t vertexCount, const RenderStates& states)
+{
+    // VertexBuffer not supported? A buffer that was created proves that it is,
+    // so checking it (which needs a context) is avoided when recording from other threads
+    if (!vertexBuffer.getNativeHandle())
     {
-        // Check if the vertex count is low enough so that we can pre-transform them
-        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
+        if (!VertexBuffer::isAvailable())
+            err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
 
-        if (useVertexCache)
+        return;
+    }
+
+    // Sanity check
+    if (firstVertex > vertexBuffer.getVertexCount())
+        return;
+
+    // Clamp vertexCount to something that makes sense
+    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+
+    // Nothing to draw?
+    if (!vertexCount)
+        return;
+
+    // Let targets that record primitives do their job
+    if (capture(vertexBuffer, firstVertex, vertexCount, states))
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (vertexBuffer.getPrimitiveType() == Quads)
         {
-            // Pre-transform the vertices and store them into the vertex cache
-            for (std::size_t i = 0; i < vertexCount; ++i)
-            {
-                Vertex& vertex = m_cache.vertexCache[i];
-                vertex.position = states.transform * vertices[i].position;
-                vertex.color = vertices[i].color;
-                vertex.texCoords = vertices[i].texCoords;
-            }
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
         }
+    #endif
 
-        setupDraw(useVertexCache, states);
+    if (isActive(m_id) || setActive(true))
+    {
+        if (!setupDraw(false, states))
+            return;
 
-        // Check if texture coordinates array is needed, and update client state accordingly
-        bool enableTexCoordsArray = (states.texture || states.shader);
-        if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
+        // Always enable texture coordinates
+        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
         {
-            if (enableTexCoordsArray)
-                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+            if (m_core)
+                m_core->setTexCoordsArrayEnabled(true);
             else
-                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+        else if (m_profiler)
+        {
+            m_profiler->countSkippedStateChange();
         }
 
-        // If we switch between non-cache and cache mode or enable texture
-        // coordinates we need to set up the pointers to the vertices' components
-        if (!m_cache.enable || !useVertexCache || !m_cache.useVertexCache)
+        // Set up the pointers into the vertex buffer, unless they already point to it;
+        // the buffer they refer to is captured when they are set, so it doesn't need
+        // to stay bound for drawing
+        if (!m_cache.enable || (vertexBuffer.m_cacheId != m_cache.lastVertexBufferId) || !m_cache.texCoordsPointerSet)
         {
-            const char* data = reinterpret_cast<const char*>(vertices);
+            // Bind vertex buffer
+            VertexBuffer::bind(&vertexBuffer);
 
-            // If we pre-transform the vertices, we must use our internal vertex cache
-            if (useVertexCache)
-                data = reinterpret_cast<const char*>(m_cache.vertexCache);
+            if (m_core)
+            {
+                priv::RenderTargetCore::setupPointers();
+            }
+            else
+            {
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+            }
 
-            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
-            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
-            if (enableTexCoordsArray)
-                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            // Unbind vertex buffer
+            VertexBuffer::bind(NULL);
         }
-        else if (enableTexCoordsArray && !m_cache.texCoordsArrayEnabled)
+        else if (m_profiler)
         {
-            // If we enter this block, we are already using our internal vertex cache
-            const char* data = reinterpret_cast<const char*>(m_cache.vertexCache);
-
-            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+            m_profiler->countSkippedStateChange();
         }
 
-        drawPrimitives(type, 0, vertexCount);
+        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+
         cleanupDraw(states);
 
+        if (m_profiler)
+            m_profiler->countDraw(vertexCount);
+
         // Update the cache
-        m_cache.useVertexCache = useVertexCache;
-        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
+        m_cache.lastArrayData = NULL;
+        m_cache.lastVertexBufferId = vertexBuffer.m_cacheId;
+        m_cache.texCoordsPointerSet = true;
+        m_cache.useVertexCache = false;
+        m_cache.texCoordsArrayEnabled = true;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint16* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
 {
-    draw(vertexBuffer, 0, vertexBuffer.getVertexCount(), states);
+    // Nothing to draw?
+    if (!vertices || !vertexCount || !indices || !indexCount)
+        return;
+
+    // Let targets that record primitives do their job
+    if (capture(vertices, vertexCount, indices, indexCount, IndexBuffer::Index16, type, states))
+        return;
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (type == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    drawVertices(vertices, vertexCount, indices, indexCount, IndexBuffer::Index16, type, states);
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
-                        std::size_t vertexCount, const RenderStates& states)
+void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount, const Uint32* indices, std::size_t indexCount,
+                        PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || !vertexCount || !indices || !indexCount)
+        return;
+
+    // Let targets that record primitives do their job
+    if (capture(vertices, vertexCount, indices, indexCount, IndexBuffer::Index32, type, states))
+        return;
+
+    // 32-bit indices are optional on OpenGL ES
+    if (!IndexBuffer::isIndex32Available())
+    {
+        err() << "32-bit indices are not supported, drawing skipped" << std::endl;
+        return;
+    }
+
+    // GL_QUADS is unavailable on OpenGL ES
+    #ifdef SFML_OPENGL_ES
+        if (type == Quads)
+        {
+            err() << "sf::Quads primitive type is not supported on OpenGL ES platforms, drawing skipped" << std::endl;
+            return;
+        }
+    #endif
+
+    drawVertices(vertices, vertexCount, indices, indexCount, IndexBuffer::Index32, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, const RenderStates& states)
+{
+    draw(vertexBuffer, indexBuffer, 0, indexBuffer.getIndexCount(), states);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const VertexBuffer& vertexBuffer, const IndexBuffer& indexBuffer, std::size_t firstIndex,
+                        std::size_t indexCount, const RenderStates& states)
 {
-    // VertexBuffer not supported?
-    if (!VertexBuffer::isAvailable())
+    // VertexBuffer not supported? Same as above
+    if (!vertexBuffer.getNativeHandle() || !indexBuffer.getNativeHandle())
     {
-        err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+        if (!VertexBuffer::isAvailable())
+            err() << "sf::VertexBuffer is not available, drawing skipped" << std::endl;
+
         return;
     }
 
     // Sanity check
-    if (firstVertex > vertexBuffer.getVertexCount())
+    if (firstIndex > indexBuffer.getIndexCount())
         return;
 
-    // Clamp vertexCount to something that makes sense
-    vertexCount = std::min(vertexCount, vertexBuffer.getVertexCount() - firstVertex);
+    // Clamp indexCount to something that makes sense
+    indexCount = std::min(indexCount, indexBuffer.getIndexCount() - firstIndex);
 
     // Nothing to draw?
-    if (!vertexCount || !vertexBuffer.getNativeHandle())
+    if (!indexCount || !vertexBuffer.getVertexCount())
+        return;
+
+    // Let targets that record primitives do their job
+    if (capture(vertexBuffer, indexBuffer, firstIndex, indexCount, states))
         return;
 
     // GL_QUADS is unavailable on OpenGL ES
@@ -361,27 +507,64 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
 
     if (isActive(m_id) || setActive(true))
     {
-        setupDraw(false, states);
-
-        // Bind vertex buffer
-        VertexBuffer::bind(&vertexBuffer);
+        if (!setupDraw(false, states))
+            return;
 
         // Always enable texture coordinates
         if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
-            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        {
+            if (m_core)
+                m_core->setTexCoordsArrayEnabled(true);
+            else
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+        else if (m_profiler)
+        {
+            m_profiler->countSkippedStateChange();
+        }
 
-        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
-        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
-        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+        // Set up the pointers into the vertex buffer, unless they already point to it
+        if (!m_cache.enable || (vertexBuffer.m_cacheId != m_cache.lastVertexBufferId) || !m_cache.texCoordsPointerSet)
+        {
+            VertexBuffer::bind(&vertexBuffer);
 
-        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+            if (m_core)
+            {
+                priv::RenderTargetCore::setupPointers();
+            }
+            else
+            {
+                glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+                glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+            }
 
-        // Unbind vertex buffer
-        VertexBuffer::bind(NULL);
+            VertexBuffer::bind(NULL);
+        }
+        else if (m_profiler)
+        {
+            m_profiler->countSkippedStateChange();
+        }
+
+        // Unlike the array buffer, the index buffer must stay bound
+        // while drawing; it is unbound right after so that indexed
+        // draws from client memory keep working
+        std::size_t indexSize = (indexBuffer.getIndexType() == IndexBuffer::Index32) ? sizeof(Uint32) : sizeof(Uint16);
+
+        IndexBuffer::bind(&indexBuffer);
+        drawIndexedPrimitives(vertexBuffer.getPrimitiveType(), reinterpret_cast<const void*>(indexSize * firstIndex),
+                              indexCount, indexBuffer.getIndexType(), 0);
+        IndexBuffer::bind(NULL);
 
         cleanupDraw(states);
 
+        if (m_profiler)
+            m_profiler->countDraw(indexCount);
+
         // Update the cache
+        m_cache.lastArrayData = NULL;
+        m_cache.lastVertexBufferId = vertexBuffer.m_cacheId;
+        m_cache.texCoordsPointerSet = true;
         m_cache.useVertexCache = false;
         m_cache.texCoordsArrayEnabled = true;
     }
@@ -443,16 +626,20 @@ void RenderTarget::pushGLStates()
             }
         #endif
 
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
-            glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
-        #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+        // Core profile contexts have no attribute and matrix stacks
+        if (!priv::RenderTargetCore::isCoreProfile())
+        {
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
+                glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
+            #endif
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        }
     }
 
     resetGLStates();
@@ -464,16 +651,28 @@ void RenderTarget::popGLStates()
 {
     if (isActive(m_id) || setActive(true))
     {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
-        #ifndef SFML_OPENGL_ES
-            glCheck(glPopClientAttrib());
-            glCheck(glPopAttrib());
-        #endif
+        // The current program is not part of the saved attributes,
+        // so don't leave our shader bound for the restored states
+        if (m_cache.lastShaderId)
+            applyShader(NULL);
+
+        // Core profile contexts have no attribute and matrix stacks
+        if (!priv::RenderTargetCore::isCoreProfile())
+        {
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPopMatrix());
+            #ifndef SFML_OPENGL_ES
+                glCheck(glPopClientAttrib());
+                glCheck(glPopAttrib());
+            #endif
+        }
+
+        // The restored states don't match our cache anymore
+        m_cache.enable = false;
     }
 }
 
@@ -493,51 +692,153 @@ void RenderTarget::resetGLStates()
 
     if (isActive(m_id) || setActive(true))
     {
+        // Don't trust the cache, every state must really be applied
+        m_cache.enable = false;
+
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
+        // Core profile contexts don't have the fixed-function
+        // pipeline, we have to use our programmable one instead
+        if (priv::RenderTargetCore::isCoreProfile())
+        {
+            if (!m_core && priv::RenderTargetCore::isAvailable())
+            {
+                m_core = new priv::RenderTargetCore;
+            }
+            else if (!m_core)
+            {
+                static bool warned = false;
+
+                if (!warned)
+                {
+                    err() << "Core profile contexts require the OpenGL 3.2 functions, which could not be loaded" << std::endl;
+                    err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
+
+                    warned = true;
+                }
+
+                // The fixed-function calls would all fail, don't draw anything
+                m_cache.drawingSkipped = true;
+                m_cache.glStatesSet = true;
+                return;
+            }
+        }
+        else
+        {
+            delete m_core;
+            m_core = NULL;
+        }
+
+        m_cache.drawingSkipped = false;
+
         // Make sure that the texture unit which is active is the number 0
         if (GLEXT_multitexture)
         {
-            glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+            if (!m_core)
+                glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
             glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
         }
 
         // Define the default OpenGL states
         glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_DEPTH_TEST));
-        glCheck(glDisable(GL_ALPHA_TEST));
-        glCheck(glEnable(GL_TEXTURE_2D));
         glCheck(glEnable(GL_BLEND));
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glLoadIdentity());
-        glCheck(glEnableClientState(GL_VERTEX_ARRAY));
-        glCheck(glEnableClientState(GL_COLOR_ARRAY));
-        glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        if (m_core)
+        {
+            m_core->activate();
+            m_core->setModelViewMatrix(Transform::Identity.getMatrix());
+            m_core->setTexCoordsArrayEnabled(true);
+        }
+        else
+        {
+            glCheck(glDisable(GL_LIGHTING));
+            glCheck(glDisable(GL_ALPHA_TEST));
+            glCheck(glEnable(GL_TEXTURE_2D));
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glLoadIdentity());
+            glCheck(glEnableClientState(GL_VERTEX_ARRAY));
+            glCheck(glEnableClientState(GL_COLOR_ARRAY));
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+        m_cache.lastTransform = Transform::Identity;
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
         applyTexture(NULL);
-        if (shaderAvailable)
+        if (m_core || shaderAvailable)
             applyShader(NULL);
+        else
+            m_cache.lastShaderId = 0;
 
         if (vertexBufferAvailable)
             glCheck(VertexBuffer::bind(NULL));
 
+        // We don't know where the array pointers point to
+        m_cache.lastArrayData = NULL;
+        m_cache.lastVertexBufferId = 0;
+        m_cache.texCoordsPointerSet = false;
+
         m_cache.texCoordsArrayEnabled = true;
 
         m_cache.useVertexCache = false;
 
-        // Set the default view
-        setView(getView());
+        // Apply the current view
+        applyCurrentView();
 
         m_cache.enable = true;
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::setProfilingEnabled(bool enabled)
+{
+    if (enabled && !m_profiler)
+    {
+        m_profiler = new priv::RenderTargetProfiler;
+    }
+    else if (!enabled && m_profiler)
+    {
+        // Timer queries are destroyed right away if our context is active,
+        // otherwise they are kept until it gets active again
+        delete m_profiler;
+        m_profiler = NULL;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::isProfilingEnabled() const
+{
+    return m_profiler != NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::beginProfilingScope(const std::string& name)
+{
+    if (m_profiler && (isActive(m_id) || setActive(true)))
+        m_profiler->beginScope(name);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::endProfilingScope()
+{
+    if (m_profiler && (isActive(m_id) || setActive(true)))
+        m_profiler->endScope();
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderStatistics& RenderTarget::getStatistics() const
+{
+    return m_profiler ? m_profiler->getStatistics() : emptyStatistics;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::initialize()
 {
@@ -554,20 +855,96 @@ void RenderTarget::initialize()
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::endProfilingFrame()
+{
+    if (m_profiler && (isActive(m_id) || setActive(true)))
+        m_profiler->endFrame();
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::capture(const Vertex*, std::size_t, PrimitiveType, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::capture(const VertexBuffer&, std::size_t, std::size_t, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::capture(const Vertex*, std::size_t, const void*, std::size_t,
+                           IndexBuffer::IndexType, PrimitiveType, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::capture(const VertexBuffer&, const IndexBuffer&, std::size_t, std::size_t, const RenderStates&)
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTarget::captureClear(const Color&)
+{
+    return false;
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyCurrentView()
 {
     // Set the viewport
     IntRect viewport = getViewport(m_view);
-    int top = getSize().y - (viewport.top + viewport.height);
-    glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
+    viewport.top = getSize().y - (viewport.top + viewport.height);
+    if (!m_cache.enable || (viewport != m_cache.lastViewport))
+    {
+        glCheck(glViewport(viewport.left, viewport.top, viewport.width, viewport.height));
+
+        m_cache.lastViewport = viewport;
+
+        if (m_profiler)
+            m_profiler->countStateChange();
+    }
+    else if (m_profiler)
+    {
+        m_profiler->countSkippedStateChange();
+    }
 
     // Set the projection matrix
-    glCheck(glMatrixMode(GL_PROJECTION));
-    glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
+    const Transform& projection = m_view.getTransform();
+    if (!m_cache.enable || (projection != m_cache.lastProjection))
+    {
+        if (m_core)
+        {
+            m_core->setProjectionMatrix(projection.getMatrix());
+        }
+        else
+        {
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glLoadMatrixf(projection.getMatrix()));
+
+            // Go back to model-view mode
+            glCheck(glMatrixMode(GL_MODELVIEW));
+        }
 
-    // Go back to model-view mode
-    glCheck(glMatrixMode(GL_MODELVIEW));
+        m_cache.lastProjection = projection;
+
+        if (m_profiler)
+            m_profiler->countStateChange();
+    }
+    else if (m_profiler)
+    {
+        m_profiler->countSkippedStateChange();
+    }
 
     m_cache.viewChanged = false;
 }
@@ -576,21 +953,42 @@ void RenderTarget::applyCurrentView()
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyBlendMode(const BlendMode& mode)
 {
-    // Apply the blend mode, falling back to the non-separate versions if necessary
-    if (GLEXT_blend_func_separate)
+    const BlendMode& last = m_cache.lastBlendMode;
+
+    // Apply the blend function, falling back to the non-separate versions if necessary
+    bool funcChanged = (mode.colorSrcFactor != last.colorSrcFactor) || (mode.colorDstFactor != last.colorDstFactor) ||
+                       (mode.alphaSrcFactor != last.alphaSrcFactor) || (mode.alphaDstFactor != last.alphaDstFactor);
+    if (!m_cache.enable || funcChanged)
     {
-        glCheck(GLEXT_glBlendFuncSeparate(
-            factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
-            factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+        if (GLEXT_blend_func_separate)
+        {
+            glCheck(GLEXT_glBlendFuncSeparate(
+                factorToGlConstant(mode.colorSrcFactor), factorToGlConstant(mode.colorDstFactor),
+                factorToGlConstant(mode.alphaSrcFactor), factorToGlConstant(mode.alphaDstFactor)));
+        }
+        else
+        {
+            glCheck(glBlendFunc(
+                factorToGlConstant(mode.colorSrcFactor),
+                factorToGlConstant(mode.colorDstFactor)));
+        }
+
+        if (m_profiler)
+            m_profiler->countStateChange();
     }
-    else
+    else if (m_profiler)
     {
-        glCheck(glBlendFunc(
-            factorToGlConstant(mode.colorSrcFactor),
-            factorToGlConstant(mode.colorDstFactor)));
+        m_profiler->countSkippedStateChange();
     }
 
-    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    // Apply the blend equation the same way
+    bool equationChanged = (mode.colorEquation != last.colorEquation) || (mode.alphaEquation != last.alphaEquation);
+    if (m_cache.enable && !equationChanged)
+    {
+        if (m_profiler)
+            m_profiler->countSkippedStateChange();
+    }
+    else if (GLEXT_blend_minmax && GLEXT_blend_subtract)
     {
         if (GLEXT_blend_equation_separate)
         {
@@ -602,6 +1000,9 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
         {
             glCheck(GLEXT_glBlendEquation(equationToGlConstant(mode.colorEquation)));
         }
+
+        if (m_profiler)
+            m_profiler->countStateChange();
     }
     else if ((mode.colorEquation != BlendMode::Add) || (mode.alphaEquation != BlendMode::Add))
     {
@@ -624,48 +1025,117 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
+    // Many consecutive entities share the same transform (e.g. the
+    // identity used with the vertex cache), don't load it again
+    if (m_cache.enable && (transform == m_cache.lastTransform))
+    {
+        if (m_profiler)
+            m_profiler->countSkippedStateChange();
+
+        return;
+    }
+
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
-    if (transform == Transform::Identity)
+    if (m_core)
+        m_core->setModelViewMatrix(transform.getMatrix());
+    else if (transform == Transform::Identity)
         glCheck(glLoadIdentity());
     else
         glCheck(glLoadMatrixf(transform.getMatrix()));
+
+    m_cache.lastTransform = transform;
+
+    if (m_profiler)
+        m_profiler->countStateChange();
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTexture(const Texture* texture)
 {
-    Texture::bind(texture, Texture::Pixels);
+    // Wait for the last update of the texture if it was made in another context
+    if (texture)
+        texture->waitForUpdate();
+
+    // Bind the texture directly rather than through Texture::bind,
+    // so that the texture matrix is only loaded when it changes
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture ? texture->m_texture : 0));
+
+    // Texture coordinates are in pixels, they must be converted to
+    // normalized coordinates (and flipped if needed) by the texture matrix
+    GLfloat matrix[16];
+    if (texture)
+        texture->computeMatrix(Texture::Pixels, matrix);
+    else
+        std::memcpy(matrix, identityMatrix, sizeof(matrix));
+
+    if (m_core)
+    {
+        // The default program also needs to know whether there is a texture to sample
+        m_core->setTexture(matrix, texture != NULL);
+    }
+    else if (!m_cache.enable || (std::memcmp(matrix, m_cache.lastTextureMatrix, sizeof(matrix)) != 0))
+    {
+        glCheck(glMatrixMode(GL_TEXTURE));
+        glCheck(glLoadMatrixf(matrix));
+
+        // Go back to model-view mode
+        glCheck(glMatrixMode(GL_MODELVIEW));
+
+        std::memcpy(m_cache.lastTextureMatrix, matrix, sizeof(matrix));
+    }
+    else if (m_profiler)
+    {
+        m_profiler->countSkippedStateChange();
+    }
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+
+    if (m_profiler)
+        m_profiler->countTextureBind();
 }
 
 
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyShader(const Shader* shader)
 {
-    Shader::bind(shader);
+    if (m_core)
+        m_core->useProgram(shader);
+    else
+        Shader::bind(shader);
+
+    m_cache.lastShaderId = shader ? shader->m_cacheId : 0;
+
+    if (m_profiler)
+        m_profiler->countShaderBind();
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
+bool RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
 {
     // First set the persistent OpenGL states if it's the very first call
     if (!m_cache.glStatesSet)
         resetGLStates();
 
+    if (m_cache.drawingSkipped)
+        return false;
+
+    if (m_profiler)
+        m_profiler->beginFrame();
+
+    // Vertex array objects belong to a single context, make sure we use the
+    // one of the current context if another target may have been active
+    if (m_core && !m_cache.enable)
+        m_core->activate();
+
+    // Since vertices are pre-transformed when using the vertex
+    // cache, we must use an identity transform to render them
     if (useVertexCache)
-    {
-        // Since vertices are transformed, we must use an identity transform to render them
-        if (!m_cache.enable || !m_cache.useVertexCache)
-            glCheck(glLoadIdentity());
-    }
+        applyTransform(Transform::Identity);
     else
-    {
         applyTransform(states.transform);
-    }
 
     // Apply the view
     if (!m_cache.enable || m_cache.viewChanged)
@@ -674,6 +1144,8 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     // Apply the blend mode
     if (!m_cache.enable || (states.blendMode != m_cache.lastBlendMode))
         applyBlendMode(states.blendMode);
+    else if (m_profiler)
+        m_profiler->countSkippedStateChange();
 
     // Apply the texture
     if (!m_cache.enable || (states.texture && states.texture->m_fboAttachment))
@@ -691,11 +1163,36 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
         Uint64 textureId = states.texture ? states.texture->m_cacheId : 0;
         if (textureId != m_cache.lastTextureId)
             applyTexture(states.texture);
+        else if (m_profiler)
+            m_profiler->countSkippedStateChange();
     }
 
     // Apply the shader
-    if (states.shader)
-        applyShader(states.shader);
+    if (!m_cache.enable)
+    {
+        // We don't know which program is currently bound
+        if (m_core || states.shader || Shader::isAvailable())
+            applyShader(states.shader);
+    }
+    else if (states.shader)
+    {
+        // Like textures, shaders using textures that are FBO attachments are always
+        // rebound, so that their textures are rebound too (see above)
+        bool rebind = (states.shader->m_cacheId != m_cache.lastShaderId);
+        for (Shader::TextureTable::const_iterator it = states.shader->m_textures.begin(); !rebind && (it != states.shader->m_textures.end()); ++it)
+            rebind = it->second->m_fboAttachment;
+
+        if (rebind)
+            applyShader(states.shader);
+        else if (m_profiler)
+            m_profiler->countSkippedStateChange();
+    }
+    else if (m_cache.lastShaderId)
+    {
+        applyShader(NULL);
+    }
+
+    return true;
 }
 
 
@@ -707,18 +1204,157 @@ void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, s
                                    GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
     GLenum mode = modes[type];
 
+    // GL_QUADS is unavailable in core profile contexts
+    if (m_core && (type == Quads))
+    {
+        err() << "sf::Quads primitive type is not supported within core profile contexts, drawing skipped" << std::endl;
+        return;
+    }
+
     // Draw the primitives
     glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
 }
 
 
 ////////////////////////////////////////////////////////////
-void RenderTarget::cleanupDraw(const RenderStates& states)
+void RenderTarget::drawIndexedPrimitives(PrimitiveType type, const void* indices, std::size_t indexCount, IndexBuffer::IndexType indexType, std::size_t baseVertex)
 {
-    // Unbind the shader, if any
-    if (states.shader)
-        applyShader(NULL);
+    // Find the OpenGL primitive and index types
+    static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
+                                   GL_TRIANGLE_STRIP, GL_TRIANGLE_FAN, GL_QUADS};
+    GLenum mode = modes[type];
+    GLenum glIndexType = (indexType == IndexBuffer::Index32) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+
+    // GL_QUADS is unavailable in core profile contexts
+    if (m_core && (type == Quads))
+    {
+        err() << "sf::Quads primitive type is not supported within core profile contexts, drawing skipped" << std::endl;
+        return;
+    }
+
+    // Vertices streamed by the core backend don't start at the beginning of the buffer
+    #ifndef SFML_OPENGL_ES
+        if (baseVertex)
+        {
+            glCheck(glDrawElementsBaseVertex(mode, static_cast<GLsizei>(indexCount), glIndexType, indices, static_cast<GLint>(baseVertex)));
+            return;
+        }
+    #endif
+
+    // Draw the primitives
+    glCheck(glDrawElements(mode, static_cast<GLsizei>(indexCount), glIndexType, indices));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::drawVertices(const Vertex* vertices, std::size_t vertexCount, const void* indices, std::size_t indexCount,
+                                IndexBuffer::IndexType indexType, PrimitiveType type, const RenderStates& states)
+{
+    if (isActive(m_id) || setActive(true))
+    {
+        // Check if the vertex count is low enough so that we can pre-transform them
+        bool useVertexCache = (vertexCount <= StatesCache::VertexCacheSize);
 
+        if (useVertexCache)
+        {
+            // Pre-transform the vertices and store them into the vertex cache
+            for (std::size_t i = 0; i < vertexCount; ++i)
+            {
+                Vertex& vertex = m_cache.vertexCache[i];
+                vertex.position = states.transform * vertices[i].position;
+                vertex.color = vertices[i].color;
+                vertex.texCoords = vertices[i].texCoords;
+            }
+        }
+
+        if (!setupDraw(useVertexCache, states))
+            return;
+
+        // Check if texture coordinates array is needed, and update client state accordingly
+        bool enableTexCoordsArray = (states.texture || states.shader);
+        if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
+        {
+            if (m_core)
+                m_core->setTexCoordsArrayEnabled(enableTexCoordsArray);
+            else if (enableTexCoordsArray)
+                glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+            else
+                glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+        }
+        else if (m_profiler)
+        {
+            m_profiler->countSkippedStateChange();
+        }
+
+        // If we pre-transform the vertices, we must use our internal vertex cache
+        const char* data = reinterpret_cast<const char*>(vertices);
+        if (useVertexCache)
+            data = reinterpret_cast<const char*>(m_cache.vertexCache);
+
+        std::size_t firstVertex = 0;
+        if (m_core)
+        {
+            // Core contexts can't source vertices from client memory, upload them instead
+            bool setupPointers = !m_cache.enable || m_cache.lastVertexBufferId || !m_cache.texCoordsPointerSet;
+            firstVertex = m_core->streamVertices(reinterpret_cast<const Vertex*>(data), vertexCount, setupPointers);
+
+            m_cache.texCoordsPointerSet = true;
+        }
+        // Set up the pointers to the vertices' components, unless
+        // they already point to the same memory (e.g. the vertex cache)
+        else if (!m_cache.enable || m_cache.lastVertexBufferId || (data != m_cache.lastArrayData))
+        {
+            glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
+            glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
+            if (enableTexCoordsArray)
+                glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+
+            m_cache.texCoordsPointerSet = enableTexCoordsArray;
+        }
+        else if (enableTexCoordsArray && !m_cache.texCoordsPointerSet)
+        {
+            glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+
+            m_cache.texCoordsPointerSet = true;
+        }
+        else if (m_profiler)
+        {
+            m_profiler->countSkippedStateChange();
+        }
+
+        if (!indices)
+        {
+            drawPrimitives(type, firstVertex, vertexCount);
+        }
+        else if (m_core)
+        {
+            // Core contexts can't source indices from client memory either
+            std::size_t indexSize = (indexType == IndexBuffer::Index32) ? sizeof(Uint32) : sizeof(Uint16);
+            std::size_t offset = m_core->streamIndices(indices, indexSize * indexCount);
+            drawIndexedPrimitives(type, reinterpret_cast<const void*>(offset), indexCount, indexType, firstVertex);
+        }
+        else
+        {
+            drawIndexedPrimitives(type, indices, indexCount, indexType, 0);
+        }
+
+        cleanupDraw(states);
+
+        if (m_profiler)
+            m_profiler->countDraw(indices ? indexCount : vertexCount);
+
+        // Update the cache
+        m_cache.lastArrayData = data;
+        m_cache.lastVertexBufferId = 0;
+        m_cache.useVertexCache = useVertexCache;
+        m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::cleanupDraw(const RenderStates& states)
+{
     // If the texture we used to draw belonged to a RenderTexture, then forcibly unbind that texture.
     // This prevents a bug where some drivers do not clear RenderTextures properly.
     if (states.texture && states.texture->m_fboAttachment)
@@ -734,10 +1370,19 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 ////////////////////////////////////////////////////////////
 // Render states caching strategies
 //
+// * General
+//   Every piece of OpenGL state that we set is shadowed in
+//   the cache, and the corresponding call is skipped if the
+//   value is already set. The shadow values are only trusted
+//   while the cache is enabled; it gets disabled whenever
+//   another RenderTarget may have touched the context, or when
+//   the user's states are restored by popGLStates, which forces
+//   every state to be applied again on the next draw.
+//
 // * View
-//   If SetView was called since last draw, the projection
-//   matrix is updated. We don't need more, the view doesn't
-//   change frequently.
+//   If SetView was called since last draw, the viewport and the
+//   projection matrix are compared to the ones that are set
+//   and updated if they differ.
 //
 // * Transform
 //   The transform matrix is usually expensive because each
@@ -745,25 +1390,46 @@ void RenderTarget::cleanupDraw(const RenderStates& states)
 //   lead, in worst case, to changing it every 4 vertices.
 //   To avoid that, when the vertex count is low enough, we
 //   pre-transform them and therefore use an identity transform
-//   to render them.
+//   to render them. The last loaded matrix is cached so that
+//   consecutive identical transforms are only loaded once.
 //
 // * Blending mode
 //   Since it overloads the == operator, we can easily check
 //   whether any of the 6 blending components changed and,
-//   thus, whether we need to update the blend mode.
+//   thus, whether we need to update the blend mode. The blend
+//   function and blend equation are then updated separately.
+//
+// * Core profile
+//   Core profile contexts have no fixed-function pipeline, a
+//   priv::RenderTargetCore then takes over: vertices are appended
+//   to a streaming vertex buffer, which is only orphaned when full,
+//   and drawn through a vertex array object and a default program
+//   using the OpenGL 3.2 entry points; matrices become uniforms.
+//   The profile of each context is retrieved only once. If the
+//   OpenGL 3.2 functions are missing, drawing is skipped.
+//   The caching strategies described here apply the same way.
+//
+// * Vertex arrays
+//   The client memory or vertex buffer that the array pointers
+//   point to is cached, so that drawing the vertex cache or the
+//   same vertex buffer several times in a row doesn't set them
+//   up again.
 //
 // * Texture
 //   Storing the pointer or OpenGL ID of the last used texture
 //   is not enough; if the sf::Texture instance is destroyed,
 //   both the pointer and the OpenGL ID might be recycled in
 //   a new texture instance. We need to use our own unique
-//   identifier system to ensure consistent caching.
+//   identifier system to ensure consistent caching. The
+//   texture matrix is cached as well, since textures of the
+//   same size share the same matrix.
 //
 // * Shader
-//   Shaders are very hard to optimize, because they have
-//   parameters that can be hard (if not impossible) to track,
-//   like matrices or textures. The only optimization that we
-//   do is that we avoid setting a null shader if there was
-//   already none for the previous draw.
+//   Shaders use the same unique identifier system as textures.
+//   The identifier changes whenever the program or its table of
+//   textures changes, so a shader stays bound between draws
+//   that use it and is only rebound (or unbound) when needed.
+//   Other uniforms don't need tracking, they are stored in the
+//   program itself.
 //
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,611 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTargetCore.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+
+#ifndef SFML_OPENGL_ES
+
+namespace
+{
+    // Vertex array objects of all contexts, they can't be shared
+    // so each context gets its own, destroyed along with it
+    typedef std::map<sf::Uint64, GLuint> VertexArrayMap;
+    VertexArrayMap vertexArrays;
+
+    // Profile of all contexts, retrieved once for each of them
+    struct ContextInfo
+    {
+        bool coreProfile;  // Does the context lack the fixed-function pipeline?
+        bool programmable; // Does the context provide OpenGL 3.2?
+    };
+    typedef std::map<sf::Uint64, ContextInfo> ContextInfoMap;
+    ContextInfoMap contextInfos;
+
+    sf::Mutex contextsMutex;
+
+    // The streaming buffers are never smaller than this, so that a frame
+    // made of many small draws fills them before they have to be orphaned
+    const std::size_t minStreamSize = 16384;     // in vertices
+    const std::size_t minIndexSize  = 64 * 1024; // in bytes
+
+    // Callback that is called every time a context is destroyed
+    void contextDestroyCallback(void*)
+    {
+        sf::Lock lock(contextsMutex);
+
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+        VertexArrayMap::iterator iter = vertexArrays.find(contextId);
+
+        if (iter != vertexArrays.end())
+        {
+            glCheck(glDeleteVertexArrays(1, &iter->second));
+            vertexArrays.erase(iter);
+        }
+
+        contextInfos.erase(contextId);
+    }
+
+    // Source code of the default program, which does what
+    // the fixed-function pipeline does for SFML
+    const char* vertexShaderSource =
+        "#version 150\n"
+        "uniform mat4 sf_projectionMatrix;\n"
+        "uniform mat4 sf_modelViewMatrix;\n"
+        "uniform mat4 sf_textureMatrix;\n"
+        "in vec2 sf_position;\n"
+        "in vec4 sf_color;\n"
+        "in vec2 sf_texCoords;\n"
+        "out vec4 color;\n"
+        "out vec2 texCoords;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_projectionMatrix * sf_modelViewMatrix * vec4(sf_position, 0.0, 1.0);\n"
+        "    color = sf_color;\n"
+        "    texCoords = (sf_textureMatrix * vec4(sf_texCoords, 0.0, 1.0)).xy;\n"
+        "}\n";
+
+    const char* fragmentShaderSource =
+        "#version 150\n"
+        "uniform sampler2D sf_texture;\n"
+        "uniform bool sf_textureEnabled;\n"
+        "in vec4 color;\n"
+        "in vec2 texCoords;\n"
+        "out vec4 fragColor;\n"
+        "void main()\n"
+        "{\n"
+        "    fragColor = sf_textureEnabled ? color * texture(sf_texture, texCoords) : color;\n"
+        "}\n";
+
+    // Compile a shader and attach it to a program
+    bool attachShader(GLuint program, GLenum type, const char* source)
+    {
+        GLuint shader;
+        glCheck(shader = glCreateShader(type));
+        glCheck(glShaderSource(shader, 1, &source, NULL));
+        glCheck(glCompileShader(shader));
+
+        // Check the compile log
+        GLint success;
+        glCheck(glGetShaderiv(shader, GL_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(glGetShaderInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile default shader:" << std::endl
+                      << log << std::endl;
+            glCheck(glDeleteShader(shader));
+            return false;
+        }
+
+        // Attach the shader to the program, and delete it (not needed anymore)
+        glCheck(glAttachShader(program, shader));
+        glCheck(glDeleteShader(shader));
+
+        return true;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+RenderTargetCore::Uniforms::Uniforms() :
+projectionMatrix(-1),
+modelViewMatrix (-1),
+textureMatrix   (-1),
+textureEnabled  (-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTargetCore::RenderTargetCore() :
+m_program        (0),
+m_defaultUniforms(),
+m_uniforms       (),
+m_streamBuffer   (0),
+m_streamSize     (0),
+m_streamOffset   (0),
+m_indexBuffer    (0),
+m_indexSize      (0),
+m_indexOffset    (0),
+m_textureEnabled (false)
+{
+    static const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                       0.f, 1.f, 0.f, 0.f,
+                                       0.f, 0.f, 1.f, 0.f,
+                                       0.f, 0.f, 0.f, 1.f};
+
+    std::memcpy(m_projection, identity, sizeof(identity));
+    std::memcpy(m_modelView, identity, sizeof(identity));
+    std::memcpy(m_textureMatrix, identity, sizeof(identity));
+
+    // Register the context destruction callback
+    registerContextDestroyCallback(contextDestroyCallback, 0);
+
+    // Create the default program
+    GLuint program;
+    glCheck(program = glCreateProgram());
+
+    if (!attachShader(program, GL_VERTEX_SHADER, vertexShaderSource) ||
+        !attachShader(program, GL_FRAGMENT_SHADER, fragmentShaderSource))
+    {
+        glCheck(glDeleteProgram(program));
+        return;
+    }
+
+    glCheck(glBindAttribLocation(program, PositionAttribute, "sf_position"));
+    glCheck(glBindAttribLocation(program, ColorAttribute, "sf_color"));
+    glCheck(glBindAttribLocation(program, TexCoordsAttribute, "sf_texCoords"));
+    glCheck(glLinkProgram(program));
+
+    // Check the link log
+    GLint success;
+    glCheck(glGetProgramiv(program, GL_LINK_STATUS, &success));
+    if (success == GL_FALSE)
+    {
+        char log[1024];
+        glCheck(glGetProgramInfoLog(program, sizeof(log), 0, log));
+        err() << "Failed to link default shader:" << std::endl
+              << log << std::endl;
+        glCheck(glDeleteProgram(program));
+        return;
+    }
+
+    m_program = static_cast<unsigned int>(program);
+    getUniforms(m_program, m_defaultUniforms);
+    m_uniforms = m_defaultUniforms;
+
+    // Create the streaming vertex and index buffers
+    GLuint buffers[2] = {0, 0};
+    glCheck(glGenBuffers(2, buffers));
+    m_streamBuffer = static_cast<unsigned int>(buffers[0]);
+    m_indexBuffer = static_cast<unsigned int>(buffers[1]);
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTargetCore::~RenderTargetCore()
+{
+    TransientContextLock lock;
+
+    // Programs and buffers are shared, so any context can destroy them
+    if (m_program)
+        glCheck(glDeleteProgram(static_cast<GLuint>(m_program)));
+
+    if (m_streamBuffer)
+    {
+        GLuint buffer = static_cast<GLuint>(m_streamBuffer);
+        glCheck(glDeleteBuffers(1, &buffer));
+    }
+
+    if (m_indexBuffer)
+    {
+        GLuint buffer = static_cast<GLuint>(m_indexBuffer);
+        glCheck(glDeleteBuffers(1, &buffer));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTargetCore::isCoreProfile()
+{
+    bool coreProfile;
+    bool programmable;
+    getContextInfo(coreProfile, programmable);
+
+    return coreProfile;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTargetCore::isAvailable()
+{
+    // Make sure that extensions are initialized
+    ensureExtensionsInit();
+
+    if (!GLEXT_core_3_2)
+        return false;
+
+    bool coreProfile;
+    bool programmable;
+    getContextInfo(coreProfile, programmable);
+
+    return programmable;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::activate()
+{
+    GLuint vertexArray = 0;
+
+    {
+        Lock lock(contextsMutex);
+
+        Uint64 contextId = Context::getActiveContextId();
+        VertexArrayMap::iterator iter = vertexArrays.find(contextId);
+
+        if (iter != vertexArrays.end())
+        {
+            vertexArray = iter->second;
+        }
+        else
+        {
+            glCheck(glGenVertexArrays(1, &vertexArray));
+            vertexArrays.insert(std::make_pair(contextId, vertexArray));
+        }
+    }
+
+    glCheck(glBindVertexArray(vertexArray));
+    glCheck(glEnableVertexAttribArray(PositionAttribute));
+    glCheck(glEnableVertexAttribArray(ColorAttribute));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::useProgram(const Shader* shader)
+{
+    if (shader)
+    {
+        // Custom shaders bind their own textures, leave this to them
+        Shader::bind(shader);
+        getUniforms(shader->getNativeHandle(), m_uniforms);
+    }
+    else
+    {
+        glCheck(glUseProgram(static_cast<GLuint>(m_program)));
+        m_uniforms = m_defaultUniforms;
+    }
+
+    // Uniforms are stored in the program, bring them up to date
+    setProjectionMatrix(m_projection);
+    setModelViewMatrix(m_modelView);
+    setTexture(m_textureMatrix, m_textureEnabled);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setProjectionMatrix(const float* matrix)
+{
+    if (matrix != m_projection)
+        std::memcpy(m_projection, matrix, sizeof(m_projection));
+
+    if (m_uniforms.projectionMatrix != -1)
+        glCheck(glUniformMatrix4fv(m_uniforms.projectionMatrix, 1, GL_FALSE, m_projection));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setModelViewMatrix(const float* matrix)
+{
+    if (matrix != m_modelView)
+        std::memcpy(m_modelView, matrix, sizeof(m_modelView));
+
+    if (m_uniforms.modelViewMatrix != -1)
+        glCheck(glUniformMatrix4fv(m_uniforms.modelViewMatrix, 1, GL_FALSE, m_modelView));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setTexture(const float* matrix, bool enabled)
+{
+    if (matrix != m_textureMatrix)
+        std::memcpy(m_textureMatrix, matrix, sizeof(m_textureMatrix));
+
+    m_textureEnabled = enabled;
+
+    if (m_uniforms.textureMatrix != -1)
+        glCheck(glUniformMatrix4fv(m_uniforms.textureMatrix, 1, GL_FALSE, m_textureMatrix));
+
+    if (m_uniforms.textureEnabled != -1)
+        glCheck(glUniform1i(m_uniforms.textureEnabled, m_textureEnabled ? 1 : 0));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setTexCoordsArrayEnabled(bool enabled)
+{
+    if (enabled)
+        glCheck(glEnableVertexAttribArray(TexCoordsAttribute));
+    else
+        glCheck(glDisableVertexAttribArray(TexCoordsAttribute));
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTargetCore::streamVertices(const Vertex* vertices, std::size_t vertexCount, bool setupAttributePointers)
+{
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_streamBuffer));
+
+    // The vertices are appended after the ones of the previous draws, which the
+    // GPU may still be reading. Once the buffer is full its storage is orphaned,
+    // so that the driver can hand us fresh memory instead of waiting for them;
+    // the attribute pointers refer to the buffer, not its storage, so they stay valid
+    if (m_streamOffset + vertexCount > m_streamSize)
+    {
+        m_streamSize = std::max(m_streamSize, std::max(vertexCount, minStreamSize));
+        m_streamOffset = 0;
+        glCheck(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m_streamSize, NULL, GL_STREAM_DRAW));
+    }
+
+    std::size_t firstVertex = m_streamOffset;
+    glCheck(glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * firstVertex, sizeof(Vertex) * vertexCount, vertices));
+    m_streamOffset += vertexCount;
+
+    if (setupAttributePointers)
+        setupPointers();
+
+    return firstVertex;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTargetCore::streamIndices(const void* indices, std::size_t size)
+{
+    // The element array binding is part of the vertex array object state
+    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer));
+
+    // Same as the vertices; offsets are kept aligned on the largest index type
+    if (m_indexOffset + size > m_indexSize)
+    {
+        m_indexSize = std::max(m_indexSize, std::max(size, minIndexSize));
+        m_indexOffset = 0;
+        glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexSize, NULL, GL_STREAM_DRAW));
+    }
+
+    std::size_t offset = m_indexOffset;
+    glCheck(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, indices));
+    m_indexOffset += (size + 3) & ~static_cast<std::size_t>(3);
+
+    return offset;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setupPointers()
+{
+    glCheck(glVertexAttribPointer(PositionAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(0)));
+    glCheck(glVertexAttribPointer(ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
+    glCheck(glVertexAttribPointer(TexCoordsAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::getUniforms(unsigned int program, Uniforms& uniforms)
+{
+    glCheck(uniforms.projectionMatrix = glGetUniformLocation(program, "sf_projectionMatrix"));
+    glCheck(uniforms.modelViewMatrix = glGetUniformLocation(program, "sf_modelViewMatrix"));
+    glCheck(uniforms.textureMatrix = glGetUniformLocation(program, "sf_textureMatrix"));
+    glCheck(uniforms.textureEnabled = glGetUniformLocation(program, "sf_textureEnabled"));
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::getContextInfo(bool& coreProfile, bool& programmable)
+{
+    Lock lock(contextsMutex);
+
+    Uint64 contextId = Context::getActiveContextId();
+    ContextInfoMap::iterator iter = contextInfos.find(contextId);
+
+    if (iter == contextInfos.end())
+    {
+        ContextInfo info;
+        info.coreProfile = false;
+        info.programmable = false;
+
+        // Unlike GL_MAJOR_VERSION, the version string can be retrieved from
+        // any context without raising an error, and it starts with "major.minor"
+        const GLubyte* version = glGetString(GL_VERSION);
+        if (version)
+        {
+            int majorVersion = version[0] - '0';
+            int minorVersion = version[2] - '0';
+            info.programmable = (majorVersion > 3) || ((majorVersion == 3) && (minorVersion >= 2));
+        }
+
+        // The profile can only be retrieved from OpenGL 3.2 contexts, older ones are compatibility contexts
+        if (info.programmable)
+        {
+            GLint profile = 0;
+            glCheck(glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile));
+            info.coreProfile = (profile & GL_CONTEXT_CORE_PROFILE_BIT) != 0;
+        }
+
+        // The entry is removed when the context is destroyed
+        registerContextDestroyCallback(contextDestroyCallback, 0);
+
+        iter = contextInfos.insert(std::make_pair(contextId, info)).first;
+    }
+
+    coreProfile = iter->second.coreProfile;
+    programmable = iter->second.programmable;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#else // SFML_OPENGL_ES
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+RenderTargetCore::Uniforms::Uniforms() :
+projectionMatrix(-1),
+modelViewMatrix (-1),
+textureMatrix   (-1),
+textureEnabled  (-1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTargetCore::RenderTargetCore() :
+m_program        (0),
+m_defaultUniforms(),
+m_uniforms       (),
+m_streamBuffer   (0),
+m_streamSize     (0),
+m_streamOffset   (0),
+m_indexBuffer    (0),
+m_indexSize      (0),
+m_indexOffset    (0),
+m_textureEnabled (false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTargetCore::~RenderTargetCore()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTargetCore::isCoreProfile()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTargetCore::isAvailable()
+{
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::activate()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::useProgram(const Shader*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setProjectionMatrix(const float*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setModelViewMatrix(const float*)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setTexture(const float*, bool)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setTexCoordsArrayEnabled(bool)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTargetCore::streamVertices(const Vertex*, std::size_t, bool)
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTargetCore::streamIndices(const void*, std::size_t)
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::setupPointers()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::getUniforms(unsigned int, Uniforms&)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetCore::getContextInfo(bool& coreProfile, bool& programmable)
+{
+    coreProfile = false;
+    programmable = false;
+}
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_OPENGL_ES
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RENDERTARGETCORE_HPP
+#define SFML_RENDERTARGETCORE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Shader;
+
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Programmable pipeline used by render targets
+///        within core profile contexts
+///
+/// Core profile contexts don't provide the fixed-function
+/// pipeline (client-side arrays, matrix stacks, ...).
+/// This class replaces it with vertex array objects,
+/// streaming vertex and index buffers and a default shader program,
+/// which emulates what the fixed-function pipeline does
+/// for SFML.
+///
+////////////////////////////////////////////////////////////
+class RenderTargetCore : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Vertex attribute locations
+    ///
+    /// Custom shaders used in core profile contexts receive
+    /// the vertex components at these locations.
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Attribute
+    {
+        PositionAttribute  = 0, ///< Vertex position, named sf_position
+        ColorAttribute     = 1, ///< Vertex color, named sf_color
+        TexCoordsAttribute = 2  ///< Vertex texture coordinates, named sf_texCoords
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates the default program and the streaming
+    /// buffers; a context must be active.
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTargetCore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTargetCore();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the active context uses the core profile
+    ///
+    /// The profile is retrieved once per context, the following
+    /// calls don't query OpenGL.
+    ///
+    /// \return True if the fixed-function pipeline is unavailable
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isCoreProfile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the active context supports the core backend
+    ///
+    /// The backend uses the OpenGL 3.2 entry points, which core
+    /// profile contexts provide without advertising the ARB
+    /// extensions that define them.
+    ///
+    /// \return True if the active context version is 3.2 or greater
+    ///         and all the entry points could be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bind the vertex array object of the active context
+    ///
+    /// Vertex array objects can't be shared between contexts,
+    /// one is created for each context on first use. The
+    /// position and color attribute arrays are enabled.
+    ///
+    ////////////////////////////////////////////////////////////
+    void activate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Use a program for drawing
+    ///
+    /// The matrices currently set are uploaded to the new program.
+    ///
+    /// \param shader Custom shader to use, or NULL to use the default program
+    ///
+    ////////////////////////////////////////////////////////////
+    void useProgram(const Shader* shader);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the projection matrix
+    ///
+    /// \param matrix 4x4 matrix, as an array of 16 floats
+    ///
+    ////////////////////////////////////////////////////////////
+    void setProjectionMatrix(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the model-view matrix
+    ///
+    /// \param matrix 4x4 matrix, as an array of 16 floats
+    ///
+    ////////////////////////////////////////////////////////////
+    void setModelViewMatrix(const float* matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture matrix and whether a texture is bound
+    ///
+    /// \param matrix  4x4 matrix, as an array of 16 floats
+    /// \param enabled True if a texture is bound to texture unit 0
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const float* matrix, bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the texture coordinates attribute array
+    ///
+    /// \param enabled True to enable the array
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexCoordsArrayEnabled(bool enabled);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload vertices to the streaming vertex buffer
+    ///
+    /// The vertices are written after the ones of the previous
+    /// calls, the buffer storage is only orphaned when it is full.
+    /// The streaming buffer is left bound.
+    ///
+    /// \param vertices               Pointer to the vertices
+    /// \param vertexCount            Number of vertices in the array
+    /// \param setupAttributePointers True to make the attribute arrays point to the streaming buffer
+    ///
+    /// \return Index of the first uploaded vertex in the streaming buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t streamVertices(const Vertex* vertices, std::size_t vertexCount, bool setupAttributePointers);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload indices to the streaming index buffer
+    ///
+    /// The streaming index buffer is left bound to the
+    /// vertex array object of the active context.
+    ///
+    /// \param indices Pointer to the indices
+    /// \param size    Size of the indices array, in bytes
+    ///
+    /// \return Offset of the uploaded indices in the streaming index buffer, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t streamIndices(const void* indices, std::size_t size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the attribute arrays point to the bound vertex buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setupPointers();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Locations of the uniforms set by the backend
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Uniforms
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Marks all the uniforms as missing.
+        ///
+        ////////////////////////////////////////////////////////////
+        Uniforms();
+
+        int projectionMatrix; ///< Location of sf_projectionMatrix
+        int modelViewMatrix;  ///< Location of sf_modelViewMatrix
+        int textureMatrix;    ///< Location of sf_textureMatrix
+        int textureEnabled;   ///< Location of sf_textureEnabled
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Look up the locations of our uniforms in a program
+    ///
+    /// \param program  OpenGL handle of the program
+    /// \param uniforms Structure receiving the locations, -1 for the missing ones
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getUniforms(unsigned int program, Uniforms& uniforms);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the profile of the active context
+    ///
+    /// \param coreProfile  Receives whether the context uses the core profile
+    /// \param programmable Receives whether the context version is 3.2 or greater
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getContextInfo(bool& coreProfile, bool& programmable);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    unsigned int m_program;           ///< OpenGL handle of the default program
+    Uniforms     m_defaultUniforms;   ///< Uniform locations of the default program
+    Uniforms     m_uniforms;          ///< Uniform locations of the program in use
+    unsigned int m_streamBuffer;      ///< OpenGL name of the streaming vertex buffer
+    std::size_t  m_streamSize;        ///< Size of the streaming vertex buffer, in vertices
+    std::size_t  m_streamOffset;      ///< Where the next vertices are written in the streaming vertex buffer, in vertices
+    unsigned int m_indexBuffer;       ///< OpenGL name of the streaming index buffer
+    std::size_t  m_indexSize;         ///< Size of the streaming index buffer, in bytes
+    std::size_t  m_indexOffset;       ///< Where the next indices are written in the streaming index buffer, in bytes
+    float        m_projection[16];    ///< Current projection matrix
+    float        m_modelView[16];     ///< Current model-view matrix
+    float        m_textureMatrix[16]; ///< Current texture matrix
+    bool         m_textureEnabled;    ///< Is a texture currently bound?
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTARGETCORE_HPP
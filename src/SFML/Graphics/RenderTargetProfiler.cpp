@@ -0,0 +1,407 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTargetProfiler.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <utility>
+
+
+namespace
+{
+    // Number of timer queries generated at once when the pool runs dry
+    const GLsizei queryBatchSize = 16;
+
+#ifndef SFML_OPENGL_ES
+
+    // Timer queries of profilers destroyed while their context was not active;
+    // queries can't be shared between contexts, so they can only be deleted
+    // once their own context is active again
+    typedef std::vector<std::pair<sf::Uint64, GLuint> > StaleQueries;
+    StaleQueries staleQueries;
+    sf::Mutex staleQueriesMutex;
+
+    // Delete the stale queries which belong to the active context
+    void destroyStaleQueries()
+    {
+        sf::Uint64 contextId = sf::Context::getActiveContextId();
+
+        sf::Lock lock(staleQueriesMutex);
+
+        for (StaleQueries::iterator iter = staleQueries.begin(); iter != staleQueries.end();)
+        {
+            if (iter->first == contextId)
+            {
+                glCheck(GLEXT_glDeleteQueries(1, &iter->second));
+                iter = staleQueries.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    // Callback that is called every time a context is destroyed
+    void contextDestroyCallback(void*)
+    {
+        destroyStaleQueries();
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // Compute the work done between two snapshots of the counters
+    sf::RenderStatistics::Counters difference(const sf::RenderStatistics::Counters& end, const sf::RenderStatistics::Counters& start)
+    {
+        sf::RenderStatistics::Counters counters;
+
+        counters.drawCalls           = end.drawCalls           - start.drawCalls;
+        counters.vertices            = end.vertices            - start.vertices;
+        counters.stateChanges        = end.stateChanges        - start.stateChanges;
+        counters.textureBinds        = end.textureBinds        - start.textureBinds;
+        counters.shaderBinds         = end.shaderBinds         - start.shaderBinds;
+        counters.skippedStateChanges = end.skippedStateChanges - start.skippedStateChanges;
+
+        return counters;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+RenderTargetProfiler::RenderTargetProfiler() :
+m_current    (0),
+m_frameIndex (0),
+m_scopeStack (),
+m_freeQueries(),
+m_contextId  (0),
+m_statistics ()
+{
+    for (std::size_t i = 0; i < FrameCount; ++i)
+        reset(m_frames[i]);
+
+#ifndef SFML_OPENGL_ES
+
+    // Register the context destruction callback
+    registerContextDestroyCallback(contextDestroyCallback, 0);
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTargetProfiler::~RenderTargetProfiler()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_contextId)
+        return;
+
+    // Give all the queries back to the pool
+    for (std::size_t i = 0; i < FrameCount; ++i)
+        reset(m_frames[i]);
+
+    if (m_freeQueries.empty())
+        return;
+
+    if (m_contextId == Context::getActiveContextId())
+    {
+        glCheck(GLEXT_glDeleteQueries(static_cast<GLsizei>(m_freeQueries.size()), &m_freeQueries[0]));
+    }
+    else
+    {
+        // Queries only exist within the context that created them: keep them
+        // until it gets active again, or until it is destroyed
+        Lock lock(staleQueriesMutex);
+
+        for (std::size_t i = 0; i < m_freeQueries.size(); ++i)
+            staleQueries.push_back(std::make_pair(m_contextId, static_cast<GLuint>(m_freeQueries[i])));
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::beginFrame()
+{
+    Frame& frame = m_frames[m_current];
+
+    if (frame.started)
+        return;
+
+    frame.started = true;
+
+    // Slots 0 and 1 hold the beginning and the end of the frame
+    frame.queries.push_back(recordTimestamp());
+    frame.queries.push_back(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::endFrame()
+{
+    Frame& frame = m_frames[m_current];
+
+    if (!m_scopeStack.empty())
+    {
+        err() << "Profiling scope \"" << frame.statistics.scopes[m_scopeStack.back().index].name
+              << "\" was not closed before the end of the frame" << std::endl;
+
+        while (!m_scopeStack.empty())
+            endScope();
+    }
+
+    if (frame.started)
+        frame.queries[1] = recordTimestamp();
+
+    frame.statistics.frame = m_frameIndex++;
+    frame.pending = true;
+
+    // Publish the finished frames whose results are ready, oldest first
+    for (std::size_t i = 1; i <= FrameCount; ++i)
+    {
+        Frame& finished = m_frames[(m_current + i) % FrameCount];
+
+        if (finished.pending && !resolve(finished, false))
+            break;
+    }
+
+    // Move on to the next frame; if the GPU lags so far behind that its
+    // previous results are still not ready, we have no choice but to wait
+    m_current = (m_current + 1) % FrameCount;
+
+    if (m_frames[m_current].pending)
+        resolve(m_frames[m_current], true);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::beginScope(const std::string& name)
+{
+    beginFrame();
+
+    Frame& frame = m_frames[m_current];
+
+    RenderStatistics::Scope scope;
+    scope.name = name;
+    scope.depth = static_cast<unsigned int>(m_scopeStack.size());
+
+    OpenScope openScope;
+    openScope.index = frame.statistics.scopes.size();
+    openScope.start = frame.statistics.counters;
+
+    frame.statistics.scopes.push_back(scope);
+    m_scopeStack.push_back(openScope);
+
+    frame.queries.push_back(recordTimestamp());
+    frame.queries.push_back(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::endScope()
+{
+    if (m_scopeStack.empty())
+    {
+        err() << "Trying to end a profiling scope which was never begun" << std::endl;
+        return;
+    }
+
+    Frame& frame = m_frames[m_current];
+    const OpenScope& openScope = m_scopeStack.back();
+
+    frame.statistics.scopes[openScope.index].counters = difference(frame.statistics.counters, openScope.start);
+    frame.queries[3 + 2 * openScope.index] = recordTimestamp();
+
+    m_scopeStack.pop_back();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::countDraw(std::size_t vertexCount)
+{
+    RenderStatistics::Counters& counters = m_frames[m_current].statistics.counters;
+
+    counters.drawCalls++;
+    counters.vertices += vertexCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::countStateChange()
+{
+    m_frames[m_current].statistics.counters.stateChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::countTextureBind()
+{
+    m_frames[m_current].statistics.counters.textureBinds++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::countShaderBind()
+{
+    m_frames[m_current].statistics.counters.shaderBinds++;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::countSkippedStateChange()
+{
+    m_frames[m_current].statistics.counters.skippedStateChanges++;
+}
+
+
+////////////////////////////////////////////////////////////
+const RenderStatistics& RenderTargetProfiler::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTargetProfiler::recordTimestamp()
+{
+#ifndef SFML_OPENGL_ES
+
+    // Make sure that extensions are initialized
+    ensureExtensionsInit();
+
+    if (!GLEXT_occlusion_query || !GLEXT_timer_query)
+        return 0;
+
+    // Queries can't be shared between contexts, so we stick
+    // to the one which was active when profiling started
+    Uint64 contextId = Context::getActiveContextId();
+
+    if (!m_contextId)
+        m_contextId = contextId;
+
+    if (contextId != m_contextId)
+        return 0;
+
+    if (m_freeQueries.empty())
+    {
+        // Take the opportunity to delete the queries left over by destroyed profilers
+        destroyStaleQueries();
+
+        m_freeQueries.resize(queryBatchSize);
+        glCheck(GLEXT_glGenQueries(queryBatchSize, &m_freeQueries[0]));
+    }
+
+    GLuint query = m_freeQueries.back();
+    m_freeQueries.pop_back();
+
+    glCheck(GLEXT_glQueryCounter(query, GLEXT_GL_TIMESTAMP));
+
+    return query;
+
+#else
+
+    return 0;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTargetProfiler::resolve(Frame& frame, bool wait)
+{
+    frame.statistics.gpuTimeAvailable = false;
+
+#ifndef SFML_OPENGL_ES
+
+    // GPU times are only known if every timestamp could be recorded
+    bool timed = !frame.queries.empty() && (m_contextId == Context::getActiveContextId());
+
+    for (std::size_t i = 0; timed && (i < frame.queries.size()); ++i)
+        timed = (frame.queries[i] != 0);
+
+    if (timed)
+    {
+        // The end of the frame is the last timestamp to be recorded
+        if (!wait)
+        {
+            GLuint available = GL_FALSE;
+            glCheck(GLEXT_glGetQueryObjectuiv(frame.queries[1], GLEXT_GL_QUERY_RESULT_AVAILABLE, &available));
+
+            if (available == GL_FALSE)
+                return false;
+        }
+
+        std::vector<GLuint64> timestamps(frame.queries.size());
+        for (std::size_t i = 0; i < frame.queries.size(); ++i)
+            glCheck(GLEXT_glGetQueryObjectui64v(frame.queries[i], GLEXT_GL_QUERY_RESULT, &timestamps[i]));
+
+        // Timestamps are in nanoseconds
+        frame.statistics.gpuTime = microseconds(static_cast<Int64>((timestamps[1] - timestamps[0]) / 1000));
+
+        for (std::size_t i = 0; i < frame.statistics.scopes.size(); ++i)
+            frame.statistics.scopes[i].gpuTime = microseconds(static_cast<Int64>((timestamps[3 + 2 * i] - timestamps[2 + 2 * i]) / 1000));
+
+        frame.statistics.gpuTimeAvailable = true;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    m_statistics = frame.statistics;
+    reset(frame);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTargetProfiler::reset(Frame& frame)
+{
+    // Give the queries back to the pool
+    for (std::size_t i = 0; i < frame.queries.size(); ++i)
+    {
+        if (frame.queries[i])
+            m_freeQueries.push_back(frame.queries[i]);
+    }
+
+    frame.statistics = RenderStatistics();
+    frame.queries.clear();
+    frame.started = false;
+    frame.pending = false;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_RENDERTARGETPROFILER_HPP
+#define SFML_RENDERTARGETPROFILER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderStatistics.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Gathers the statistics of a render target
+///
+////////////////////////////////////////////////////////////
+class RenderTargetProfiler : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTargetProfiler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The context of the render target is expected to be
+    /// active. Otherwise, since timer queries can't be shared
+    /// between contexts, they are destroyed the next time their
+    /// context gets active or when it is destroyed.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~RenderTargetProfiler();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the beginning of GPU work in the current frame
+    ///
+    /// Does nothing if the frame has already started.
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish the current frame and start a new one
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Open a named scope
+    ///
+    /// \param name Name of the scope
+    ///
+    ////////////////////////////////////////////////////////////
+    void beginScope(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Close the most recently opened scope
+    ///
+    ////////////////////////////////////////////////////////////
+    void endScope();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a draw call
+    ///
+    /// \param vertexCount Number of vertices drawn
+    ///
+    ////////////////////////////////////////////////////////////
+    void countDraw(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a view, transform or blend mode change
+    ///
+    ////////////////////////////////////////////////////////////
+    void countStateChange();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a texture bind
+    ///
+    ////////////////////////////////////////////////////////////
+    void countTextureBind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a shader bind
+    ///
+    ////////////////////////////////////////////////////////////
+    void countShaderBind();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Count a state change that was skipped because it was redundant
+    ///
+    ////////////////////////////////////////////////////////////
+    void countSkippedStateChange();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the statistics of the last resolved frame
+    ///
+    /// \return Statistics of the last frame whose results are ready
+    ///
+    ////////////////////////////////////////////////////////////
+    const RenderStatistics& getStatistics() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Frame whose statistics are being gathered or resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Frame
+    {
+        RenderStatistics          statistics; ///< Statistics gathered so far
+        std::vector<unsigned int> queries;    ///< Timestamp queries: frame begin, frame end, then begin/end of each scope
+        bool                      started;    ///< Has GPU work been submitted in this frame?
+        bool                      pending;    ///< Is the frame finished and waiting for its GPU results?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Scope which has been opened but not closed yet
+    ///
+    ////////////////////////////////////////////////////////////
+    struct OpenScope
+    {
+        std::size_t                index; ///< Index of the scope in the frame statistics
+        RenderStatistics::Counters start; ///< Frame counters when the scope was opened
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Record a GPU timestamp
+    ///
+    /// \return Query holding the timestamp, 0 if none could be recorded
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int recordTimestamp();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read back the GPU times of a finished frame and publish it
+    ///
+    /// \param frame Frame to resolve
+    /// \param wait  Wait for the results if they are not ready yet?
+    ///
+    /// \return True if the frame was resolved
+    ///
+    ////////////////////////////////////////////////////////////
+    bool resolve(Frame& frame, bool wait);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset a frame so that it can be used to gather new statistics
+    ///
+    /// \param frame Frame to reset
+    ///
+    ////////////////////////////////////////////////////////////
+    void reset(Frame& frame);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    enum {FrameCount = 3};
+
+    Frame                     m_frames[FrameCount]; ///< Ring of frames, so that GPU results can be read back without stalling
+    std::size_t               m_current;            ///< Index of the frame currently being gathered
+    Uint64                    m_frameIndex;         ///< Index of the current frame since profiling started
+    std::vector<OpenScope>    m_scopeStack;         ///< Open scopes of the current frame, innermost last
+    std::vector<unsigned int> m_freeQueries;        ///< Timer queries available for reuse
+    Uint64                    m_contextId;          ///< Context owning the timer queries
+    RenderStatistics          m_statistics;         ///< Statistics of the last resolved frame
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_RENDERTARGETPROFILER_HPP
@@ -166,7 +166,12 @@ void RenderTexture::display()
         m_impl->updateTexture(m_texture.m_texture);
         m_texture.m_pixelsFlipped = true;
         m_texture.invalidateMipmap();
+
+        // Make sure that the other contexts drawing the texture will see it updated
+        m_texture.signalUpdate();
     }
+
+    RenderTarget::endProfilingFrame();
 }
 
 
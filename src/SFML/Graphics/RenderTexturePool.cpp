@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RenderTexturePool.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace
+{
+    // Round a size up to the next multiple of the granularity
+    unsigned int roundUp(unsigned int size, unsigned int granularity)
+    {
+        return ((size + granularity - 1) / granularity) * granularity;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RenderTexturePool::RenderTexturePool() :
+m_unused        (),
+m_used          (),
+m_granularity   (1),
+m_maxUnusedCount(16)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::~RenderTexturePool()
+{
+    for (UnusedList::iterator it = m_unused.begin(); it != m_unused.end(); ++it)
+        delete it->renderTexture;
+
+    for (UsedMap::iterator it = m_used.begin(); it != m_used.end(); ++it)
+        delete it->first;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* RenderTexturePool::acquire(unsigned int width, unsigned int height, const ContextSettings& settings)
+{
+    Bucket bucket(roundUp(width, m_granularity), roundUp(height, m_granularity), settings);
+
+    // Look for an unused render-texture in the same bucket, most recently released first
+    for (UnusedList::iterator it = m_unused.begin(); it != m_unused.end(); ++it)
+    {
+        if (it->bucket == bucket)
+        {
+            RenderTexture* renderTexture = it->renderTexture;
+            m_unused.erase(it);
+
+            // Make it look like a freshly created render-texture
+            renderTexture->setView(renderTexture->getDefaultView());
+            renderTexture->setSmooth(false);
+            renderTexture->setRepeated(false);
+
+            m_used.insert(std::make_pair(renderTexture, bucket));
+            return renderTexture;
+        }
+    }
+
+    // None available: create a new one
+    RenderTexture* renderTexture = new RenderTexture;
+    if (!renderTexture->create(bucket.width, bucket.height, settings))
+    {
+        err() << "Failed to create pooled render texture (" << bucket.width << "x" << bucket.height << ")" << std::endl;
+        delete renderTexture;
+        return NULL;
+    }
+
+    m_used.insert(std::make_pair(renderTexture, bucket));
+    return renderTexture;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::release(RenderTexture* renderTexture)
+{
+    if (!renderTexture)
+        return;
+
+    UsedMap::iterator it = m_used.find(renderTexture);
+    if (it == m_used.end())
+    {
+        err() << "Trying to release a render texture which doesn't belong to the pool" << std::endl;
+        return;
+    }
+
+    m_unused.push_front(Entry(it->second, renderTexture));
+    m_used.erase(it);
+
+    trim();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::setGranularity(unsigned int granularity)
+{
+    m_granularity = granularity > 0 ? granularity : 1;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int RenderTexturePool::getGranularity() const
+{
+    return m_granularity;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::setMaximumUnusedCount(std::size_t count)
+{
+    m_maxUnusedCount = count;
+
+    trim();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getMaximumUnusedCount() const
+{
+    return m_maxUnusedCount;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getUsedCount() const
+{
+    return m_used.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexturePool::getUnusedCount() const
+{
+    return m_unused.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::purge()
+{
+    for (UnusedList::iterator it = m_unused.begin(); it != m_unused.end(); ++it)
+        delete it->renderTexture;
+
+    m_unused.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTexturePool::trim()
+{
+    // The least recently released render-textures are at the back
+    while (m_unused.size() > m_maxUnusedCount)
+    {
+        delete m_unused.back().renderTexture;
+        m_unused.pop_back();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::Bucket::Bucket(unsigned int bucketWidth, unsigned int bucketHeight, const ContextSettings& settings) :
+width            (bucketWidth),
+height           (bucketHeight),
+depthBits        (settings.depthBits),
+stencilBits      (settings.stencilBits),
+antialiasingLevel(settings.antialiasingLevel),
+sRgbCapable      (settings.sRgbCapable)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool RenderTexturePool::Bucket::operator ==(const Bucket& right) const
+{
+    return (width             == right.width)             &&
+           (height            == right.height)            &&
+           (depthBits         == right.depthBits)         &&
+           (stencilBits       == right.stencilBits)       &&
+           (antialiasingLevel == right.antialiasingLevel) &&
+           (sRgbCapable       == right.sRgbCapable);
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexturePool::Entry::Entry(const Bucket& entryBucket, RenderTexture* entryTexture) :
+bucket       (entryBucket),
+renderTexture(entryTexture)
+{
+}
+
+} // namespace sf
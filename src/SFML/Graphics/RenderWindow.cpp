@@ -95,6 +95,16 @@ bool RenderWindow::setActive(bool active)
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderWindow::display()
+{
+    // Finish the current profiling frame before the frame is shown
+    RenderTarget::endProfilingFrame();
+
+    Window::display();
+}
+
+
 ////////////////////////////////////////////////////////////
 Image RenderWindow::capture() const
 {
@@ -27,6 +27,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/RenderTargetCore.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Color.hpp>
@@ -40,6 +41,23 @@
 #include <vector>
 
 
+namespace
+{
+    sf::Mutex idMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no shader"
+
+        return id++;
+    }
+}
+
+
 #ifndef SFML_OPENGL_ES
 
 #if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
@@ -54,11 +72,97 @@
 
 #endif
 
+// Call an OpenGL 3.2 shader function in core profile contexts, which don't provide
+// ARB_shader_objects, or its ARB equivalent (same name and parameters) otherwise
+#define shaderCall(core, function, args) do { if (core) glCheck(function args); else glCheck(GLEXT_##function args); } while (false)
+
 namespace
 {
     sf::Mutex maxTextureUnitsMutex;
     sf::Mutex isAvailableMutex;
 
+    // Tell whether the active context is a core profile context,
+    // in which shaders must be used with the OpenGL 3.2 functions
+    bool useCoreFunctions()
+    {
+        return sf::priv::RenderTargetCore::isCoreProfile() && sf::priv::RenderTargetCore::isAvailable();
+    }
+
+    // Get the program object currently in use
+    GLEXT_GLhandle getCurrentProgram(bool core)
+    {
+        if (core)
+        {
+            GLint program = 0;
+            glCheck(glGetIntegerv(GL_CURRENT_PROGRAM, &program));
+            return castToGlHandle(static_cast<unsigned int>(program));
+        }
+
+        GLEXT_GLhandle program = 0;
+        glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+        return program;
+    }
+
+    // Use a program object for rendering
+    void useProgram(bool core, GLEXT_GLhandle program)
+    {
+        if (core)
+            glCheck(glUseProgram(castFromGlHandle(program)));
+        else
+            glCheck(GLEXT_glUseProgramObject(program));
+    }
+
+    // Delete a shader or program object
+    void deleteObject(bool core, GLEXT_GLhandle object, bool isProgram)
+    {
+        if (!core)
+            glCheck(GLEXT_glDeleteObject(object));
+        else if (isProgram)
+            glCheck(glDeleteProgram(castFromGlHandle(object)));
+        else
+            glCheck(glDeleteShader(castFromGlHandle(object)));
+    }
+
+    // Create and compile a shader object, return 0 (after logging the error) on failure
+    GLEXT_GLhandle compileShader(bool core, GLenum type, const char* code, const char* typeName)
+    {
+        GLEXT_GLhandle shader = 0;
+        GLint success = GL_FALSE;
+        char log[1024] = "";
+
+        if (core)
+        {
+            GLuint object = 0;
+            glCheck(object = glCreateShader(type));
+            glCheck(glShaderSource(object, 1, &code, NULL));
+            glCheck(glCompileShader(object));
+            glCheck(glGetShaderiv(object, GL_COMPILE_STATUS, &success));
+            if (success == GL_FALSE)
+                glCheck(glGetShaderInfoLog(object, sizeof(log), 0, log));
+
+            shader = castToGlHandle(object);
+        }
+        else
+        {
+            glCheck(shader = GLEXT_glCreateShaderObject(type));
+            glCheck(GLEXT_glShaderSource(shader, 1, &code, NULL));
+            glCheck(GLEXT_glCompileShader(shader));
+            glCheck(GLEXT_glGetObjectParameteriv(shader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
+            if (success == GL_FALSE)
+                glCheck(GLEXT_glGetInfoLog(shader, sizeof(log), 0, log));
+        }
+
+        if (success == GL_FALSE)
+        {
+            sf::err() << "Failed to compile " << typeName << " shader:" << std::endl
+                      << log << std::endl;
+            deleteObject(core, shader, false);
+            return 0;
+        }
+
+        return shader;
+    }
+
     GLint checkMaxTextureUnits()
     {
         GLint maxUnits = 0;
@@ -186,14 +290,15 @@ struct Shader::UniformBinder : private NonCopyable
     UniformBinder(Shader& shader, const std::string& name) :
     savedProgram(0),
     currentProgram(castToGlHandle(shader.m_shaderProgram)),
-    location(-1)
+    location(-1),
+    core(useCoreFunctions())
     {
         if (currentProgram)
         {
             // Enable program object
-            glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+            savedProgram = getCurrentProgram(core);
             if (currentProgram != savedProgram)
-                glCheck(GLEXT_glUseProgramObject(currentProgram));
+                useProgram(core, currentProgram);
 
             // Store uniform location for further use outside constructor
             location = shader.getUniformLocation(name);
@@ -208,13 +313,14 @@ struct Shader::UniformBinder : private NonCopyable
     {
         // Disable program object
         if (currentProgram && (currentProgram != savedProgram))
-            glCheck(GLEXT_glUseProgramObject(savedProgram));
+            useProgram(core, savedProgram);
     }
 
     TransientContextLock lock;           ///< Lock to keep context active while uniform is bound
     GLEXT_GLhandle       savedProgram;   ///< Handle to the previously active program object
     GLEXT_GLhandle       currentProgram; ///< Handle to the program object of the modified sf::Shader instance
     GLint                location;       ///< Uniform location, used by the surrounding sf::Shader code
+    bool                 core;           ///< Use the OpenGL 3.2 functions rather than the ARB ones?
 };
 
 
@@ -223,7 +329,8 @@ Shader::Shader() :
 m_shaderProgram (0),
 m_currentTexture(-1),
 m_textures      (),
-m_uniforms      ()
+m_uniforms      (),
+m_cacheId       (getUniqueId())
 {
 }
 
@@ -235,7 +342,7 @@ Shader::~Shader()
 
     // Destroy effect program
     if (m_shaderProgram)
-        glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        deleteObject(useCoreFunctions(), castToGlHandle(m_shaderProgram), true);
 }
 
 
@@ -427,7 +534,7 @@ void Shader::setUniform(const std::string& name, float x)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform1f(binder.location, x));
+        shaderCall(binder.core, glUniform1f, (binder.location, x));
 }
 
 
@@ -436,7 +543,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Vec2& v)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform2f(binder.location, v.x, v.y));
+        shaderCall(binder.core, glUniform2f, (binder.location, v.x, v.y));
 }
 
 
@@ -445,7 +552,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Vec3& v)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform3f(binder.location, v.x, v.y, v.z));
+        shaderCall(binder.core, glUniform3f, (binder.location, v.x, v.y, v.z));
 }
 
 
@@ -454,7 +561,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Vec4& v)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform4f(binder.location, v.x, v.y, v.z, v.w));
+        shaderCall(binder.core, glUniform4f, (binder.location, v.x, v.y, v.z, v.w));
 }
 
 
@@ -463,7 +570,7 @@ void Shader::setUniform(const std::string& name, int x)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform1i(binder.location, x));
+        shaderCall(binder.core, glUniform1i, (binder.location, x));
 }
 
 
@@ -472,7 +579,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Ivec2& v)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform2i(binder.location, v.x, v.y));
+        shaderCall(binder.core, glUniform2i, (binder.location, v.x, v.y));
 }
 
 
@@ -481,7 +588,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Ivec3& v)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform3i(binder.location, v.x, v.y, v.z));
+        shaderCall(binder.core, glUniform3i, (binder.location, v.x, v.y, v.z));
 }
 
 
@@ -490,7 +597,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Ivec4& v)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform4i(binder.location, v.x, v.y, v.z, v.w));
+        shaderCall(binder.core, glUniform4i, (binder.location, v.x, v.y, v.z, v.w));
 }
 
 
@@ -527,7 +634,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Mat3& matrix)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+        shaderCall(binder.core, glUniformMatrix3fv, (binder.location, 1, GL_FALSE, matrix.array));
 }
 
 
@@ -536,7 +643,7 @@ void Shader::setUniform(const std::string& name, const Glsl::Mat4& matrix)
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+        shaderCall(binder.core, glUniformMatrix4fv, (binder.location, 1, GL_FALSE, matrix.array));
 }
 
 
@@ -564,11 +671,13 @@ void Shader::setUniform(const std::string& name, const Texture& texture)
                 }
 
                 m_textures[location] = &texture;
+                m_cacheId = getUniqueId();
             }
-            else
+            else if (it->second != &texture)
             {
                 // Location already used, just replace the texture
                 it->second = &texture;
+                m_cacheId = getUniqueId();
             }
         }
     }
@@ -583,7 +692,12 @@ void Shader::setUniform(const std::string& name, CurrentTextureType)
         TransientContextLock lock;
 
         // Find the location of the variable in the shader
-        m_currentTexture = getUniformLocation(name);
+        int location = getUniformLocation(name);
+        if (location != m_currentTexture)
+        {
+            m_currentTexture = location;
+            m_cacheId = getUniqueId();
+        }
     }
 }
 
@@ -593,7 +707,7 @@ void Shader::setUniformArray(const std::string& name, const float* scalarArray,
 {
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform1fv(binder.location, static_cast<GLsizei>(length), scalarArray));
+        shaderCall(binder.core, glUniform1fv, (binder.location, static_cast<GLsizei>(length), scalarArray));
 }
 
 
@@ -604,7 +718,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorAr
 
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform2fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+        shaderCall(binder.core, glUniform2fv, (binder.location, static_cast<GLsizei>(length), &contiguous[0]));
 }
 
 
@@ -615,7 +729,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorAr
 
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform3fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+        shaderCall(binder.core, glUniform3fv, (binder.location, static_cast<GLsizei>(length), &contiguous[0]));
 }
 
 
@@ -626,7 +740,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Vec4* vectorAr
 
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniform4fv(binder.location, static_cast<GLsizei>(length), &contiguous[0]));
+        shaderCall(binder.core, glUniform4fv, (binder.location, static_cast<GLsizei>(length), &contiguous[0]));
 }
 
 
@@ -641,7 +755,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixAr
 
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+        shaderCall(binder.core, glUniformMatrix3fv, (binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
 }
 
 
@@ -656,7 +770,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 
     UniformBinder binder(*this, name);
     if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
+        shaderCall(binder.core, glUniformMatrix4fv, (binder.location, static_cast<GLsizei>(length), GL_FALSE, &contiguous[0]));
 }
 
 
@@ -750,22 +864,24 @@ void Shader::bind(const Shader* shader)
         return;
     }
 
+    bool core = useCoreFunctions();
+
     if (shader && shader->m_shaderProgram)
     {
         // Enable the program
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
+        useProgram(core, castToGlHandle(shader->m_shaderProgram));
 
         // Bind the textures
         shader->bindTextures();
 
         // Bind the current texture
         if (shader->m_currentTexture != -1)
-            glCheck(GLEXT_glUniform1i(shader->m_currentTexture, 0));
+            shaderCall(core, glUniform1i, (shader->m_currentTexture, 0));
     }
     else
     {
         // Bind no shader
-        glCheck(GLEXT_glUseProgramObject(0));
+        useProgram(core, 0);
     }
 }
 
@@ -787,11 +903,13 @@ bool Shader::isAvailable()
         // Make sure that extensions are initialized
         sf::priv::ensureExtensionsInit();
 
-        available = GLEXT_multitexture         &&
-                    GLEXT_shading_language_100 &&
-                    GLEXT_shader_objects       &&
-                    GLEXT_vertex_shader        &&
-                    GLEXT_fragment_shader;
+        // Core profile contexts provide shaders without advertising the ARB extensions
+        available = (GLEXT_multitexture         &&
+                     GLEXT_shading_language_100 &&
+                     GLEXT_shader_objects       &&
+                     GLEXT_vertex_shader        &&
+                     GLEXT_fragment_shader) ||
+                    priv::RenderTargetCore::isAvailable();
     }
 
     return available;
@@ -815,7 +933,8 @@ bool Shader::isGeometryAvailable()
         // Make sure that extensions are initialized
         sf::priv::ensureExtensionsInit();
 
-        available = isAvailable() && GLEXT_geometry_shader4;
+        // Geometry shaders are part of OpenGL 3.2
+        available = isAvailable() && (GLEXT_geometry_shader4 || priv::RenderTargetCore::isAvailable());
     }
 
     return available;
@@ -843,11 +962,14 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         return false;
     }
 
+    bool core = useCoreFunctions();
+
     // Destroy the shader if it was already created
     if (m_shaderProgram)
     {
-        glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        deleteObject(core, castToGlHandle(m_shaderProgram), true);
         m_shaderProgram = 0;
+        m_cacheId = getUniqueId();
     }
 
     // Reset the internal state
@@ -857,108 +979,75 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
-    glCheck(shaderProgram = GLEXT_glCreateProgramObject());
-
-    // Create the vertex shader if needed
-    if (vertexShaderCode)
+    if (core)
+        glCheck(shaderProgram = castToGlHandle(glCreateProgram()));
+    else
+        glCheck(shaderProgram = GLEXT_glCreateProgramObject());
+
+    // Create and compile the shaders, attach them to the program
+    // and delete them (not needed anymore)
+    const char* codes[] = {vertexShaderCode, geometryShaderCode, fragmentShaderCode};
+    const GLenum types[] = {GLEXT_GL_VERTEX_SHADER, GLEXT_GL_GEOMETRY_SHADER, GLEXT_GL_FRAGMENT_SHADER};
+    const char* typeNames[] = {"vertex", "geometry", "fragment"};
+    for (int i = 0; i < 3; ++i)
     {
-        // Create and compile the shader
-        GLEXT_GLhandle vertexShader;
-        glCheck(vertexShader = GLEXT_glCreateShaderObject(GLEXT_GL_VERTEX_SHADER));
-        glCheck(GLEXT_glShaderSource(vertexShader, 1, &vertexShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(vertexShader));
-
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(vertexShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
+        if (!codes[i])
+            continue;
+
+        GLEXT_GLhandle shader = compileShader(core, types[i], codes[i], typeNames[i]);
+        if (!shader)
         {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(vertexShader, sizeof(log), 0, log));
-            err() << "Failed to compile vertex shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(vertexShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
+            deleteObject(core, shaderProgram, true);
             return false;
         }
 
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, vertexShader));
-        glCheck(GLEXT_glDeleteObject(vertexShader));
+        if (core)
+            glCheck(glAttachShader(castFromGlHandle(shaderProgram), castFromGlHandle(shader)));
+        else
+            glCheck(GLEXT_glAttachObject(shaderProgram, shader));
+
+        deleteObject(core, shader, false);
     }
 
-    // Create the geometry shader if needed
-    if (geometryShaderCode)
+    // Bind the vertex components to the attribute locations
+    // that render targets use within core profile contexts, and link the program
+    if (core)
     {
-        // Create and compile the shader
-        GLEXT_GLhandle geometryShader = GLEXT_glCreateShaderObject(GLEXT_GL_GEOMETRY_SHADER);
-        glCheck(GLEXT_glShaderSource(geometryShader, 1, &geometryShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(geometryShader));
-
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(geometryShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
-        {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(geometryShader, sizeof(log), 0, log));
-            err() << "Failed to compile geometry shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(geometryShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
-        }
-
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, geometryShader));
-        glCheck(GLEXT_glDeleteObject(geometryShader));
+        GLuint program = castFromGlHandle(shaderProgram);
+        glCheck(glBindAttribLocation(program, priv::RenderTargetCore::PositionAttribute, "sf_position"));
+        glCheck(glBindAttribLocation(program, priv::RenderTargetCore::ColorAttribute, "sf_color"));
+        glCheck(glBindAttribLocation(program, priv::RenderTargetCore::TexCoordsAttribute, "sf_texCoords"));
+        glCheck(glLinkProgram(program));
     }
-
-    // Create the fragment shader if needed
-    if (fragmentShaderCode)
+    else
     {
-        // Create and compile the shader
-        GLEXT_GLhandle fragmentShader;
-        glCheck(fragmentShader = GLEXT_glCreateShaderObject(GLEXT_GL_FRAGMENT_SHADER));
-        glCheck(GLEXT_glShaderSource(fragmentShader, 1, &fragmentShaderCode, NULL));
-        glCheck(GLEXT_glCompileShader(fragmentShader));
-
-        // Check the compile log
-        GLint success;
-        glCheck(GLEXT_glGetObjectParameteriv(fragmentShader, GLEXT_GL_OBJECT_COMPILE_STATUS, &success));
-        if (success == GL_FALSE)
-        {
-            char log[1024];
-            glCheck(GLEXT_glGetInfoLog(fragmentShader, sizeof(log), 0, log));
-            err() << "Failed to compile fragment shader:" << std::endl
-                  << log << std::endl;
-            glCheck(GLEXT_glDeleteObject(fragmentShader));
-            glCheck(GLEXT_glDeleteObject(shaderProgram));
-            return false;
-        }
-
-        // Attach the shader to the program, and delete it (not needed anymore)
-        glCheck(GLEXT_glAttachObject(shaderProgram, fragmentShader));
-        glCheck(GLEXT_glDeleteObject(fragmentShader));
+        glCheck(GLEXT_glBindAttribLocation(shaderProgram, priv::RenderTargetCore::PositionAttribute, "sf_position"));
+        glCheck(GLEXT_glBindAttribLocation(shaderProgram, priv::RenderTargetCore::ColorAttribute, "sf_color"));
+        glCheck(GLEXT_glBindAttribLocation(shaderProgram, priv::RenderTargetCore::TexCoordsAttribute, "sf_texCoords"));
+        glCheck(GLEXT_glLinkProgram(shaderProgram));
     }
 
-    // Link the program
-    glCheck(GLEXT_glLinkProgram(shaderProgram));
-
     // Check the link log
     GLint success;
-    glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+    if (core)
+        glCheck(glGetProgramiv(castFromGlHandle(shaderProgram), GL_LINK_STATUS, &success));
+    else
+        glCheck(GLEXT_glGetObjectParameteriv(shaderProgram, GLEXT_GL_OBJECT_LINK_STATUS, &success));
     if (success == GL_FALSE)
     {
         char log[1024];
-        glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
+        if (core)
+            glCheck(glGetProgramInfoLog(castFromGlHandle(shaderProgram), sizeof(log), 0, log));
+        else
+            glCheck(GLEXT_glGetInfoLog(shaderProgram, sizeof(log), 0, log));
         err() << "Failed to link shader:" << std::endl
               << log << std::endl;
-        glCheck(GLEXT_glDeleteObject(shaderProgram));
+        deleteObject(core, shaderProgram, true);
         return false;
     }
 
     m_shaderProgram = castFromGlHandle(shaderProgram);
+    m_cacheId = getUniqueId();
 
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
@@ -971,18 +1060,20 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 ////////////////////////////////////////////////////////////
 void Shader::bindTextures() const
 {
+    bool core = useCoreFunctions();
+
     TextureTable::const_iterator it = m_textures.begin();
     for (std::size_t i = 0; i < m_textures.size(); ++i)
     {
         GLint index = static_cast<GLsizei>(i + 1);
-        glCheck(GLEXT_glUniform1i(it->first, index));
-        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
+        shaderCall(core, glUniform1i, (it->first, index));
+        shaderCall(core, glActiveTexture, (GLEXT_GL_TEXTURE0 + index));
         Texture::bind(it->second);
         ++it;
     }
 
     // Make sure that the texture unit which is left active is the number 0
-    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    shaderCall(core, glActiveTexture, (GLEXT_GL_TEXTURE0));
 }
 
 
@@ -999,7 +1090,11 @@ int Shader::getUniformLocation(const std::string& name)
     else
     {
         // Not in cache, request the location from OpenGL
-        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
+        int location = -1;
+        if (useCoreFunctions())
+            glCheck(location = glGetUniformLocation(m_shaderProgram, name.c_str()));
+        else
+            location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
         m_uniforms.insert(std::make_pair(name, location));
 
         if (location == -1)
@@ -1024,7 +1119,8 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
 m_shaderProgram (0),
-m_currentTexture(-1)
+m_currentTexture(-1),
+m_cacheId       (getUniqueId())
 {
 }
 
@@ -86,7 +86,7 @@ const Texture* Shape::getTexture() const
 void Shape::setTextureRect(const IntRect& rect)
 {
     m_textureRect = rect;
-    updateTexCoords();
+    m_texCoordsNeedUpdate = true;
 }
 
 
@@ -101,7 +101,7 @@ const IntRect& Shape::getTextureRect() const
 void Shape::setFillColor(const Color& color)
 {
     m_fillColor = color;
-    updateFillColors();
+    m_fillColorsNeedUpdate = true;
 }
 
 
@@ -116,7 +116,7 @@ const Color& Shape::getFillColor() const
 void Shape::setOutlineColor(const Color& color)
 {
     m_outlineColor = color;
-    updateOutlineColors();
+    m_outlineColorsNeedUpdate = true;
 }
 
 
@@ -130,8 +130,11 @@ const Color& Shape::getOutlineColor() const
 ////////////////////////////////////////////////////////////
 void Shape::setOutlineThickness(float thickness)
 {
-    m_outlineThickness = thickness;
-    update(); // recompute everything because the whole shape must be offset
+    if (thickness != m_outlineThickness)
+    {
+        m_outlineThickness = thickness;
+        m_outlineNeedUpdate = true; // the fill geometry doesn't depend on the outline
+    }
 }
 
 
@@ -145,6 +148,8 @@ float Shape::getOutlineThickness() const
 ////////////////////////////////////////////////////////////
 FloatRect Shape::getLocalBounds() const
 {
+    ensureGeometryUpdate();
+
     return m_bounds;
 }
 
@@ -158,21 +163,98 @@ FloatRect Shape::getGlobalBounds() const
 
 ////////////////////////////////////////////////////////////
 Shape::Shape() :
-m_texture         (NULL),
-m_textureRect     (),
-m_fillColor       (255, 255, 255),
-m_outlineColor    (255, 255, 255),
-m_outlineThickness(0),
-m_vertices        (TriangleFan),
-m_outlineVertices (TriangleStrip),
-m_insideBounds    (),
-m_bounds          ()
+m_texture                (NULL),
+m_textureRect            (),
+m_fillColor              (255, 255, 255),
+m_outlineColor           (255, 255, 255),
+m_outlineThickness       (0),
+m_vertices               (TriangleFan),
+m_outlineVertices        (TriangleStrip),
+m_insideBounds           (),
+m_bounds                 (),
+m_geometryNeedUpdate     (false),
+m_outlineNeedUpdate      (false),
+m_fillColorsNeedUpdate   (false),
+m_texCoordsNeedUpdate    (false),
+m_outlineColorsNeedUpdate(false)
 {
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shape::update()
+{
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::draw(RenderTarget& target, RenderStates states) const
+{
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+
+    // Render the inside
+    states.texture = m_texture;
+    target.draw(m_vertices, states);
+
+    // Render the outline
+    if (m_outlineThickness != 0)
+    {
+        states.texture = NULL;
+        target.draw(m_outlineVertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::ensureGeometryUpdate() const
+{
+    // The points changed: everything depends on them
+    if (m_geometryNeedUpdate)
+    {
+        updateGeometry();
+
+        m_geometryNeedUpdate = false;
+        m_outlineNeedUpdate = false;
+        m_fillColorsNeedUpdate = false;
+        m_texCoordsNeedUpdate = false;
+        m_outlineColorsNeedUpdate = false;
+        return;
+    }
+
+    // Otherwise only refresh what changed; rebuilding the outline sets its colors too
+    if (m_outlineNeedUpdate)
+    {
+        updateOutline();
+
+        m_outlineNeedUpdate = false;
+        m_outlineColorsNeedUpdate = false;
+    }
+
+    if (m_outlineColorsNeedUpdate)
+    {
+        updateOutlineColors();
+        m_outlineColorsNeedUpdate = false;
+    }
+
+    if (m_fillColorsNeedUpdate)
+    {
+        updateFillColors();
+        m_fillColorsNeedUpdate = false;
+    }
+
+    if (m_texCoordsNeedUpdate)
+    {
+        updateTexCoords();
+        m_texCoordsNeedUpdate = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shape::updateGeometry() const
 {
     // Get the total number of points of the shape
     std::size_t count = getPointCount();
@@ -210,25 +292,7 @@ void Shape::update()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::draw(RenderTarget& target, RenderStates states) const
-{
-    states.transform *= getTransform();
-
-    // Render the inside
-    states.texture = m_texture;
-    target.draw(m_vertices, states);
-
-    // Render the outline
-    if (m_outlineThickness != 0)
-    {
-        states.texture = NULL;
-        target.draw(m_outlineVertices, states);
-    }
-}
-
-
-////////////////////////////////////////////////////////////
-void Shape::updateFillColors()
+void Shape::updateFillColors() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
         m_vertices[i].color = m_fillColor;
@@ -236,7 +300,7 @@ void Shape::updateFillColors()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateTexCoords()
+void Shape::updateTexCoords() const
 {
     for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
     {
@@ -249,10 +313,10 @@ void Shape::updateTexCoords()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutline()
+void Shape::updateOutline() const
 {
-    // Return if there is no outline
-    if (m_outlineThickness == 0.f)
+    // Return if there is no outline, or no shape to outline
+    if ((m_outlineThickness == 0.f) || (m_vertices.getVertexCount() == 0))
     {
         m_outlineVertices.clear();
         m_bounds = m_insideBounds;
@@ -304,7 +368,7 @@ void Shape::updateOutline()
 
 
 ////////////////////////////////////////////////////////////
-void Shape::updateOutlineColors()
+void Shape::updateOutlineColors() const
 {
     for (std::size_t i = 0; i < m_outlineVertices.getVertexCount(); ++i)
         m_outlineVertices[i].color = m_outlineColor;
@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SpatialIndex.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct SpatialIndex::AdditionOrder
+{
+    AdditionOrder(const std::vector<Object>& objects) :
+    m_objects(objects)
+    {
+    }
+
+    bool operator ()(unsigned int left, unsigned int right) const
+    {
+        return m_objects[left].order < m_objects[right].order;
+    }
+
+    const std::vector<Object>& m_objects;
+};
+
+
+////////////////////////////////////////////////////////////
+SpatialIndex::SpatialIndex(const FloatRect& area, const Vector2f& cellSize) :
+m_area     (area),
+m_cellSize (std::max(cellSize.x, 1.f), std::max(cellSize.y, 1.f)),
+m_gridSize (),
+m_cells    (),
+m_objects  (),
+m_freeIds  (),
+m_count    (0),
+m_nextOrder(0),
+m_stamp    (0),
+m_found    ()
+{
+    m_gridSize.x = std::max(static_cast<int>(std::ceil(area.width / m_cellSize.x)), 1);
+    m_gridSize.y = std::max(static_cast<int>(std::ceil(area.height / m_cellSize.y)), 1);
+    m_cells.resize(static_cast<std::size_t>(m_gridSize.x) * m_gridSize.y);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SpatialIndex::add(const Drawable& drawable, const FloatRect& bounds)
+{
+    return insert(drawable, NULL, NULL, bounds);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::update(unsigned int id)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable || !m_objects[id].getter)
+        return;
+
+    const Object& object = m_objects[id];
+    update(id, object.getter(object.source));
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::update(unsigned int id, const FloatRect& bounds)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable)
+        return;
+
+    Object& object = m_objects[id];
+    object.bounds = bounds;
+
+    // Only relink the object if it moved to other cells
+    IntRect cells = getCells(bounds);
+    if (cells != object.cells)
+    {
+        link(id, object.cells, false);
+        link(id, cells, true);
+        object.cells = cells;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::remove(unsigned int id)
+{
+    if ((id >= m_objects.size()) || !m_objects[id].drawable)
+        return;
+
+    Object& object = m_objects[id];
+    link(id, object.cells, false);
+    object.drawable = NULL;
+
+    m_freeIds.push_back(id);
+    --m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::clear()
+{
+    for (std::vector<std::vector<unsigned int> >::iterator cell = m_cells.begin(); cell != m_cells.end(); ++cell)
+        cell->clear();
+
+    m_objects.clear();
+    m_freeIds.clear();
+    m_count = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::query(const FloatRect& area, std::vector<const Drawable*>& result) const
+{
+    find(area);
+
+    for (std::vector<unsigned int>::const_iterator id = m_found.begin(); id != m_found.end(); ++id)
+        result.push_back(m_objects[*id].drawable);
+
+    return m_found.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SpatialIndex::getObjectCount() const
+{
+    return m_count;
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::draw(RenderTarget& target, RenderStates states) const
+{
+    // Bring the corners of the view into the coordinates of the index
+    Transform toIndex = states.transform.getInverse() * target.getView().getInverseTransform();
+
+    FloatRect visible = toIndex.transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+
+    find(visible);
+
+    for (std::vector<unsigned int>::const_iterator id = m_found.begin(); id != m_found.end(); ++id)
+        target.draw(*m_objects[*id].drawable, states);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SpatialIndex::insert(const Drawable& drawable, const void* source, BoundsGetter getter, const FloatRect& bounds)
+{
+    unsigned int id;
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        id = static_cast<unsigned int>(m_objects.size());
+        m_objects.push_back(Object());
+    }
+
+    Object& object = m_objects[id];
+    object.drawable = &drawable;
+    object.source   = source;
+    object.getter   = getter;
+    object.bounds   = bounds;
+    object.cells    = getCells(bounds);
+    object.order    = m_nextOrder++;
+    object.stamp    = 0;
+
+    link(id, object.cells, true);
+    ++m_count;
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect SpatialIndex::getCells(const FloatRect& area) const
+{
+    // Areas outside of the grid are clamped to its border cells
+    float maxX = static_cast<float>(m_gridSize.x - 1);
+    float maxY = static_cast<float>(m_gridSize.y - 1);
+
+    float left   = std::max(0.f, std::min(maxX, std::floor((area.left - m_area.left) / m_cellSize.x)));
+    float top    = std::max(0.f, std::min(maxY, std::floor((area.top - m_area.top) / m_cellSize.y)));
+    float right  = std::max(0.f, std::min(maxX, std::floor((area.left + area.width - m_area.left) / m_cellSize.x)));
+    float bottom = std::max(0.f, std::min(maxY, std::floor((area.top + area.height - m_area.top) / m_cellSize.y)));
+
+    return IntRect(static_cast<int>(left), static_cast<int>(top),
+                   static_cast<int>(right - left) + 1, static_cast<int>(bottom - top) + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::link(unsigned int id, const IntRect& cells, bool insert)
+{
+    for (int y = cells.top; y < cells.top + cells.height; ++y)
+    {
+        for (int x = cells.left; x < cells.left + cells.width; ++x)
+        {
+            std::vector<unsigned int>& cell = m_cells[y * m_gridSize.x + x];
+
+            if (insert)
+            {
+                cell.push_back(id);
+            }
+            else
+            {
+                std::vector<unsigned int>::iterator it = std::find(cell.begin(), cell.end(), id);
+                if (it != cell.end())
+                {
+                    *it = cell.back();
+                    cell.pop_back();
+                }
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SpatialIndex::find(const FloatRect& area) const
+{
+    m_found.clear();
+
+    // Objects overlapping several cells must only be found once
+    ++m_stamp;
+
+    IntRect cells = getCells(area);
+    for (int y = cells.top; y < cells.top + cells.height; ++y)
+    {
+        for (int x = cells.left; x < cells.left + cells.width; ++x)
+        {
+            const std::vector<unsigned int>& cell = m_cells[y * m_gridSize.x + x];
+
+            for (std::vector<unsigned int>::const_iterator id = cell.begin(); id != cell.end(); ++id)
+            {
+                const Object& object = m_objects[*id];
+                if (object.stamp == m_stamp)
+                    continue;
+
+                object.stamp = m_stamp;
+
+                // Touching edges count as intersecting, for zero-sized bounds
+                const FloatRect& bounds = object.bounds;
+                if ((bounds.left <= area.left + area.width) && (area.left <= bounds.left + bounds.width) &&
+                    (bounds.top <= area.top + area.height) && (area.top <= bounds.top + bounds.height))
+                    m_found.push_back(*id);
+            }
+        }
+    }
+
+    // Keep the order in which the objects were added
+    std::sort(m_found.begin(), m_found.end(), AdditionOrder(m_objects));
+}
+
+} // namespace sf
@@ -26,7 +26,9 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/GpuFence.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTargetCore.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
@@ -43,6 +45,10 @@ namespace
     sf::Mutex idMutex;
     sf::Mutex maximumSizeMutex;
 
+    // The fence of a texture is inserted by the updating thread and
+    // waited for (then released) by the drawing threads
+    sf::Mutex fenceMutex;
+
     // Thread-safe unique identifier generator,
     // is used for states cache (see RenderTarget)
     sf::Uint64 getUniqueId()
@@ -53,6 +59,9 @@ namespace
 
         return id++;
     }
+
+    // Value of Texture::m_contextId when the texture is drawn in several contexts
+    const sf::Uint64 severalContexts = static_cast<sf::Uint64>(-1);
 }
 
 
@@ -69,7 +78,9 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_fence        (NULL),
+m_contextId    (0)
 {
 }
 
@@ -85,17 +96,15 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_fence        (NULL),
+m_contextId    (0)
 {
     if (copy.m_texture)
     {
         if (create(copy.getSize().x, copy.getSize().y))
         {
             update(copy);
-
-            // Force an OpenGL flush, so that the texture will appear updated
-            // in all contexts immediately (solves problems in multi-threaded apps)
-            glCheck(glFlush());
         }
         else
         {
@@ -116,6 +125,8 @@ Texture::~Texture()
         GLuint texture = static_cast<GLuint>(m_texture);
         glCheck(glDeleteTextures(1, &texture));
     }
+
+    delete m_fence;
 }
 
 
@@ -166,7 +177,10 @@ bool Texture::create(unsigned int width, unsigned int height)
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
-    static bool textureEdgeClamp = GLEXT_texture_edge_clamp || GLEXT_EXT_texture_edge_clamp;
+    static bool textureEdgeClampExtension = GLEXT_texture_edge_clamp || GLEXT_EXT_texture_edge_clamp;
+
+    // GL_CLAMP_TO_EDGE is core since OpenGL 1.2, and GL_CLAMP is invalid in core profile contexts
+    bool textureEdgeClamp = textureEdgeClampExtension || priv::RenderTargetCore::isCoreProfile();
 
     if (!m_isRepeated && !textureEdgeClamp)
     {
@@ -296,9 +310,8 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
             m_hasMipmap = false;
 
-            // Force an OpenGL flush, so that the texture will appear updated
-            // in all contexts immediately (solves problems in multi-threaded apps)
-            glCheck(glFlush());
+            // Make sure that the other contexts using the texture will see it updated
+            signalUpdate();
 
             return true;
         }
@@ -326,6 +339,14 @@ Image Texture::copyToImage() const
 
     TransientContextLock lock;
 
+    // Wait for the last update if it was made in another context
+    {
+        Lock fenceLock(fenceMutex);
+
+        if (m_fence)
+            m_fence->synchronize();
+    }
+
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
@@ -428,9 +449,8 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
         m_pixelsFlipped = false;
         m_cacheId = getUniqueId();
 
-        // Force an OpenGL flush, so that the texture data will appear updated
-        // in all contexts immediately (solves problems in multi-threaded apps)
-        glCheck(glFlush());
+        // Make sure that the other contexts using the texture will see it updated
+        signalUpdate();
     }
 }
 
@@ -501,6 +521,14 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 
         if ((sourceStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE) && (destStatus == GLEXT_GL_FRAMEBUFFER_COMPLETE))
         {
+            // Wait for the last update of the source if it was made in another context
+            {
+                Lock fenceLock(fenceMutex);
+
+                if (texture.m_fence)
+                    texture.m_fence->synchronize();
+            }
+
             // Blit the texture contents from the source to the destination texture
             glCheck(GLEXT_glBlitFramebuffer(
                 0, texture.m_pixelsFlipped ? texture.m_size.y : 0, texture.m_size.x, texture.m_pixelsFlipped ? 0 : texture.m_size.y, // Source rectangle, flip y if source is flipped
@@ -531,9 +559,8 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         m_pixelsFlipped = false;
         m_cacheId = getUniqueId();
 
-        // Force an OpenGL flush, so that the texture data will appear updated
-        // in all contexts immediately (solves problems in multi-threaded apps)
-        glCheck(glFlush());
+        // Make sure that the other contexts using the texture will see it updated
+        signalUpdate();
 
         return;
     }
@@ -587,9 +614,8 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
         m_pixelsFlipped = true;
         m_cacheId = getUniqueId();
 
-        // Force an OpenGL flush, so that the texture will appear updated
-        // in all contexts immediately (solves problems in multi-threaded apps)
-        glCheck(glFlush());
+        // Make sure that the other contexts using the texture will see it updated
+        signalUpdate();
     }
 }
 
@@ -659,7 +685,10 @@ void Texture::setRepeated(bool repeated)
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
-            static bool textureEdgeClamp = GLEXT_texture_edge_clamp || GLEXT_EXT_texture_edge_clamp;
+            static bool textureEdgeClampExtension = GLEXT_texture_edge_clamp || GLEXT_EXT_texture_edge_clamp;
+
+            // GL_CLAMP_TO_EDGE is core since OpenGL 1.2, and GL_CLAMP is invalid in core profile contexts
+            bool textureEdgeClamp = textureEdgeClampExtension || priv::RenderTargetCore::isCoreProfile();
 
             if (!m_isRepeated && !textureEdgeClamp)
             {
@@ -707,12 +736,23 @@ bool Texture::generateMipmap()
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
+    // Wait for the last update if it was made in another context
+    {
+        Lock fenceLock(fenceMutex);
+
+        if (m_fence)
+            m_fence->synchronize();
+    }
+
     glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
     glCheck(GLEXT_glGenerateMipmap(GL_TEXTURE_2D));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
 
     m_hasMipmap = true;
 
+    // Make sure that the other contexts using the texture will see the mipmap
+    signalUpdate();
+
     return true;
 }
 
@@ -742,31 +782,18 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 
     if (texture && texture->m_texture)
     {
+        // Wait for the last update if it was made in another context
+        texture->waitForUpdate();
+
         // Bind the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
 
         // Check if we need to define a special texture matrix
-        if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
+        // (core profile contexts have no texture matrix, their shaders get it as a uniform)
+        if (((coordinateType == Pixels) || texture->m_pixelsFlipped) && !priv::RenderTargetCore::isCoreProfile())
         {
-            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
-                                  0.f, 1.f, 0.f, 0.f,
-                                  0.f, 0.f, 1.f, 0.f,
-                                  0.f, 0.f, 0.f, 1.f};
-
-            // If non-normalized coordinates (= pixels) are requested, we need to
-            // setup scale factors that convert the range [0 .. size] to [0 .. 1]
-            if (coordinateType == Pixels)
-            {
-                matrix[0] = 1.f / texture->m_actualSize.x;
-                matrix[5] = 1.f / texture->m_actualSize.y;
-            }
-
-            // If pixels are flipped we must invert the Y axis
-            if (texture->m_pixelsFlipped)
-            {
-                matrix[5] = -matrix[5];
-                matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
-            }
+            GLfloat matrix[16];
+            texture->computeMatrix(coordinateType, matrix);
 
             // Load the matrix
             glCheck(glMatrixMode(GL_TEXTURE));
@@ -782,15 +809,84 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
         glCheck(glBindTexture(GL_TEXTURE_2D, 0));
 
         // Reset the texture matrix
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glLoadIdentity());
+        if (!priv::RenderTargetCore::isCoreProfile())
+        {
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glLoadIdentity());
 
-        // Go back to model-view mode (sf::RenderTarget relies on it)
-        glCheck(glMatrixMode(GL_MODELVIEW));
+            // Go back to model-view mode (sf::RenderTarget relies on it)
+            glCheck(glMatrixMode(GL_MODELVIEW));
+        }
     }
 }
 
 
+////////////////////////////////////////////////////////////
+void Texture::computeMatrix(CoordinateType coordinateType, float* matrix) const
+{
+    static const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                       0.f, 1.f, 0.f, 0.f,
+                                       0.f, 0.f, 1.f, 0.f,
+                                       0.f, 0.f, 0.f, 1.f};
+
+    std::memcpy(matrix, identity, sizeof(identity));
+
+    // If non-normalized coordinates (= pixels) are requested, we need to
+    // setup scale factors that convert the range [0 .. size] to [0 .. 1]
+    if (coordinateType == Pixels)
+    {
+        matrix[0] = 1.f / m_actualSize.x;
+        matrix[5] = 1.f / m_actualSize.y;
+    }
+
+    // If pixels are flipped we must invert the Y axis
+    if (m_pixelsFlipped)
+    {
+        matrix[5] = -matrix[5];
+        matrix[13] = static_cast<float>(m_size.y) / m_actualSize.y;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::signalUpdate()
+{
+    Lock lock(fenceMutex);
+
+    // Commands of a same context are executed in order, there is no need for
+    // a fence while the texture is only drawn in the updating context; the
+    // commands are still flushed, so that another context that draws it
+    // later doesn't read it before they are submitted
+    if (!m_fence && (m_contextId == Context::getActiveContextId()))
+    {
+        glCheck(glFlush());
+        return;
+    }
+
+    if (!m_fence)
+        m_fence = new GpuFence;
+
+    m_fence->insert();
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::waitForUpdate() const
+{
+    Lock lock(fenceMutex);
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    if (!m_contextId)
+        m_contextId = contextId;
+    else if (m_contextId != contextId)
+        m_contextId = severalContexts;
+
+    if (m_fence)
+        m_fence->synchronize();
+}
+
+
 ////////////////////////////////////////////////////////////
 unsigned int Texture::getMaximumSize()
 {
@@ -835,6 +931,8 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_fence,         right.m_fence);
+    std::swap(m_contextId,     right.m_contextId);
 
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
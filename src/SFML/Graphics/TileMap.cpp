@@ -0,0 +1,365 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Largest chunk side whose vertices 16-bit indices can address
+    // (128 x 128 tiles of 4 vertices)
+    const unsigned int maxIndex16ChunkSize = 128;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const Uint32 TileMap::EmptyTile = 0xFFFFFFFF;
+
+
+////////////////////////////////////////////////////////////
+TileMap::Chunk::Chunk() :
+vertexBuffer(Triangles, VertexBuffer::Static),
+vertices    (),
+tileCount   (0),
+needUpdate  (true)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_size            (0, 0),
+m_tileSize        (0, 0),
+m_chunkSize       (0),
+m_chunkCount      (0, 0),
+m_texture         (NULL),
+m_tilesPerRow     (1),
+m_tiles           (),
+m_chunks          (),
+m_indexBuffer     (),
+m_indices         (),
+m_useVertexBuffers(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileMap::create(const Vector2u& size, const Vector2u& tileSize, unsigned int chunkSize)
+{
+    if (!size.x || !size.y || !tileSize.x || !tileSize.y || !chunkSize)
+    {
+        err() << "Failed to create tile map, invalid size (" << size.x << "x" << size.y << " tiles of "
+              << tileSize.x << "x" << tileSize.y << " pixels, chunks of " << chunkSize << " tiles)" << std::endl;
+        return false;
+    }
+
+    m_useVertexBuffers = VertexBuffer::isAvailable();
+
+    // Keep the chunks addressable by 16-bit indices, which all the
+    // systems support (32-bit indices are optional on OpenGL ES)
+    chunkSize = std::min(chunkSize, maxIndex16ChunkSize);
+
+    m_size       = size;
+    m_tileSize   = tileSize;
+    m_chunkSize  = chunkSize;
+    m_chunkCount = Vector2u((size.x + chunkSize - 1) / chunkSize, (size.y + chunkSize - 1) / chunkSize);
+
+    m_tiles.assign(static_cast<std::size_t>(size.x) * size.y, EmptyTile);
+
+    m_chunks.clear();
+    m_chunks.resize(static_cast<std::size_t>(m_chunkCount.x) * m_chunkCount.y);
+
+    // All the chunks share the same indices: two triangles per tile,
+    // the vertices of the non-empty tiles being packed at the beginning
+    std::size_t maxTiles = static_cast<std::size_t>(chunkSize) * chunkSize;
+    m_indices.resize(maxTiles * 6);
+    for (std::size_t i = 0; i < maxTiles; ++i)
+    {
+        Uint16 first = static_cast<Uint16>(i * 4);
+        m_indices[i * 6 + 0] = first + 0;
+        m_indices[i * 6 + 1] = first + 1;
+        m_indices[i * 6 + 2] = first + 2;
+        m_indices[i * 6 + 3] = first + 0;
+        m_indices[i * 6 + 4] = first + 2;
+        m_indices[i * 6 + 5] = first + 3;
+    }
+
+    if (m_useVertexBuffers)
+    {
+        m_indexBuffer = IndexBuffer(IndexBuffer::Index16, VertexBuffer::Static);
+
+        bool uploaded = m_indexBuffer.create(m_indices.size()) && m_indexBuffer.update(&m_indices[0], m_indices.size());
+
+        // The indices are in graphics memory, we don't need our copy anymore
+        if (uploaded)
+            std::vector<Uint16>().swap(m_indices);
+        else
+            m_useVertexBuffers = false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTexture(const Texture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int x, unsigned int y, Uint32 tile)
+{
+    if ((x >= m_size.x) || (y >= m_size.y))
+        return;
+
+    Uint32& current = m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+    if (current != tile)
+    {
+        current = tile;
+        m_chunks[(y / m_chunkSize) * m_chunkCount.x + x / m_chunkSize].needUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(const Uint32* tiles)
+{
+    if (!tiles || m_tiles.empty())
+        return;
+
+    std::copy(tiles, tiles + m_tiles.size(), m_tiles.begin());
+    invalidateChunks();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TileMap::getTile(unsigned int x, unsigned int y) const
+{
+    if ((x >= m_size.x) || (y >= m_size.y))
+        return EmptyTile;
+
+    return m_tiles[static_cast<std::size_t>(y) * m_size.x + x];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect(0.f, 0.f, static_cast<float>(m_size.x * m_tileSize.x), static_cast<float>(m_size.y * m_tileSize.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_chunks.empty())
+        return;
+
+    // The texture coordinates depend on the layout of the tileset
+    unsigned int tilesPerRow = m_texture ? std::max(m_texture->getSize().x / m_tileSize.x, 1u) : 1u;
+    if (tilesPerRow != m_tilesPerRow)
+    {
+        m_tilesPerRow = tilesPerRow;
+        invalidateChunks();
+    }
+
+    states.transform *= getTransform();
+    states.texture = m_texture;
+
+    IntRect visible = getVisibleChunks(target.getView(), states.transform);
+
+    for (int y = visible.top; y < visible.top + visible.height; ++y)
+    {
+        for (int x = visible.left; x < visible.left + visible.width; ++x)
+        {
+            const Chunk& chunk = m_chunks[y * m_chunkCount.x + x];
+
+            if (chunk.needUpdate)
+                updateChunk(x, y);
+
+            if (!chunk.tileCount)
+                continue;
+
+            if (m_useVertexBuffers)
+                target.draw(chunk.vertexBuffer, m_indexBuffer, 0, chunk.tileCount * 6, states);
+            else
+                target.draw(&chunk.vertices[0], chunk.vertices.size(), &m_indices[0], chunk.tileCount * 6, Triangles, states);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+IntRect TileMap::getVisibleChunks(const View& view, const Transform& transform) const
+{
+    // Bring the corners of the view into the local coordinates of the map
+    Transform toLocal = transform.getInverse() * view.getInverseTransform();
+
+    Vector2f corners[4] =
+    {
+        toLocal.transformPoint(-1.f, -1.f),
+        toLocal.transformPoint( 1.f, -1.f),
+        toLocal.transformPoint( 1.f,  1.f),
+        toLocal.transformPoint(-1.f,  1.f)
+    };
+
+    float left   = corners[0].x;
+    float top    = corners[0].y;
+    float right  = corners[0].x;
+    float bottom = corners[0].y;
+    for (int i = 1; i < 4; ++i)
+    {
+        left   = std::min(left,   corners[i].x);
+        top    = std::min(top,    corners[i].y);
+        right  = std::max(right,  corners[i].x);
+        bottom = std::max(bottom, corners[i].y);
+    }
+
+    // Convert to chunk coordinates, clamped to the map
+    float chunkWidth  = static_cast<float>(m_chunkSize * m_tileSize.x);
+    float chunkHeight = static_cast<float>(m_chunkSize * m_tileSize.y);
+    float countX      = static_cast<float>(m_chunkCount.x);
+    float countY      = static_cast<float>(m_chunkCount.y);
+
+    int firstX = static_cast<int>(std::max(0.f, std::min(countX, std::floor(left / chunkWidth))));
+    int firstY = static_cast<int>(std::max(0.f, std::min(countY, std::floor(top / chunkHeight))));
+    int lastX  = static_cast<int>(std::max(0.f, std::min(countX, std::floor(right / chunkWidth) + 1.f)));
+    int lastY  = static_cast<int>(std::max(0.f, std::min(countY, std::floor(bottom / chunkHeight) + 1.f)));
+
+    return IntRect(firstX, firstY, lastX - firstX, lastY - firstY);
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::updateChunk(unsigned int x, unsigned int y) const
+{
+    Chunk& chunk = m_chunks[y * m_chunkCount.x + x];
+
+    unsigned int firstX = x * m_chunkSize;
+    unsigned int firstY = y * m_chunkSize;
+    unsigned int lastX  = std::min(firstX + m_chunkSize, m_size.x);
+    unsigned int lastY  = std::min(firstY + m_chunkSize, m_size.y);
+
+    float tileWidth  = static_cast<float>(m_tileSize.x);
+    float tileHeight = static_cast<float>(m_tileSize.y);
+
+    // Build the vertices of the non-empty tiles
+    std::vector<Vertex> vertices;
+    vertices.reserve(static_cast<std::size_t>(lastX - firstX) * (lastY - firstY) * 4);
+
+    for (unsigned int j = firstY; j < lastY; ++j)
+    {
+        for (unsigned int i = firstX; i < lastX; ++i)
+        {
+            Uint32 tile = m_tiles[static_cast<std::size_t>(j) * m_size.x + i];
+            if (tile == EmptyTile)
+                continue;
+
+            float left   = i * tileWidth;
+            float top    = j * tileHeight;
+            float right  = left + tileWidth;
+            float bottom = top + tileHeight;
+
+            float u = (tile % m_tilesPerRow) * tileWidth;
+            float v = (tile / m_tilesPerRow) * tileHeight;
+
+            vertices.push_back(Vertex(Vector2f(left,  top),    Vector2f(u,             v)));
+            vertices.push_back(Vertex(Vector2f(right, top),    Vector2f(u + tileWidth, v)));
+            vertices.push_back(Vertex(Vector2f(right, bottom), Vector2f(u + tileWidth, v + tileHeight)));
+            vertices.push_back(Vertex(Vector2f(left,  bottom), Vector2f(u,             v + tileHeight)));
+        }
+    }
+
+    chunk.tileCount = vertices.size() / 4;
+    chunk.needUpdate = false;
+
+    if (!m_useVertexBuffers)
+    {
+        chunk.vertices.swap(vertices);
+        return;
+    }
+
+    if (vertices.empty())
+        return;
+
+    // Only the used part of the buffer is drawn, so it never needs to shrink
+    if ((!chunk.vertexBuffer.getNativeHandle() && !chunk.vertexBuffer.create(vertices.size())) ||
+        !chunk.vertexBuffer.update(&vertices[0], vertices.size(), 0))
+    {
+        err() << "Failed to update tile map chunk (" << x << ", " << y << ")" << std::endl;
+        chunk.tileCount = 0;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::invalidateChunks() const
+{
+    for (std::vector<Chunk>::iterator chunk = m_chunks.begin(); chunk != m_chunks.end(); ++chunk)
+        chunk->needUpdate = true;
+}
+
+} // namespace sf
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/UnitCircle.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <cmath>
+#include <map>
+
+
+namespace
+{
+    // Tables already computed, by point count; map nodes never
+    // move, so references to the tables stay valid
+    typedef std::map<std::size_t, std::vector<sf::Vector2f> > UnitCircleMap;
+    UnitCircleMap unitCircles;
+
+    sf::Mutex unitCirclesMutex;
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+const std::vector<Vector2f>& getUnitCircle(std::size_t pointCount)
+{
+    Lock lock(unitCirclesMutex);
+
+    UnitCircleMap::iterator it = unitCircles.find(pointCount);
+    if (it != unitCircles.end())
+        return it->second;
+
+    std::vector<Vector2f>& points = unitCircles[pointCount];
+    points.resize(pointCount);
+
+    static const double pi = 3.141592653589793;
+
+    for (std::size_t i = 0; i < pointCount; ++i)
+    {
+        double angle = i * 2 * pi / pointCount - pi / 2;
+        points[i].x = static_cast<float>(std::cos(angle));
+        points[i].y = static_cast<float>(std::sin(angle));
+    }
+
+    return points;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_UNITCIRCLE_HPP
+#define SFML_UNITCIRCLE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the points of a unit circle
+///
+/// The points are evenly spaced, starting at the top of the
+/// circle, (0, -1), and going clockwise in SFML's Y-down
+/// coordinate system. Point i is (cos(a), sin(a)) with
+/// a = 2 * pi * i / pointCount - pi / 2.
+///
+/// The table is computed the first time a given point count
+/// is requested, then shared by all the callers. This function
+/// is thread-safe, and the returned reference stays valid
+/// until the program ends.
+///
+/// \param pointCount Number of points of the circle
+///
+/// \return Points of the unit circle
+///
+////////////////////////////////////////////////////////////
+const std::vector<Vector2f>& getUnitCircle(std::size_t pointCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_UNITCIRCLE_HPP
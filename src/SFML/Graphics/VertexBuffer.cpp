@@ -26,9 +26,11 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/GpuFence.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
@@ -37,6 +39,25 @@
 namespace
 {
     sf::Mutex isAvailableMutex;
+    sf::Mutex idMutex;
+
+    // The fence of a buffer is inserted by the updating thread and
+    // waited for (then released) by the drawing threads
+    sf::Mutex fenceMutex;
+
+    // Thread-safe unique identifier generator,
+    // is used for states cache (see RenderTarget)
+    sf::Uint64 getUniqueId()
+    {
+        sf::Lock lock(idMutex);
+
+        static sf::Uint64 id = 1; // start at 1, zero is "no vertex buffer"
+
+        return id++;
+    }
+
+    // Value of VertexBuffer::m_contextId when the buffer is drawn in several contexts
+    const sf::Uint64 severalContexts = static_cast<sf::Uint64>(-1);
 
     GLenum usageToGlEnum(sf::VertexBuffer::Usage usage)
     {
@@ -57,7 +78,10 @@ VertexBuffer::VertexBuffer() :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (Stream)
+m_usage        (Stream),
+m_cacheId      (getUniqueId()),
+m_fence        (NULL),
+m_contextId    (0)
 {
 }
 
@@ -67,7 +91,10 @@ VertexBuffer::VertexBuffer(PrimitiveType type) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (Stream)
+m_usage        (Stream),
+m_cacheId      (getUniqueId()),
+m_fence        (NULL),
+m_contextId    (0)
 {
 }
 
@@ -77,7 +104,10 @@ VertexBuffer::VertexBuffer(VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (usage)
+m_usage        (usage),
+m_cacheId      (getUniqueId()),
+m_fence        (NULL),
+m_contextId    (0)
 {
 }
 
@@ -87,7 +117,10 @@ VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (usage)
+m_usage        (usage),
+m_cacheId      (getUniqueId()),
+m_fence        (NULL),
+m_contextId    (0)
 {
 }
 
@@ -97,7 +130,10 @@ VertexBuffer::VertexBuffer(const VertexBuffer& copy) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(copy.m_primitiveType),
-m_usage        (copy.m_usage)
+m_usage        (copy.m_usage),
+m_cacheId      (getUniqueId()),
+m_fence        (NULL),
+m_contextId    (0)
 {
     if (copy.m_buffer && copy.m_size)
     {
@@ -122,6 +158,8 @@ VertexBuffer::~VertexBuffer()
 
         glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
     }
+
+    delete m_fence;
 }
 
 
@@ -134,7 +172,10 @@ bool VertexBuffer::create(std::size_t vertexCount)
     TransientContextLock contextLock;
 
     if (!m_buffer)
+    {
         glCheck(GLEXT_glGenBuffers(1, &m_buffer));
+        m_cacheId = getUniqueId();
+    }
 
     if (!m_buffer)
     {
@@ -195,6 +236,9 @@ bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsig
 
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
 
+    // Make sure that the other contexts drawing the buffer will see it updated
+    signalUpdate();
+
     return true;
 }
 
@@ -216,6 +260,14 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     // Make sure that extensions are initialized
     sf::priv::ensureExtensionsInit();
 
+    // Wait for the last update of the source if it was made in another context
+    {
+        Lock fenceLock(fenceMutex);
+
+        if (vertexBuffer.m_fence)
+            vertexBuffer.m_fence->synchronize();
+    }
+
     if (GLEXT_copy_buffer)
     {
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, vertexBuffer.m_buffer));
@@ -226,6 +278,8 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
 
+        signalUpdate();
+
         return true;
     }
 
@@ -255,6 +309,8 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     if ((sourceResult == GL_FALSE) || (destinationResult == GL_FALSE))
         return false;
 
+    signalUpdate();
+
     return true;
 
 #endif // SFML_OPENGL_ES
@@ -279,6 +335,11 @@ void VertexBuffer::swap(VertexBuffer& right)
     std::swap(m_buffer,        right.m_buffer);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
+    std::swap(m_fence,         right.m_fence);
+    std::swap(m_contextId,     right.m_contextId);
+
+    m_cacheId = getUniqueId();
+    right.m_cacheId = getUniqueId();
 }
 
 
@@ -297,6 +358,10 @@ void VertexBuffer::bind(const VertexBuffer* vertexBuffer)
 
     TransientContextLock lock;
 
+    // Wait for the last update if it was made in another context
+    if (vertexBuffer)
+        vertexBuffer->waitForUpdate();
+
     glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer ? vertexBuffer->m_buffer : 0));
 }
 
@@ -360,4 +425,43 @@ void VertexBuffer::draw(RenderTarget& target, RenderStates states) const
         target.draw(*this, 0, m_size, states);
 }
 
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::signalUpdate()
+{
+    Lock lock(fenceMutex);
+
+    // Commands of a same context are executed in order, there is no need for
+    // a fence while the buffer is only drawn in the updating context; the
+    // commands are still flushed, so that another context that draws it
+    // later doesn't read it before they are submitted
+    if (!m_fence && (m_contextId == Context::getActiveContextId()))
+    {
+        glCheck(glFlush());
+        return;
+    }
+
+    if (!m_fence)
+        m_fence = new GpuFence;
+
+    m_fence->insert();
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::waitForUpdate() const
+{
+    Lock lock(fenceMutex);
+
+    Uint64 contextId = Context::getActiveContextId();
+
+    if (!m_contextId)
+        m_contextId = contextId;
+    else if (m_contextId != contextId)
+        m_contextId = severalContexts;
+
+    if (m_fence)
+        m_fence->synchronize();
+}
+
 } // namespace sf
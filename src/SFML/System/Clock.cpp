@@ -33,6 +33,77 @@
     #include <SFML/System/Unix/ClockImpl.hpp>
 #endif
 
+// The time-stamp counter of x86 processors is read with the rdtsc instruction
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+    #define SFML_TIME_STAMP_COUNTER
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    #include <x86intrin.h>
+    #include <cpuid.h>
+    #define SFML_TIME_STAMP_COUNTER
+#endif
+
+
+namespace
+{
+#ifdef SFML_TIME_STAMP_COUNTER
+
+    // The counter can only be used as a clock if it is invariant,
+    // i.e. if its frequency doesn't change with the power states
+    bool hasInvariantTimeStampCounter()
+    {
+    #if defined(_MSC_VER)
+
+        int info[4];
+        __cpuid(info, 0x80000000);
+        if (static_cast<unsigned int>(info[0]) < 0x80000007)
+            return false;
+
+        __cpuid(info, 0x80000007);
+        return (info[3] & (1 << 8)) != 0;
+
+    #else
+
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+            return false;
+
+        return (edx & (1 << 8)) != 0;
+
+    #endif
+    }
+
+    // Measure the frequency of the counter against the system clock
+    sf::Uint64 calibrateTimeStampCounter()
+    {
+        sf::Time start = sf::priv::ClockImpl::getCurrentTime();
+        sf::Uint64 startTicks = __rdtsc();
+
+        sf::Time elapsed;
+        do
+        {
+            elapsed = sf::priv::ClockImpl::getCurrentTime() - start;
+        }
+        while (elapsed < sf::milliseconds(10));
+
+        sf::Uint64 ticks = __rdtsc() - startTicks;
+
+        return ticks * 1000000 / elapsed.asMicroseconds();
+    }
+
+#endif // SFML_TIME_STAMP_COUNTER
+
+    bool useTimeStampCounter()
+    {
+    #ifdef SFML_TIME_STAMP_COUNTER
+        static bool invariant = hasInvariantTimeStampCounter();
+        return invariant;
+    #else
+        return false;
+    #endif
+    }
+}
+
 
 namespace sf
 {
@@ -60,4 +131,39 @@ Time Clock::restart()
     return elapsed;
 }
 
+
+
+////////////////////////////////////////////////////////////
+Time Clock::now()
+{
+    return priv::ClockImpl::getCurrentTime();
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Clock::getTicks()
+{
+#ifdef SFML_TIME_STAMP_COUNTER
+    if (useTimeStampCounter())
+        return __rdtsc();
+#endif
+
+    return static_cast<Uint64>(priv::ClockImpl::getCurrentTime().asMicroseconds());
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 Clock::getTickFrequency()
+{
+#ifdef SFML_TIME_STAMP_COUNTER
+    if (useTimeStampCounter())
+    {
+        static Uint64 frequency = calibrateTimeStampCounter();
+        return frequency;
+    }
+#endif
+
+    return 1000000;
+}
+
 } // namespace sf
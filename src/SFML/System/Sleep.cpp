@@ -26,6 +26,10 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Sleep.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
 
 #if defined(SFML_SYSTEM_WINDOWS)
     #include <SFML/System/Win32/SleepImpl.hpp>
@@ -34,6 +38,19 @@
 #endif
 
 
+namespace
+{
+    // Margin of spinUntil, shared by all the threads since it depends on the OS scheduler;
+    // it starts high and shrinks as long as the sleeping threads are woken up on time
+    sf::Mutex spinMarginMutex;
+    sf::Time  spinMargin = sf::milliseconds(2);
+
+    const sf::Time minSpinMargin   = sf::microseconds(200);
+    const sf::Time maxSpinMargin   = sf::milliseconds(4);
+    const sf::Time spinMarginDecay = sf::microseconds(10);
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -43,4 +60,48 @@ void sleep(Time duration)
         priv::sleepImpl(duration);
 }
 
+
+
+////////////////////////////////////////////////////////////
+void sleepUntil(Time deadline)
+{
+    if (deadline > Clock::now())
+        priv::sleepUntilImpl(deadline);
+}
+
+
+////////////////////////////////////////////////////////////
+void spinUntil(Time deadline)
+{
+    Time margin;
+    {
+        Lock lock(spinMarginMutex);
+        margin = spinMargin;
+    }
+
+    // Sleep until shortly before the deadline...
+    Time wakeUp = deadline - margin;
+    Time now = Clock::now();
+
+    if (now < wakeUp)
+    {
+        priv::sleepUntilImpl(wakeUp);
+        now = Clock::now();
+
+        // Adapt the margin to how late the thread was woken up:
+        // grow it at once when it was not enough, shrink it slowly otherwise
+        Time needed = now - wakeUp + minSpinMargin;
+
+        Lock lock(spinMarginMutex);
+        if (needed > spinMargin)
+            spinMargin = std::min(needed, maxSpinMargin);
+        else
+            spinMargin = std::max(spinMargin - spinMarginDecay, minSpinMargin);
+    }
+
+    // ... then spin for the rest of the wait
+    while (now < deadline)
+        now = Clock::now();
+}
+
 } // namespace sf
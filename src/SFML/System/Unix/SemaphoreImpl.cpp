@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Unix/SemaphoreImpl.hpp>
+#include <errno.h>
+#include <time.h>
+#if !defined(SFML_SYSTEM_LINUX) && !defined(SFML_SYSTEM_FREEBSD)
+    #include <sys/time.h>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+SemaphoreImpl::SemaphoreImpl(unsigned int count) :
+m_count(count)
+{
+    pthread_mutex_init(&m_mutex, NULL);
+
+#if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
+
+    // Measure timeouts on the monotonic clock, so that they
+    // are not affected by changes of the system time
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&m_condition, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+#else
+
+    pthread_cond_init(&m_condition, NULL);
+
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+SemaphoreImpl::~SemaphoreImpl()
+{
+    pthread_cond_destroy(&m_condition);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::post()
+{
+    pthread_mutex_lock(&m_mutex);
+    ++m_count;
+    pthread_mutex_unlock(&m_mutex);
+
+    pthread_cond_signal(&m_condition);
+}
+
+
+////////////////////////////////////////////////////////////
+void SemaphoreImpl::wait()
+{
+    pthread_mutex_lock(&m_mutex);
+
+    // The condition can be signaled spuriously, check the counter again
+    while (m_count == 0)
+        pthread_cond_wait(&m_condition, &m_mutex);
+
+    --m_count;
+
+    pthread_mutex_unlock(&m_mutex);
+}
+
+
+////////////////////////////////////////////////////////////
+bool SemaphoreImpl::wait(Time timeout)
+{
+    pthread_mutex_lock(&m_mutex);
+
+    if ((m_count == 0) && (timeout > Time::Zero))
+    {
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+        // Mac OS X has no monotonic clock for conditions, but it
+        // can wait for a relative duration instead
+        timespec ti;
+        ti.tv_sec = static_cast<time_t>(timeout.asMicroseconds() / 1000000);
+        ti.tv_nsec = static_cast<long>(timeout.asMicroseconds() % 1000000) * 1000;
+
+        while (m_count == 0)
+        {
+            if (pthread_cond_timedwait_relative_np(&m_condition, &m_mutex, &ti) == ETIMEDOUT)
+                break;
+        }
+
+#else
+
+        // Compute the absolute deadline on the clock of the condition
+        timespec ti;
+    #if defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
+        clock_gettime(CLOCK_MONOTONIC, &ti);
+    #else
+        timeval now;
+        gettimeofday(&now, NULL);
+        ti.tv_sec = now.tv_sec;
+        ti.tv_nsec = now.tv_usec * 1000;
+    #endif
+
+        Int64 nsecs = ti.tv_nsec + timeout.asMicroseconds() * 1000;
+        ti.tv_sec += static_cast<time_t>(nsecs / 1000000000);
+        ti.tv_nsec = static_cast<long>(nsecs % 1000000000);
+
+        while (m_count == 0)
+        {
+            if (pthread_cond_timedwait(&m_condition, &m_mutex, &ti) == ETIMEDOUT)
+                break;
+        }
+
+#endif
+    }
+
+    bool signaled = (m_count > 0);
+    if (signaled)
+        --m_count;
+
+    pthread_mutex_unlock(&m_mutex);
+
+    return signaled;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -26,8 +26,12 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Unix/SleepImpl.hpp>
+#include <SFML/System/Unix/ClockImpl.hpp>
 #include <errno.h>
 #include <time.h>
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+    #include <mach/mach_time.h>
+#endif
 
 
 namespace sf
@@ -54,6 +58,45 @@ void sleepImpl(Time time)
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline)
+{
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    // Mac OS X specific implementation (it doesn't support clock_nanosleep),
+    // convert the deadline back to mach_absolute_time units (see ClockImpl)
+    static mach_timebase_info_data_t frequency = {0, 0};
+    if (frequency.denom == 0)
+        mach_timebase_info(&frequency);
+    Uint64 nanoseconds = static_cast<Uint64>(deadline.asMicroseconds()) * 1000;
+    mach_wait_until(nanoseconds * frequency.denom / frequency.numer);
+
+#elif defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
+
+    // Sleep on the same clock as ClockImpl, with an absolute deadline
+    Uint64 usecs = deadline.asMicroseconds();
+
+    timespec ti;
+    ti.tv_nsec = (usecs % 1000000) * 1000;
+    ti.tv_sec = usecs / 1000000;
+
+    // Contrary to nanosleep, clock_nanosleep returns the error code;
+    // an interrupted absolute sleep can simply be resumed
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ti, NULL) == EINTR)
+    {
+    }
+
+#else
+
+    // Other systems: sleep for the remaining duration
+    Time remaining = deadline - ClockImpl::getCurrentTime();
+    if (remaining > Time::Zero)
+        sleepImpl(remaining);
+
+#endif
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -44,6 +44,14 @@ namespace priv
 ////////////////////////////////////////////////////////////
 void sleepImpl(Time time);
 
+////////////////////////////////////////////////////////////
+/// \brief Unix implementation of sf::sleepUntil
+///
+/// \param deadline Time to wake up at, on the timeline of ClockImpl
+///
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline);
+
 } // namespace priv
 
 } // namespace sf
@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/System/Win32/SleepImpl.hpp>
+#include <SFML/System/Win32/ClockImpl.hpp>
 #include <windows.h>
 
 
@@ -50,6 +51,17 @@ void sleepImpl(Time time)
     timeEndPeriod(tc.wPeriodMin);
 }
 
+
+////////////////////////////////////////////////////////////
+void sleepUntilImpl(Time deadline)
+{
+    // Windows has no absolute sleep on the performance counter's
+    // timeline, sleep for the remaining duration
+    Time remaining = deadline - ClockImpl::getCurrentTime();
+    if (remaining > Time::Zero)
+        sleepImpl(remaining);
+}
+
 } // namespace priv
 
 } // namespace sf
@@ -87,6 +87,13 @@ Uint64 Context::getActiveContextId()
 }
 
 
+////////////////////////////////////////////////////////////
+void Context::reserveTransientContexts(unsigned int count)
+{
+    priv::GlContext::reserveTransientContexts(count);
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Context::isExtensionAvailable(const char* name)
 {
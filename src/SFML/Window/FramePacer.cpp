@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/FramePacer.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+FramePacer::FramePacer() :
+m_frameTime      (Time::Zero),
+m_deadline       (Time::Zero),
+m_frameStart     (Clock::now()),
+m_precise        (false),
+m_frameCount     (0),
+m_missedDeadlines(0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setFrameTime(Time frameTime)
+{
+    if (frameTime == m_frameTime)
+        return;
+
+    m_frameTime = frameTime;
+
+    // Schedule the next deadline from the start of the current frame
+    m_deadline = (m_frameTime != Time::Zero) ? m_frameStart + m_frameTime : Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::setPrecise(bool precise)
+{
+    m_precise = precise;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::restart()
+{
+    m_frameStart = Clock::now();
+    m_deadline = (m_frameTime != Time::Zero) ? m_frameStart + m_frameTime : Time::Zero;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::endFrame()
+{
+    Time now = Clock::now();
+
+    if (m_frameTime != Time::Zero)
+    {
+        if (now < m_deadline)
+        {
+            if (m_precise)
+                spinUntil(m_deadline);
+            else
+                sleepUntil(m_deadline);
+
+            now = Clock::now();
+        }
+        else
+        {
+            ++m_missedDeadlines;
+        }
+
+        // The deadlines follow a fixed grid so that the errors don't accumulate; if the
+        // frame is late by more than a whole frame, the grid restarts from now rather
+        // than letting the next frames catch up with no wait at all
+        m_deadline += m_frameTime;
+        if (m_deadline <= now)
+            m_deadline = now + m_frameTime;
+    }
+
+    // Record the duration of the frame
+    m_history[m_frameCount % HistorySize] = (now - m_frameStart).asMicroseconds();
+    ++m_frameCount;
+
+    m_frameStart = now;
+}
+
+
+////////////////////////////////////////////////////////////
+FrameStatistics FramePacer::getStatistics() const
+{
+    FrameStatistics statistics;
+    statistics.frameCount = m_frameCount;
+    statistics.missedDeadlines = m_missedDeadlines;
+
+    std::size_t count = static_cast<std::size_t>(std::min<Uint64>(m_frameCount, HistorySize));
+    if (count == 0)
+        return statistics;
+
+    std::vector<Int64> durations(m_history, m_history + count);
+
+    Int64 total = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        total += durations[i];
+
+    // Smallest duration which is greater than or equal to 99% of the durations
+    std::size_t rank = (count * 99 + 99) / 100 - 1;
+    std::nth_element(durations.begin(), durations.begin() + rank, durations.end());
+
+    statistics.meanFrameTime = microseconds(total / static_cast<Int64>(count));
+    statistics.p99FrameTime  = microseconds(durations[rank]);
+    statistics.maxFrameTime  = microseconds(*std::max_element(durations.begin() + rank, durations.end()));
+
+    return statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void FramePacer::resetStatistics()
+{
+    m_frameCount = 0;
+    m_missedDeadlines = 0;
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FRAMEPACER_HPP
+#define SFML_FRAMEPACER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/FrameStatistics.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Paces the frames of a window and measures their duration
+///
+/// Frames are scheduled on a grid of absolute deadlines, so
+/// that the errors of the waits don't accumulate. In precise
+/// mode, the pacer waits with sf::spinUntil rather than
+/// sf::sleepUntil.
+///
+////////////////////////////////////////////////////////////
+class FramePacer : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FramePacer();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the minimum duration of a frame
+    ///
+    /// \param frameTime Duration of a frame, Time::Zero for no limit
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFrameTime(Time frameTime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the precise (sleep then spin) mode
+    ///
+    /// \param precise True to spin before the deadlines
+    ///
+    ////////////////////////////////////////////////////////////
+    void setPrecise(bool precise);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start a new sequence of frames
+    ///
+    /// The next frame starts now, the statistics are kept.
+    ///
+    ////////////////////////////////////////////////////////////
+    void restart();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief End the current frame
+    ///
+    /// Waits for the frame's deadline if a limit is set,
+    /// and records the duration of the frame.
+    ///
+    ////////////////////////////////////////////////////////////
+    void endFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the statistics of the recent frames
+    ///
+    /// \return Frame statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameStatistics getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the statistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    enum
+    {
+        HistorySize = 512 ///< Number of recent frames used to compute the statistics
+    };
+
+    Time   m_frameTime;            ///< Minimum duration of a frame, zero if there's no limit
+    Time   m_deadline;             ///< Time at which the current frame should end (see Clock::now)
+    Time   m_frameStart;           ///< Time at which the current frame started (see Clock::now)
+    bool   m_precise;              ///< Spin before the deadlines?
+    Int64  m_history[HistorySize]; ///< Durations of the recent frames, in microseconds
+    Uint64 m_frameCount;           ///< Number of frames since the statistics were reset
+    Uint64 m_missedDeadlines;      ///< Number of missed deadlines since the statistics were reset
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_FRAMEPACER_HPP
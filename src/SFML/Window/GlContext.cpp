@@ -52,7 +52,9 @@
     #elif defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD) || defined(SFML_SYSTEM_OPENBSD)
 
         #include <SFML/Window/Unix/GlxContext.hpp>
+        #include <SFML/Window/Unix/HeadlessContext.hpp>
         typedef sf::priv::GlxContext ContextType;
+        #define SFML_HEADLESS_CONTEXT_AVAILABLE
 
     #elif defined(SFML_SYSTEM_MACOS)
 
@@ -80,10 +82,16 @@
 #if defined(SFML_SYSTEM_WINDOWS)
 
     typedef const GLubyte* (APIENTRY *glGetStringiFuncType)(GLenum, GLuint);
+    typedef void*          (APIENTRY *glFenceSyncFuncType)(GLenum, GLbitfield);
+    typedef GLenum         (APIENTRY *glClientWaitSyncFuncType)(void*, GLbitfield, sf::Uint64);
+    typedef void           (APIENTRY *glDeleteSyncFuncType)(void*);
 
 #else
 
     typedef const GLubyte* (*glGetStringiFuncType)(GLenum, GLuint);
+    typedef void*          (*glFenceSyncFuncType)(GLenum, GLbitfield);
+    typedef GLenum         (*glClientWaitSyncFuncType)(void*, GLbitfield, sf::Uint64);
+    typedef void           (*glDeleteSyncFuncType)(void*);
 
 #endif
 
@@ -127,6 +135,18 @@
     #define GL_CONTEXT_COMPATIBILITY_PROFILE_BIT 0x00000002
 #endif
 
+#if !defined(GL_SYNC_GPU_COMMANDS_COMPLETE)
+    #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+
+#if !defined(GL_TIMEOUT_EXPIRED)
+    #define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+
+#if !defined(GL_SYNC_FLUSH_COMMANDS_BIT)
+    #define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+
 
 namespace
 {
@@ -145,7 +165,19 @@ namespace
     sf::ThreadLocalPtr<sf::priv::GlContext> currentContext(NULL);
 
     // The hidden, inactive context that will be shared with all other contexts
-    ContextType* sharedContext = NULL;
+    sf::priv::GlContext* sharedContext = NULL;
+
+    // Are contexts created without the window system, off-screen?
+    bool headless = false;
+
+    // Contexts lent to the threads that need a transient context, so that they
+    // don't have to lock and share the single shared context
+    std::vector<sf::priv::GlContext*> contextPool;
+
+    // Fence sync functions, used to wait for the work done in lent contexts
+    glFenceSyncFuncType      glFenceSyncFunc      = NULL;
+    glClientWaitSyncFuncType glClientWaitSyncFunc = NULL;
+    glDeleteSyncFuncType     glDeleteSyncFunc     = NULL;
 
     // Unique identifier, used for identifying contexts when managing unshareable OpenGL resources
     sf::Uint64 id = 1; // start at 1, zero is "no context"
@@ -166,10 +198,9 @@ namespace
         ///
         ////////////////////////////////////////////////////////////
         TransientContext() :
-        referenceCount   (0),
-        context          (0),
-        sharedContextLock(0),
-        useSharedContext (false)
+        referenceCount(0),
+        context       (0),
+        pooledContext (0)
         {
             if (resourceCount == 0)
             {
@@ -177,9 +208,18 @@ namespace
             }
             else if (!currentContext)
             {
-                sharedContextLock = new sf::Lock(mutex);
-                useSharedContext = true;
-                sharedContext->setActive(true);
+                // Borrow a context from the pool, or create one if they are all in use
+                if (!contextPool.empty())
+                {
+                    pooledContext = contextPool.back();
+                    contextPool.pop_back();
+                }
+                else
+                {
+                    pooledContext = sf::priv::GlContext::create();
+                }
+
+                pooledContext->setActive(true);
             }
         }
 
@@ -189,20 +229,49 @@ namespace
         ////////////////////////////////////////////////////////////
         ~TransientContext()
         {
-            if (useSharedContext)
-                sharedContext->setActive(false);
+            if (pooledContext)
+            {
+                pooledContext->setActive(false);
+                contextPool.push_back(pooledContext);
+            }
 
-            delete sharedContextLock;
             delete context;
         }
 
+        ////////////////////////////////////////////////////////////
+        /// \brief Wait for the commands of the borrowed context to complete
+        ///
+        /// Resources created or updated in a borrowed context must
+        /// be ready before other contexts use them. The borrowing
+        /// thread waits for them, so that the threads using them
+        /// (typically the rendering thread) never have to.
+        ///
+        ////////////////////////////////////////////////////////////
+        void waitForCompletion()
+        {
+            void* fence = glFenceSyncFunc ? glFenceSyncFunc(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) : NULL;
+
+            if (fence)
+            {
+                // Wait one second at a time, the flush bit makes sure that the fence is sent
+                while (glClientWaitSyncFunc(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED)
+                {
+                }
+
+                glDeleteSyncFunc(fence);
+            }
+            else
+            {
+                glFinish();
+            }
+        }
+
         ///////////////////////////////////////////////////////////
         // Member data
         ////////////////////////////////////////////////////////////
-        unsigned int referenceCount;
-        sf::Context* context;
-        sf::Lock*    sharedContextLock;
-        bool         useSharedContext;
+        unsigned int         referenceCount;
+        sf::Context*         context;
+        sf::priv::GlContext* pooledContext;
     };
 
     // This per-thread variable tracks if and how a transient
@@ -231,6 +300,57 @@ namespace
 
         return false;
     }
+
+    // Choose the backend of the contexts: the headless one is used when the SFML_HEADLESS
+    // environment variable is set to anything but 0, or when there's no display to connect to
+    bool isHeadlessRequested()
+    {
+#if defined(SFML_HEADLESS_CONTEXT_AVAILABLE)
+
+        const char* value = std::getenv("SFML_HEADLESS");
+        if (value && *value)
+            return (std::strcmp(value, "0") != 0) && sf::priv::HeadlessContext::isAvailable();
+
+        const char* display = std::getenv("DISPLAY");
+        return (!display || !*display) && sf::priv::HeadlessContext::isAvailable();
+
+#else
+
+        return false;
+
+#endif
+    }
+
+    // Create a context with the selected backend
+    sf::priv::GlContext* createContext(sf::priv::GlContext* shared)
+    {
+#if defined(SFML_HEADLESS_CONTEXT_AVAILABLE)
+        if (headless)
+            return new sf::priv::HeadlessContext(static_cast<sf::priv::HeadlessContext*>(shared));
+#endif
+
+        return new ContextType(static_cast<ContextType*>(shared));
+    }
+
+    sf::priv::GlContext* createContext(sf::priv::GlContext* shared, const sf::ContextSettings& settings, const sf::priv::WindowImpl* owner, unsigned int bitsPerPixel)
+    {
+#if defined(SFML_HEADLESS_CONTEXT_AVAILABLE)
+        if (headless)
+            return new sf::priv::HeadlessContext(static_cast<sf::priv::HeadlessContext*>(shared), settings, owner, bitsPerPixel);
+#endif
+
+        return new ContextType(static_cast<ContextType*>(shared), settings, owner, bitsPerPixel);
+    }
+
+    sf::priv::GlContext* createContext(sf::priv::GlContext* shared, const sf::ContextSettings& settings, unsigned int width, unsigned int height)
+    {
+#if defined(SFML_HEADLESS_CONTEXT_AVAILABLE)
+        if (headless)
+            return new sf::priv::HeadlessContext(static_cast<sf::priv::HeadlessContext*>(shared), settings, width, height);
+#endif
+
+        return new ContextType(static_cast<ContextType*>(shared), settings, width, height);
+    }
 }
 
 
@@ -255,8 +375,9 @@ void GlContext::initResource()
             return;
         }
 
-        // Create the shared context
-        sharedContext = new ContextType(NULL);
+        // Create the shared context, with the backend that all the contexts will use
+        headless = isHeadlessRequested();
+        sharedContext = createContext(NULL);
         sharedContext->initialize(ContextSettings());
 
         // Load our extensions vector
@@ -305,6 +426,25 @@ void GlContext::initResource()
             }
         }
 
+        // Load the fence sync functions if they are supported (core since OpenGL 3.2)
+        int minorVersion = 0;
+        if (majorVersion == 3)
+            glGetIntegerv(GL_MINOR_VERSION, &minorVersion);
+
+        if ((majorVersion > 3) || ((majorVersion == 3) && (minorVersion >= 2)) || isExtensionAvailable("GL_ARB_sync"))
+        {
+            glFenceSyncFunc      = reinterpret_cast<glFenceSyncFuncType>(getFunction("glFenceSync"));
+            glClientWaitSyncFunc = reinterpret_cast<glClientWaitSyncFuncType>(getFunction("glClientWaitSync"));
+            glDeleteSyncFunc     = reinterpret_cast<glDeleteSyncFuncType>(getFunction("glDeleteSync"));
+
+            if (!glFenceSyncFunc || !glClientWaitSyncFunc || !glDeleteSyncFunc)
+                glFenceSyncFunc = NULL;
+        }
+        else
+        {
+            glFenceSyncFunc = NULL;
+        }
+
         // Deactivate the shared context so that others can activate it when necessary
         sharedContext->setActive(false);
     }
@@ -329,7 +469,11 @@ void GlContext::cleanupResource()
         if (!sharedContext)
             return;
 
-        // Destroy the shared context
+        // Destroy the contexts of the pool, then the shared context
+        for (std::vector<GlContext*>::iterator it = contextPool.begin(); it != contextPool.end(); ++it)
+            delete *it;
+        contextPool.clear();
+
         delete sharedContext;
         sharedContext = NULL;
     }
@@ -343,6 +487,31 @@ void GlContext::registerContextDestroyCallback(ContextDestroyCallback callback,
 }
 
 
+////////////////////////////////////////////////////////////
+void GlContext::reserveTransientContexts(unsigned int count)
+{
+    // Protect from concurrent access
+    Lock lock(mutex);
+
+    // The pool is destroyed along with the shared context
+    if (!sharedContext)
+        return;
+
+    // Creating a context activates it, restore the caller's context afterwards
+    GlContext* previousContext = currentContext;
+
+    while (contextPool.size() < count)
+    {
+        GlContext* context = create();
+        context->setActive(false);
+        contextPool.push_back(context);
+    }
+
+    if (previousContext)
+        previousContext->setActive(true);
+}
+
+
 ////////////////////////////////////////////////////////////
 void GlContext::acquireTransientContext()
 {
@@ -362,12 +531,17 @@ void GlContext::acquireTransientContext()
 ////////////////////////////////////////////////////////////
 void GlContext::releaseTransientContext()
 {
-    // Protect from concurrent access
-    Lock lock(mutex);
-
     // Make sure a matching acquireTransientContext() was called
     assert(transientContext);
 
+    // Wait for the work done in a borrowed context before locking,
+    // so that the other threads are not blocked in the meantime
+    if ((transientContext->referenceCount == 1) && transientContext->pooledContext)
+        transientContext->waitForCompletion();
+
+    // Protect from concurrent access
+    Lock lock(mutex);
+
     // Decrease the reference count
     transientContext->referenceCount--;
 
@@ -398,7 +572,7 @@ GlContext* GlContext::create()
         sharedContext->setActive(true);
 
         // Create the context
-        context = new ContextType(sharedContext);
+        context = createContext(sharedContext);
 
         sharedContext->setActive(false);
     }
@@ -426,7 +600,7 @@ GlContext* GlContext::create(const ContextSettings& settings, const WindowImpl*
         sharedContext->setActive(true);
 
         // Create the context
-        context = new ContextType(sharedContext, settings, owner, bitsPerPixel);
+        context = createContext(sharedContext, settings, owner, bitsPerPixel);
 
         sharedContext->setActive(false);
     }
@@ -455,7 +629,7 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
         sharedContext->setActive(true);
 
         // Create the context
-        context = new ContextType(sharedContext, settings, width, height);
+        context = createContext(sharedContext, settings, width, height);
 
         sharedContext->setActive(false);
     }
@@ -481,6 +655,11 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 
     Lock lock(mutex);
 
+#if defined(SFML_HEADLESS_CONTEXT_AVAILABLE)
+    if (headless)
+        return HeadlessContext::getFunction(name);
+#endif
+
     return ContextType::getFunction(name);
 
 #else
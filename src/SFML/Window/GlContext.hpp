@@ -83,6 +83,14 @@ public:
     ////////////////////////////////////////////////////////////
     static void registerContextDestroyCallback(ContextDestroyCallback callback, void* arg);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create contexts in advance for transient use
+    ///
+    /// \param count Number of contexts that the pool must contain
+    ///
+    ////////////////////////////////////////////////////////////
+    static void reserveTransientContexts(unsigned int count);
+
     ////////////////////////////////////////////////////////////
     /// \brief Acquires a context for short-term use on the current thread
     ///
@@ -0,0 +1,466 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2018 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Unix/HeadlessContext.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <algorithm>
+#include <cstring>
+#include <dlfcn.h>
+
+
+namespace
+{
+    // The subset of EGL used here; the library is loaded at runtime,
+    // so its headers aren't required to build SFML
+    typedef unsigned int EGLBoolean;
+    typedef unsigned int EGLenum;
+    typedef int          EGLint;
+    typedef void*        EGLDisplay;
+    typedef void*        EGLConfig;
+    typedef void*        EGLContext;
+    typedef void*        EGLSurface;
+
+    const EGLint  EGL_NONE                                         = 0x3038;
+    const EGLint  EGL_EXTENSIONS                                   = 0x3055;
+    const EGLint  EGL_SURFACE_TYPE                                 = 0x3033;
+    const EGLint  EGL_PBUFFER_BIT                                  = 0x0001;
+    const EGLint  EGL_RENDERABLE_TYPE                              = 0x3040;
+    const EGLint  EGL_OPENGL_BIT                                   = 0x0008;
+    const EGLint  EGL_RED_SIZE                                     = 0x3024;
+    const EGLint  EGL_GREEN_SIZE                                   = 0x3023;
+    const EGLint  EGL_BLUE_SIZE                                    = 0x3022;
+    const EGLint  EGL_ALPHA_SIZE                                   = 0x3021;
+    const EGLint  EGL_DEPTH_SIZE                                   = 0x3025;
+    const EGLint  EGL_STENCIL_SIZE                                 = 0x3026;
+    const EGLint  EGL_SAMPLE_BUFFERS                               = 0x3032;
+    const EGLint  EGL_SAMPLES                                      = 0x3031;
+    const EGLint  EGL_WIDTH                                        = 0x3057;
+    const EGLint  EGL_HEIGHT                                       = 0x3056;
+    const EGLint  EGL_CONTEXT_MAJOR_VERSION_KHR                    = 0x3098;
+    const EGLint  EGL_CONTEXT_MINOR_VERSION_KHR                    = 0x30FB;
+    const EGLint  EGL_CONTEXT_FLAGS_KHR                            = 0x30FC;
+    const EGLint  EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR              = 0x30FD;
+    const EGLint  EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR                 = 0x0001;
+    const EGLint  EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR          = 0x0001;
+    const EGLint  EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR = 0x0002;
+    const EGLenum EGL_OPENGL_API                                   = 0x30A2;
+    const EGLenum EGL_PLATFORM_SURFACELESS_MESA                    = 0x31DD;
+
+    typedef void (*EglFunction)();
+    typedef EglFunction (*EglGetProcAddress)(const char*);
+    typedef EGLint      (*EglGetError)();
+    typedef const char* (*EglQueryString)(EGLDisplay, EGLint);
+    typedef EGLDisplay  (*EglGetDisplay)(void*);
+    typedef EGLDisplay  (*EglGetPlatformDisplay)(EGLenum, void*, const EGLint*);
+    typedef EGLBoolean  (*EglInitialize)(EGLDisplay, EGLint*, EGLint*);
+    typedef EGLBoolean  (*EglBindAPI)(EGLenum);
+    typedef EGLBoolean  (*EglChooseConfig)(EGLDisplay, const EGLint*, EGLConfig*, EGLint, EGLint*);
+    typedef EGLBoolean  (*EglGetConfigAttrib)(EGLDisplay, EGLConfig, EGLint, EGLint*);
+    typedef EGLSurface  (*EglCreatePbufferSurface)(EGLDisplay, EGLConfig, const EGLint*);
+    typedef EGLBoolean  (*EglDestroySurface)(EGLDisplay, EGLSurface);
+    typedef EGLContext  (*EglCreateContext)(EGLDisplay, EGLConfig, EGLContext, const EGLint*);
+    typedef EGLBoolean  (*EglDestroyContext)(EGLDisplay, EGLContext);
+    typedef EGLBoolean  (*EglMakeCurrent)(EGLDisplay, EGLSurface, EGLSurface, EGLContext);
+    typedef EGLContext  (*EglGetCurrentContext)();
+
+    // Entry points of libEGL and the display shared by all the contexts
+    struct Egl
+    {
+        EglGetProcAddress       getProcAddress;
+        EglGetError             getError;
+        EglQueryString          queryString;
+        EglGetDisplay           getDisplay;
+        EglInitialize           initialize;
+        EglBindAPI              bindAPI;
+        EglChooseConfig         chooseConfig;
+        EglGetConfigAttrib      getConfigAttrib;
+        EglCreatePbufferSurface createPbufferSurface;
+        EglDestroySurface       destroySurface;
+        EglCreateContext        createContext;
+        EglDestroyContext       destroyContext;
+        EglMakeCurrent          makeCurrent;
+        EglGetCurrentContext    getCurrentContext;
+        EGLDisplay              display;
+        bool                    createContextAvailable;
+        bool                    surfacelessAvailable;
+    };
+
+    sf::Mutex mutex;
+    Egl       egl;
+    bool      loaded    = false;
+    bool      available = false;
+
+    // Check whether a space-separated extension string contains an extension
+    bool hasExtension(const char* extensions, const char* name)
+    {
+        if (!extensions)
+            return false;
+
+        std::size_t length = std::strlen(name);
+
+        for (const char* start = extensions; *start; )
+        {
+            const char* end = start;
+            while (*end && (*end != ' '))
+                ++end;
+
+            if ((static_cast<std::size_t>(end - start) == length) && (std::strncmp(start, name, length) == 0))
+                return true;
+
+            start = *end ? end + 1 : end;
+        }
+
+        return false;
+    }
+
+    // Load a function of libEGL
+    template <typename T>
+    bool loadFunction(void* library, const char* name, T& function)
+    {
+        void* address = dlsym(library, name);
+        std::memcpy(&function, &address, sizeof(function));
+
+        return address != NULL;
+    }
+
+    // Load libEGL and initialize the display, only once
+    bool loadEgl()
+    {
+        sf::Lock lock(mutex);
+
+        if (loaded)
+            return available;
+
+        loaded = true;
+
+        void* library = dlopen("libEGL.so.1", RTLD_NOW | RTLD_GLOBAL);
+        if (!library)
+            library = dlopen("libEGL.so", RTLD_NOW | RTLD_GLOBAL);
+
+        if (!library)
+        {
+            sf::err() << "Failed to load libEGL, headless OpenGL contexts are not available" << std::endl;
+            return false;
+        }
+
+        if (!loadFunction(library, "eglGetProcAddress",       egl.getProcAddress)       ||
+            !loadFunction(library, "eglGetError",             egl.getError)             ||
+            !loadFunction(library, "eglQueryString",          egl.queryString)          ||
+            !loadFunction(library, "eglGetDisplay",           egl.getDisplay)           ||
+            !loadFunction(library, "eglInitialize",           egl.initialize)           ||
+            !loadFunction(library, "eglBindAPI",              egl.bindAPI)              ||
+            !loadFunction(library, "eglChooseConfig",         egl.chooseConfig)         ||
+            !loadFunction(library, "eglGetConfigAttrib",      egl.getConfigAttrib)      ||
+            !loadFunction(library, "eglCreatePbufferSurface", egl.createPbufferSurface) ||
+            !loadFunction(library, "eglDestroySurface",       egl.destroySurface)       ||
+            !loadFunction(library, "eglCreateContext",        egl.createContext)        ||
+            !loadFunction(library, "eglDestroyContext",       egl.destroyContext)       ||
+            !loadFunction(library, "eglMakeCurrent",          egl.makeCurrent)          ||
+            !loadFunction(library, "eglGetCurrentContext",    egl.getCurrentContext))
+        {
+            sf::err() << "Failed to load the EGL functions, headless OpenGL contexts are not available" << std::endl;
+            dlclose(library);
+            return false;
+        }
+
+        // Prefer the Mesa surfaceless platform, which doesn't need any display server or
+        // GPU device; the client extensions can only be queried without a display since EGL 1.5
+        egl.display = NULL;
+        const char* clientExtensions = egl.queryString(NULL, EGL_EXTENSIONS);
+
+        if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+        {
+            EglGetPlatformDisplay getPlatformDisplay = NULL;
+            EglFunction function = egl.getProcAddress("eglGetPlatformDisplayEXT");
+            std::memcpy(&getPlatformDisplay, &function, sizeof(getPlatformDisplay));
+
+            if (getPlatformDisplay)
+                egl.display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, NULL, NULL);
+        }
+
+        if (!egl.display)
+            egl.display = egl.getDisplay(NULL);
+
+        EGLint major = 0;
+        EGLint minor = 0;
+
+        if (!egl.display || !egl.initialize(egl.display, &major, &minor))
+        {
+            sf::err() << "Failed to initialize the EGL display (error " << egl.getError() << "), "
+                      << "headless OpenGL contexts are not available" << std::endl;
+            return false;
+        }
+
+        if (!egl.bindAPI(EGL_OPENGL_API))
+        {
+            sf::err() << "The EGL implementation doesn't support desktop OpenGL, "
+                      << "headless OpenGL contexts are not available" << std::endl;
+            return false;
+        }
+
+        const char* extensions = egl.queryString(egl.display, EGL_EXTENSIONS);
+        egl.createContextAvailable = ((major == 1) && (minor >= 5)) || (major > 1) || hasExtension(extensions, "EGL_KHR_create_context");
+        egl.surfacelessAvailable = hasExtension(extensions, "EGL_KHR_surfaceless_context");
+
+        available = true;
+        return true;
+    }
+
+    // Choose the best config for the given settings; returns false if none was found
+    bool chooseConfig(const sf::ContextSettings& settings, bool needPbuffer, EGLConfig& config)
+    {
+        EGLint attributes[] =
+        {
+            EGL_SURFACE_TYPE,    needPbuffer ? EGL_PBUFFER_BIT : 0,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE,        8,
+            EGL_GREEN_SIZE,      8,
+            EGL_BLUE_SIZE,       8,
+            EGL_ALPHA_SIZE,      8,
+            EGL_DEPTH_SIZE,      static_cast<EGLint>(settings.depthBits),
+            EGL_STENCIL_SIZE,    static_cast<EGLint>(settings.stencilBits),
+            EGL_SAMPLE_BUFFERS,  settings.antialiasingLevel > 0 ? 1 : 0,
+            EGL_SAMPLES,         static_cast<EGLint>(settings.antialiasingLevel),
+            EGL_NONE
+        };
+
+        EGLint count = 0;
+        if (egl.chooseConfig(egl.display, attributes, &config, 1, &count) && (count > 0))
+            return true;
+
+        // Retry without multisampling, which software implementations rarely provide
+        if (settings.antialiasingLevel > 0)
+        {
+            attributes[17] = 0;
+            attributes[19] = 0;
+
+            if (egl.chooseConfig(egl.display, attributes, &config, 1, &count) && (count > 0))
+                return true;
+        }
+
+        return false;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+HeadlessContext::HeadlessContext(HeadlessContext* shared) :
+m_context(NULL),
+m_surface(NULL)
+{
+    create(shared, ContextSettings(), 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+HeadlessContext::HeadlessContext(HeadlessContext* shared, const ContextSettings& settings, const WindowImpl* /*owner*/, unsigned int /*bitsPerPixel*/) :
+m_context(NULL),
+m_surface(NULL)
+{
+    err() << "Headless OpenGL contexts can't render to windows, an off-screen context is created instead" << std::endl;
+
+    create(shared, settings, 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+HeadlessContext::HeadlessContext(HeadlessContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height) :
+m_context(NULL),
+m_surface(NULL)
+{
+    create(shared, settings, width, height);
+}
+
+
+////////////////////////////////////////////////////////////
+HeadlessContext::~HeadlessContext()
+{
+    // Notify unshared OpenGL resources of context destruction
+    cleanupUnsharedResources();
+
+    if (m_context)
+    {
+        if (egl.getCurrentContext() == m_context)
+            egl.makeCurrent(egl.display, NULL, NULL, NULL);
+
+        egl.destroyContext(egl.display, m_context);
+    }
+
+    if (m_surface)
+        egl.destroySurface(egl.display, m_surface);
+}
+
+
+////////////////////////////////////////////////////////////
+bool HeadlessContext::isAvailable()
+{
+    return loadEgl();
+}
+
+
+////////////////////////////////////////////////////////////
+GlFunctionPointer HeadlessContext::getFunction(const char* name)
+{
+    if (!loadEgl())
+        return 0;
+
+    return reinterpret_cast<GlFunctionPointer>(egl.getProcAddress(name));
+}
+
+
+////////////////////////////////////////////////////////////
+bool HeadlessContext::makeCurrent(bool current)
+{
+    if (!m_context)
+        return false;
+
+    if (!current)
+        return egl.makeCurrent(egl.display, NULL, NULL, NULL) != 0;
+
+    // The current API is a per-thread state
+    egl.bindAPI(EGL_OPENGL_API);
+
+    return egl.makeCurrent(egl.display, m_surface, m_surface, m_context) != 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::display()
+{
+    // Nothing to do, pbuffers are single-buffered
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::setVerticalSyncEnabled(bool /*enabled*/)
+{
+    // Nothing to do, there's no monitor to synchronize with
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::create(HeadlessContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height)
+{
+    m_settings = settings;
+
+    if (!loadEgl())
+        return;
+
+    // Contexts that only render to frame buffer objects don't need a surface at all,
+    // which lets us use implementations that don't provide pbuffer configs
+    EGLConfig config = NULL;
+
+    if (!chooseConfig(settings, true, config) && !(egl.surfacelessAvailable && chooseConfig(settings, false, config)))
+    {
+        err() << "Failed to find an EGL config suitable for a headless OpenGL context" << std::endl;
+        return;
+    }
+
+    EGLint value = 0;
+    egl.getConfigAttrib(egl.display, config, EGL_DEPTH_SIZE, &value);
+    m_settings.depthBits = static_cast<unsigned int>(value);
+    egl.getConfigAttrib(egl.display, config, EGL_STENCIL_SIZE, &value);
+    m_settings.stencilBits = static_cast<unsigned int>(value);
+    egl.getConfigAttrib(egl.display, config, EGL_SAMPLES, &value);
+    m_settings.antialiasingLevel = static_cast<unsigned int>(value);
+    m_settings.sRgbCapable = false;
+
+    EGLContext toShare = shared ? shared->m_context : NULL;
+
+    // The current API is a per-thread state
+    egl.bindAPI(EGL_OPENGL_API);
+
+    // Request the version and profile only if needed, so that
+    // we get the most recent compatibility context by default
+    if (egl.createContextAvailable && ((settings.majorVersion > 1) || ((settings.majorVersion == 1) && (settings.minorVersion > 1))))
+    {
+        bool core  = (settings.attributeFlags & ContextSettings::Core) != 0;
+        bool debug = (settings.attributeFlags & ContextSettings::Debug) != 0;
+        bool profile = (settings.majorVersion > 3) || ((settings.majorVersion == 3) && (settings.minorVersion >= 2));
+
+        EGLint attributes[] =
+        {
+            EGL_CONTEXT_MAJOR_VERSION_KHR, static_cast<EGLint>(settings.majorVersion),
+            EGL_CONTEXT_MINOR_VERSION_KHR, static_cast<EGLint>(settings.minorVersion),
+            EGL_CONTEXT_FLAGS_KHR,         debug ? EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR : 0,
+            EGL_NONE,                      0,
+            EGL_NONE
+        };
+
+        if (profile)
+        {
+            attributes[6] = EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR;
+            attributes[7] = core ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR;
+        }
+
+        m_context = egl.createContext(egl.display, config, toShare, attributes);
+
+        if (!m_context)
+            err() << "Failed to create a headless OpenGL " << settings.majorVersion << "." << settings.minorVersion
+                  << " context, falling back to the default version" << std::endl;
+    }
+
+    if (!m_context)
+    {
+        const EGLint attributes[] = {EGL_NONE};
+        m_context = egl.createContext(egl.display, config, toShare, attributes);
+    }
+
+    if (!m_context)
+    {
+        err() << "Failed to create a headless OpenGL context (EGL error " << egl.getError() << ")" << std::endl;
+        return;
+    }
+
+    const EGLint attributes[] =
+    {
+        EGL_WIDTH,  static_cast<EGLint>(std::max(width, 1u)),
+        EGL_HEIGHT, static_cast<EGLint>(std::max(height, 1u)),
+        EGL_NONE
+    };
+
+    m_surface = egl.createPbufferSurface(egl.display, config, attributes);
+
+    if (!m_surface && !egl.surfacelessAvailable)
+    {
+        err() << "Failed to create the pbuffer of a headless OpenGL context (EGL error " << egl.getError() << ")" << std::endl;
+
+        egl.destroyContext(egl.display, m_context);
+        m_context = NULL;
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
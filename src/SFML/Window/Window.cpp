@@ -26,9 +26,9 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Window.hpp>
+#include <SFML/Window/FramePacer.hpp>
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/WindowImpl.hpp>
-#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Err.hpp>
 
 
@@ -42,10 +42,10 @@ namespace sf
 {
 ////////////////////////////////////////////////////////////
 Window::Window() :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl      (NULL),
+m_context   (NULL),
+m_framePacer(new priv::FramePacer),
+m_size      (0, 0)
 {
 
 }
@@ -53,10 +53,10 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(VideoMode mode, const String& title, Uint32 style, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl      (NULL),
+m_context   (NULL),
+m_framePacer(new priv::FramePacer),
+m_size      (0, 0)
 {
     create(mode, title, style, settings);
 }
@@ -64,10 +64,10 @@ m_size          (0, 0)
 
 ////////////////////////////////////////////////////////////
 Window::Window(WindowHandle handle, const ContextSettings& settings) :
-m_impl          (NULL),
-m_context       (NULL),
-m_frameTimeLimit(Time::Zero),
-m_size          (0, 0)
+m_impl      (NULL),
+m_context   (NULL),
+m_framePacer(new priv::FramePacer),
+m_size      (0, 0)
 {
     create(handle, settings);
 }
@@ -77,6 +77,8 @@ m_size          (0, 0)
 Window::~Window()
 {
     close();
+
+    delete m_framePacer;
 }
 
 
@@ -316,9 +318,30 @@ void Window::setKeyRepeatEnabled(bool enabled)
 void Window::setFramerateLimit(unsigned int limit)
 {
     if (limit > 0)
-        m_frameTimeLimit = seconds(1.f / limit);
+        m_framePacer->setFrameTime(seconds(1.f / limit));
     else
-        m_frameTimeLimit = Time::Zero;
+        m_framePacer->setFrameTime(Time::Zero);
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::setPreciseFramePacingEnabled(bool enabled)
+{
+    m_framePacer->setPrecise(enabled);
+}
+
+
+////////////////////////////////////////////////////////////
+FrameStatistics Window::getFrameStatistics() const
+{
+    return m_framePacer->getStatistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void Window::resetFrameStatistics()
+{
+    m_framePacer->resetStatistics();
 }
 
 
@@ -375,12 +398,8 @@ void Window::display()
     if (setActive())
         m_context->display();
 
-    // Limit the framerate if needed
-    if (m_frameTimeLimit != Time::Zero)
-    {
-        sleep(m_frameTimeLimit - m_clock.getElapsedTime());
-        m_clock.restart();
-    }
+    // Limit the framerate if needed, and measure the frame
+    m_framePacer->endFrame();
 }
 
 
@@ -437,7 +456,7 @@ void Window::initialize()
     m_size = m_impl->getSize();
 
     // Reset frame time
-    m_clock.restart();
+    m_framePacer->restart();
 
     // Activate the window
     setActive();